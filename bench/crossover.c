@@ -0,0 +1,129 @@
+/*
+Copyright (C) 2025 Tripp Robins
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this
+software and associated documentation files (the "Software"), to deal in the Software
+without restriction, including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+Measures the vertex count at which splitting an operation across the workers becomes faster than running it on the calling thread.
+The result can be passed to SVTL_setParallelThreshold.*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 199309L /*clock_gettime, as the project builds as C89*/
+#endif
+
+#include <svtl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MIN_VERTEX_COUNT 16u
+#define MAX_VERTEX_COUNT (1u << 22)
+#define VERTICES_PER_MEASUREMENT (1u << 25)
+
+struct Vertex2D {
+	float x;
+	float y;
+
+	float r;
+	float g;
+	float b;
+};
+
+static double nowNS(void)
+{
+    struct timespec ts;
+#ifdef _WIN32
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/*returns the average time of one call in nanoseconds*/
+static double timeOperation(struct SVTL_VertexInfo* vi, int rotate, uint32_t threshold)
+{
+    struct SVTL_F64Vec2 v = { 0.001, -0.001 };
+    uint32_t reps = VERTICES_PER_MEASUREMENT / vi->count;
+    uint32_t i;
+    double start;
+
+    SVTL_setParallelThreshold(threshold);
+
+    /*warm up the caches and the thread pool*/
+    for (i = 0; i < 4; ++i)
+        rotate ? SVTL_rotate2D(vi, 0.001, v) : SVTL_translate2D(vi, v);
+
+    start = nowNS();
+    for (i = 0; i < reps; ++i)
+        rotate ? SVTL_rotate2D(vi, 0.001, v) : SVTL_translate2D(vi, v);
+    return (nowNS() - start) / reps;
+}
+
+int main(void)
+{
+    struct Vertex2D* vertices;
+    struct SVTL_VertexInfo vi;
+    uint32_t count;
+    uint32_t crossover[2] = { 0, 0 };
+    int op;
+
+    if (SVTL_register())
+        return 1;
+
+    vertices = calloc(MAX_VERTEX_COUNT, sizeof(struct Vertex2D));
+    if (!vertices)
+        return 1;
+
+    vi.stride = sizeof(struct Vertex2D);
+    vi.positionOffset = 0u;
+    vi.positionType = SVTL_POS_TYPE_VEC2_F32;
+    vi.vertices = vertices;
+    vi.indices = NULL;
+
+    printf("workers: %u\n", SVTL_getWorkerCount());
+    printf("%10s | %14s %14s | %14s %14s\n", "vertices", "translate ser", "translate par", "rotate ser", "rotate par");
+    for (count = MIN_VERTEX_COUNT; count <= MAX_VERTEX_COUNT; count *= 2)
+    {
+        double t[2][2];
+        vi.count = count;
+        for (op = 0; op < 2; ++op)
+        {
+            t[op][0] = timeOperation(&vi, op, UINT32_MAX);
+            t[op][1] = timeOperation(&vi, op, 0);
+
+            /*the crossover is the smallest count from which the parallel path stays faster*/
+            if (t[op][1] < t[op][0]) {
+                if (crossover[op] == 0)
+                    crossover[op] = count;
+            } else {
+                crossover[op] = 0;
+            }
+        }
+        printf("%10u | %11.0f ns %11.0f ns | %11.0f ns %11.0f ns\n", count, t[0][0], t[0][1], t[1][0], t[1][1]);
+    }
+
+    for (op = 0; op < 2; ++op)
+    {
+        if (crossover[op])
+            printf("%s crossover: %u vertices\n", op ? "rotate" : "translate", crossover[op]);
+        else
+            printf("%s crossover: none up to %u vertices\n", op ? "rotate" : "translate", MAX_VERTEX_COUNT);
+    }
+
+    free(vertices);
+    SVTL_unregister();
+    return 0;
+}
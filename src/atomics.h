@@ -0,0 +1,65 @@
+/*
+Copyright (C) 2025 Tripp Robins
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this
+software and associated documentation files (the "Software"), to deal in the Software
+without restriction, including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+Minimal atomic operations on 32-bit and 8-bit values, for compilers without C11 atomics.
+Loads acquire, stores release, and read-modify-write operations are sequentially consistent.*/
+
+#ifndef ATOMICS_H
+#define ATOMICS_H
+
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+
+    #define ATOMIC_LOAD_U32(p) ((uint32_t)_InterlockedOr((volatile long*)(p), 0))
+    #define ATOMIC_STORE_U32(p, v) ((void)_InterlockedExchange((volatile long*)(p), (long)(v)))
+    #define ATOMIC_CAS_U32(p, expected, desired) (_InterlockedCompareExchange((volatile long*)(p), (long)(desired), (long)(expected)) == (long)(expected))
+    #define ATOMIC_FETCH_ADD_U32(p, v) ((uint32_t)_InterlockedExchangeAdd((volatile long*)(p), (long)(v)))
+    #define ATOMIC_LOAD_U8(p) ((uint8_t)_InterlockedOr8((volatile char*)(p), 0))
+    #define ATOMIC_FETCH_OR_U8(p, v) ((uint8_t)_InterlockedOr8((volatile char*)(p), (char)(v)))
+
+    #if defined(_M_IX86) || defined(_M_X64)
+        #define CPU_PAUSE() _mm_pause()
+    #elif defined(_M_ARM) || defined(_M_ARM64)
+        #define CPU_PAUSE() __yield()
+    #else
+        #define CPU_PAUSE() ((void)0)
+    #endif
+#else
+    #define ATOMIC_LOAD_U32(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define ATOMIC_STORE_U32(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define ATOMIC_CAS_U32(p, expected, desired) __sync_bool_compare_and_swap((p), (expected), (desired))
+    #define ATOMIC_FETCH_ADD_U32(p, v) __atomic_fetch_add((p), (v), __ATOMIC_SEQ_CST)
+    #define ATOMIC_LOAD_U8(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define ATOMIC_FETCH_OR_U8(p, v) __atomic_fetch_or((p), (v), __ATOMIC_SEQ_CST)
+
+    #if defined(__i386__) || defined(__x86_64__)
+        #define CPU_PAUSE() __builtin_ia32_pause()
+    #elif defined(__aarch64__) || defined(__arm__)
+        #define CPU_PAUSE() __asm__ __volatile__("yield")
+    #else
+        #define CPU_PAUSE() ((void)0)
+    #endif
+#endif
+
+/*a lock for short critical sections that can be statically initialised to 0*/
+#define SPIN_LOCK(lock) do { while (!ATOMIC_CAS_U32((lock), 0u, 1u)) CPU_PAUSE(); } while (0)
+#define SPIN_UNLOCK(lock) ATOMIC_STORE_U32((lock), 0u)
+
+#endif /*!ATOMICS_H*/
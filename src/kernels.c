@@ -0,0 +1,2400 @@
+/*
+Copyright (C) 2025 Tripp Robins
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this
+software and associated documentation files (the "Software"), to deal in the Software
+without restriction, including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kernels.h"
+#include "atomics.h"
+#include <string.h>
+#include <math.h>
+
+/*every x86 version is compiled regardless of the compiler flags, and one is selected from cpuid at run time*/
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define KERNELS_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define KERNELS_TARGET(isa)
+    #else
+        #define KERNELS_TARGET(isa) __attribute__((target(isa)))
+    #endif
+#endif
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef int16_t i16;
+typedef uint32_t u32;
+typedef int32_t i32;
+typedef uint64_t u64;
+typedef int64_t i64;
+typedef float f32;
+typedef double f64;
+
+/*
+Every affine kernel evaluates x' = a*x + b*y + tx, y' = c*x + d*y + ty.
+With the (x, y) pairs of a vertex held side by side in a register v, this is
+    v * (a, d) + swap(v) * (b, c) + (tx, ty)
+so a register of any width transforms as many vertices as it holds pairs, without deinterleaving.
+The linear part is skipped when it is the identity, which keeps translation exact for non-finite positions.
+
+The shoelace kernels sum, over consecutive positions p[i] and p[i+1], cross = x[i]*y[i+1] - x[i+1]*y[i]
+and optionally (x[i] + x[i+1]) * cross and (y[i] + y[i+1]) * cross, in double precision.
+Each level accumulates in as many partial sums as its registers hold lanes, so the sums agree across levels only to rounding.
+
+The 3D affine kernels evaluate p' = M p + t for the top three rows of a 4x4 matrix. A vertex has an odd number of components,
+so interleaved positions are transformed one vertex per register, as the sum of the matrix columns scaled by its broadcast components,
+and the AVX-512 level gathers the components of eight vertices instead. Every version adds the terms in the same order as the scalar code.
+
+The homography kernels evaluate the numerators of x' and y' as the affine kernels do, and the denominator w = g*x + h*y + i
+in the same pair layout, as v * (g, h) + swap(v) * (h, g) + (i, i), which leaves w in both lanes of a pair.
+Each vertex takes one division, of 1 by w, and both numerators are multiplied by the reciprocal.
+The division is exact at every level, so results do not depend on the instruction set. Positions where w is 0 become non-finite.
+
+The byte equality kernels compare blocks of 8 to 64 bytes with a fixed number of loads that cover the block, the last of which overlaps the ones before it,
+so a block is compared without a loop over its bytes and without reading past its end.
+
+The transform kernels round each vertex the same way at every level, so their results are identical to the scalar code
+whatever the instruction set, and whichever vertices of a chunk fall in a vector loop or its scalar tail.
+This relies on this file being compiled without -ffast-math and without FMA contraction, which cmakelists.txt sets for it.
+
+The SoA kernels read x and y from separate packed arrays, so every register holds one component of consecutive vertices
+and the same arithmetic runs across full width, without shuffles or gathers.
+
+The conversion kernels widen compact components to F32, or I32_FIXED components to F64, and narrow them back.
+Every version rounds to nearest even and clamps the same way, so results do not depend on the instruction set:
+I16_NORM widens as max(i / 32767, -1) and narrows as round(clamp(v, -1, 1) * 32767),
+I32_FIXED widens as i / 65536 and narrows as round(v * 65536) clamped to the 32-bit range.*/
+
+/*the transform coefficients, in the order a, b, tx, c, d, ty*/
+struct Kernels_F32Affine { f32 k[6]; int linear; };
+struct Kernels_F64Affine { f64 k[6]; int linear; };
+
+/*the top three rows of a 4x4 transform, row-major*/
+struct Kernels_F32Affine3D { f32 k[12]; int linear; };
+struct Kernels_F64Affine3D { f64 k[12]; int linear; };
+
+/*a 3x3 projective transform, row-major, in the order a, b, tx, c, d, ty, g, h, i*/
+struct Kernels_F32Homography { f32 k[9]; };
+struct Kernels_F64Homography { f64 k[9]; };
+
+struct Kernels_Table
+{
+    void (*affine2DF32)(u8* p, u32 stride, u32 count, const struct Kernels_F32Affine* t);
+    void (*affine2DF64)(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine* t);
+    /*reads count + 1 positions*/
+    void (*shoelace2DF32)(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3]);
+    void (*shoelace2DF64)(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3]);
+    void (*affine2DSoAF32)(f32* x, f32* y, u32 count, const struct Kernels_F32Affine* t);
+    void (*affine2DSoAF64)(f64* x, f64* y, u32 count, const struct Kernels_F64Affine* t);
+    void (*shoelace2DSoAF32)(const f32* x, const f32* y, u32 count, int centroid, f64 sums[3]);
+    void (*shoelace2DSoAF64)(const f64* x, const f64* y, u32 count, int centroid, f64 sums[3]);
+    void (*streamCopy)(u8* dst, const u8* src, size_t bytes);
+    void (*widenF16)(const u16* in, f32* out, size_t count);
+    void (*narrowF16)(const f32* in, u16* out, size_t count);
+    void (*widenI16Norm)(const i16* in, f32* out, size_t count);
+    void (*narrowI16Norm)(const f32* in, i16* out, size_t count);
+    void (*widenI32Fixed)(const i32* in, f64* out, size_t count);
+    void (*narrowI32Fixed)(const f64* in, i32* out, size_t count);
+    void (*affine3DF32)(u8* p, u32 stride, u32 count, const struct Kernels_F32Affine3D* t);
+    void (*affine3DF64)(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine3D* t);
+    void (*affine3DSoAF32)(f32* x, f32* y, f32* z, u32 count, const struct Kernels_F32Affine3D* t);
+    void (*affine3DSoAF64)(f64* x, f64* y, f64* z, u32 count, const struct Kernels_F64Affine3D* t);
+    void (*homography2DF32)(u8* p, u32 stride, u32 count, const struct Kernels_F32Homography* t);
+    void (*homography2DF64)(u8* p, u32 stride, u32 count, const struct Kernels_F64Homography* t);
+    void (*homography2DSoAF32)(f32* x, f32* y, u32 count, const struct Kernels_F32Homography* t);
+    void (*homography2DSoAF64)(f64* x, f64* y, u32 count, const struct Kernels_F64Homography* t);
+    int (*bytesEqual17To32)(const void* a, const void* b, u32 size);
+    int (*bytesEqual33To64)(const void* a, const void* b, u32 size);
+};
+
+static int isLinearPartIdentity(const struct SVTL_F64Mat2x3* t)
+{
+    return t->m[0][0] == 1.0 && t->m[0][1] == 0.0 && t->m[1][0] == 0.0 && t->m[1][1] == 1.0;
+}
+
+static void affine2DF32Scalar(u8* p, u32 stride, u32 count, const struct Kernels_F32Affine* t)
+{
+    const f32* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        f32* pos = (f32*)p;
+        const f32 x = pos[0];
+        const f32 y = pos[1];
+        if (t->linear) {
+            pos[0] = k[0] * x + k[1] * y + k[2];
+            pos[1] = k[3] * x + k[4] * y + k[5];
+        } else {
+            pos[0] = x + k[2];
+            pos[1] = y + k[5];
+        }
+    }
+}
+
+static void affine2DF64Scalar(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine* t)
+{
+    const f64* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        f64* pos = (f64*)p;
+        const f64 x = pos[0];
+        const f64 y = pos[1];
+        if (t->linear) {
+            pos[0] = k[0] * x + k[1] * y + k[2];
+            pos[1] = k[3] * x + k[4] * y + k[5];
+        } else {
+            pos[0] = x + k[2];
+            pos[1] = y + k[5];
+        }
+    }
+}
+
+static void shoelacePair(f64 ax, f64 ay, f64 bx, f64 by, int centroid, f64 sums[3])
+{
+    const f64 cross = ax * by - bx * ay;
+    sums[0] += cross;
+    if (centroid) {
+        sums[1] += (ax + bx) * cross;
+        sums[2] += (ay + by) * cross;
+    }
+}
+
+static void shoelace2DF32Scalar(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3])
+{
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        const f32* a = (const f32*)p;
+        const f32* b = (const f32*)(p + stride);
+        shoelacePair(a[0], a[1], b[0], b[1], centroid, sums);
+    }
+}
+
+static void shoelace2DF64Scalar(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3])
+{
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        const f64* a = (const f64*)p;
+        const f64* b = (const f64*)(p + stride);
+        shoelacePair(a[0], a[1], b[0], b[1], centroid, sums);
+    }
+}
+
+static void affine2DSoAF32Scalar(f32* x, f32* y, u32 count, const struct Kernels_F32Affine* t)
+{
+    const f32* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i)
+    {
+        const f32 px = x[i];
+        const f32 py = y[i];
+        if (t->linear) {
+            x[i] = k[0] * px + k[1] * py + k[2];
+            y[i] = k[3] * px + k[4] * py + k[5];
+        } else {
+            x[i] = px + k[2];
+            y[i] = py + k[5];
+        }
+    }
+}
+
+static void affine2DSoAF64Scalar(f64* x, f64* y, u32 count, const struct Kernels_F64Affine* t)
+{
+    const f64* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i)
+    {
+        const f64 px = x[i];
+        const f64 py = y[i];
+        if (t->linear) {
+            x[i] = k[0] * px + k[1] * py + k[2];
+            y[i] = k[3] * px + k[4] * py + k[5];
+        } else {
+            x[i] = px + k[2];
+            y[i] = py + k[5];
+        }
+    }
+}
+
+static void shoelace2DSoAF32Scalar(const f32* x, const f32* y, u32 count, int centroid, f64 sums[3])
+{
+    u32 i;
+    for (i = 0; i < count; ++i)
+        shoelacePair(x[i], y[i], x[i + 1], y[i + 1], centroid, sums);
+}
+
+static void shoelace2DSoAF64Scalar(const f64* x, const f64* y, u32 count, int centroid, f64 sums[3])
+{
+    u32 i;
+    for (i = 0; i < count; ++i)
+        shoelacePair(x[i], y[i], x[i + 1], y[i + 1], centroid, sums);
+}
+
+static void streamCopyScalar(u8* dst, const u8* src, size_t bytes)
+{
+    memcpy(dst, src, bytes);
+}
+
+static u64 loadU64(const u8* p)
+{
+    u64 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static int bytesEqualMemcmp(const void* a, const void* b, u32 size)
+{
+    return memcmp(a, b, size) == 0;
+}
+
+static int bytesEqual8To16(const void* a, const void* b, u32 size)
+{
+    const u8* pa = a;
+    const u8* pb = b;
+    return ((loadU64(pa) ^ loadU64(pb)) | (loadU64(pa + size - 8) ^ loadU64(pb + size - 8))) == 0;
+}
+
+static int bytesEqual17To64Scalar(const void* a, const void* b, u32 size)
+{
+    const u8* pa = a;
+    const u8* pb = b;
+    u64 diff = loadU64(pa + size - 8) ^ loadU64(pb + size - 8);
+    u32 i;
+    for (i = 0; i + 8 < size; i += 8)
+        diff |= loadU64(pa + i) ^ loadU64(pb + i);
+    return diff == 0;
+}
+
+static f32 halfToFloat(u16 h)
+{
+    const u32 sign = (u32)(h & 0x8000u) << 16;
+    u32 exponent = (h >> 10) & 0x1Fu;
+    u32 mantissa = h & 0x3FFu;
+    u32 bits;
+    if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+        if (mantissa)
+            bits |= 0x400000u; /*NaNs are quieted, as by F16C*/
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        /*a subnormal half is a normal float*/
+        exponent = 113u;
+        while (!(mantissa & 0x400u)) {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+    f32 f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static u16 floatToHalf(f32 f)
+{
+    u32 bits;
+    memcpy(&bits, &f, sizeof(bits));
+    const u16 sign = (u16)((bits >> 16) & 0x8000u);
+    const u32 magnitude = bits & 0x7FFFFFFFu;
+    if (magnitude > 0x7F800000u)
+        return sign | 0x7E00u | (u16)((magnitude >> 13) & 0x3FFu); /*NaNs are quieted, as by F16C*/
+    if (magnitude >= 0x477FF000u)
+        return sign | 0x7C00u; /*rounds past the largest half, 65504*/
+    if (magnitude >= 0x38800000u) {
+        /*normal: rebias the exponent and round the mantissa to nearest even, carrying into the exponent*/
+        const u32 h = magnitude - 0x38000000u;
+        return sign | (u16)((h + 0xFFFu + ((h >> 13) & 1u)) >> 13);
+    }
+    if (magnitude <= 0x33000000u)
+        return sign; /*at most half of the smallest subnormal half, 2^-24*/
+
+    const u32 shift = 126u - (magnitude >> 23);
+    const u32 mantissa = (magnitude & 0x7FFFFFu) | 0x800000u;
+    const u32 rest = mantissa & ((1u << shift) - 1u);
+    const u32 halfway = 1u << (shift - 1u);
+    u32 h = mantissa >> shift;
+    if (rest > halfway || (rest == halfway && (h & 1u)))
+        h++;
+    return sign | (u16)h;
+}
+
+/*rounds v to the nearest integer, ties to even, as the SIMD conversions do. C89 has no rint, and v - floor(v) is exact for the
+magnitudes narrowed here, all below 2^52*/
+static f64 roundHalfEven(f64 v)
+{
+    f64 r = floor(v);
+    const f64 fraction = v - r;
+    if (fraction > 0.5 || (fraction == 0.5 && fmod(r, 2.0) != 0.0))
+        r += 1.0;
+    return r;
+}
+
+static i16 narrowI16Norm(f32 v)
+{
+    v = v >= -1.0f ? v : -1.0f;
+    v = v <= 1.0f ? v : 1.0f;
+    return (i16)roundHalfEven((f64)(v * 32767.0f));
+}
+
+static i32 narrowI32Fixed(f64 v)
+{
+    v *= 65536.0;
+    v = v >= -2147483648.0 ? v : -2147483648.0;
+    v = v <= 2147483647.0 ? v : 2147483647.0;
+    return (i32)roundHalfEven(v);
+}
+
+static void widenF16Scalar(const u16* in, f32* out, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; ++i)
+        out[i] = halfToFloat(in[i]);
+}
+
+static void narrowF16Scalar(const f32* in, u16* out, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; ++i)
+        out[i] = floatToHalf(in[i]);
+}
+
+static void widenI16NormScalar(const i16* in, f32* out, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; ++i) {
+        const f32 v = (f32)in[i] / 32767.0f;
+        out[i] = v >= -1.0f ? v : -1.0f;
+    }
+}
+
+static void narrowI16NormScalar(const f32* in, i16* out, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; ++i)
+        out[i] = narrowI16Norm(in[i]);
+}
+
+static void widenI32FixedScalar(const i32* in, f64* out, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; ++i)
+        out[i] = (f64)in[i] / 65536.0;
+}
+
+static void narrowI32FixedScalar(const f64* in, i32* out, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; ++i)
+        out[i] = narrowI32Fixed(in[i]);
+}
+
+static void affine3DF32Scalar(u8* p, u32 stride, u32 count, const struct Kernels_F32Affine3D* t)
+{
+    const f32* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        f32* pos = (f32*)p;
+        const f32 x = pos[0];
+        const f32 y = pos[1];
+        const f32 z = pos[2];
+        if (t->linear) {
+            pos[0] = k[0] * x + k[1] * y + k[2] * z + k[3];
+            pos[1] = k[4] * x + k[5] * y + k[6] * z + k[7];
+            pos[2] = k[8] * x + k[9] * y + k[10] * z + k[11];
+        } else {
+            pos[0] = x + k[3];
+            pos[1] = y + k[7];
+            pos[2] = z + k[11];
+        }
+    }
+}
+
+static void affine3DF64Scalar(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine3D* t)
+{
+    const f64* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        f64* pos = (f64*)p;
+        const f64 x = pos[0];
+        const f64 y = pos[1];
+        const f64 z = pos[2];
+        if (t->linear) {
+            pos[0] = k[0] * x + k[1] * y + k[2] * z + k[3];
+            pos[1] = k[4] * x + k[5] * y + k[6] * z + k[7];
+            pos[2] = k[8] * x + k[9] * y + k[10] * z + k[11];
+        } else {
+            pos[0] = x + k[3];
+            pos[1] = y + k[7];
+            pos[2] = z + k[11];
+        }
+    }
+}
+
+static void affine3DSoAF32Scalar(f32* x, f32* y, f32* z, u32 count, const struct Kernels_F32Affine3D* t)
+{
+    const f32* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i)
+    {
+        const f32 px = x[i];
+        const f32 py = y[i];
+        const f32 pz = z[i];
+        if (t->linear) {
+            x[i] = k[0] * px + k[1] * py + k[2] * pz + k[3];
+            y[i] = k[4] * px + k[5] * py + k[6] * pz + k[7];
+            z[i] = k[8] * px + k[9] * py + k[10] * pz + k[11];
+        } else {
+            x[i] = px + k[3];
+            y[i] = py + k[7];
+            z[i] = pz + k[11];
+        }
+    }
+}
+
+static void affine3DSoAF64Scalar(f64* x, f64* y, f64* z, u32 count, const struct Kernels_F64Affine3D* t)
+{
+    const f64* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i)
+    {
+        const f64 px = x[i];
+        const f64 py = y[i];
+        const f64 pz = z[i];
+        if (t->linear) {
+            x[i] = k[0] * px + k[1] * py + k[2] * pz + k[3];
+            y[i] = k[4] * px + k[5] * py + k[6] * pz + k[7];
+            z[i] = k[8] * px + k[9] * py + k[10] * pz + k[11];
+        } else {
+            x[i] = px + k[3];
+            y[i] = py + k[7];
+            z[i] = pz + k[11];
+        }
+    }
+}
+
+static void homography2DF32Scalar(u8* p, u32 stride, u32 count, const struct Kernels_F32Homography* t)
+{
+    const f32* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        f32* pos = (f32*)p;
+        const f32 x = pos[0];
+        const f32 y = pos[1];
+        const f32 r = 1.0f / (k[6] * x + k[7] * y + k[8]);
+        pos[0] = (k[0] * x + k[1] * y + k[2]) * r;
+        pos[1] = (k[3] * x + k[4] * y + k[5]) * r;
+    }
+}
+
+static void homography2DF64Scalar(u8* p, u32 stride, u32 count, const struct Kernels_F64Homography* t)
+{
+    const f64* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        f64* pos = (f64*)p;
+        const f64 x = pos[0];
+        const f64 y = pos[1];
+        const f64 r = 1.0 / (k[6] * x + k[7] * y + k[8]);
+        pos[0] = (k[0] * x + k[1] * y + k[2]) * r;
+        pos[1] = (k[3] * x + k[4] * y + k[5]) * r;
+    }
+}
+
+static void homography2DSoAF32Scalar(f32* x, f32* y, u32 count, const struct Kernels_F32Homography* t)
+{
+    const f32* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i)
+    {
+        const f32 px = x[i];
+        const f32 py = y[i];
+        const f32 r = 1.0f / (k[6] * px + k[7] * py + k[8]);
+        x[i] = (k[0] * px + k[1] * py + k[2]) * r;
+        y[i] = (k[3] * px + k[4] * py + k[5]) * r;
+    }
+}
+
+static void homography2DSoAF64Scalar(f64* x, f64* y, u32 count, const struct Kernels_F64Homography* t)
+{
+    const f64* k = t->k;
+    u32 i;
+    for (i = 0; i < count; ++i)
+    {
+        const f64 px = x[i];
+        const f64 py = y[i];
+        const f64 r = 1.0 / (k[6] * px + k[7] * py + k[8]);
+        x[i] = (k[0] * px + k[1] * py + k[2]) * r;
+        y[i] = (k[3] * px + k[4] * py + k[5]) * r;
+    }
+}
+
+#ifdef KERNELS_X86
+
+/* SSE2 */
+
+KERNELS_TARGET("sse2") static __m128 affineF32x4(__m128 v, __m128 diag, __m128 anti, __m128 offs, int linear)
+{
+    if (!linear)
+        return _mm_add_ps(v, offs);
+    const __m128 s = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, diag), _mm_mul_ps(s, anti)), offs);
+}
+
+KERNELS_TARGET("sse2") static __m128d affineF64x2(__m128d v, __m128d diag, __m128d anti, __m128d offs, int linear)
+{
+    if (!linear)
+        return _mm_add_pd(v, offs);
+    const __m128d s = _mm_shuffle_pd(v, v, 1);
+    return _mm_add_pd(_mm_add_pd(_mm_mul_pd(v, diag), _mm_mul_pd(s, anti)), offs);
+}
+
+KERNELS_TARGET("sse2") static void affine2DF32SSE2(u8* p, u32 stride, u32 count, const struct Kernels_F32Affine* t)
+{
+    const f32* k = t->k;
+    const __m128 diag = _mm_setr_ps(k[0], k[4], k[0], k[4]);
+    const __m128 anti = _mm_setr_ps(k[1], k[3], k[1], k[3]);
+    const __m128 offs = _mm_setr_ps(k[2], k[5], k[2], k[5]);
+    u32 i = 0;
+    if (stride == 2 * sizeof(f32))
+    {
+        for (; i + 4 <= count; i += 4, p += 4 * stride)
+        {
+            __m128 v0 = _mm_loadu_ps((const f32*)p);
+            __m128 v1 = _mm_loadu_ps((const f32*)p + 4);
+            _mm_storeu_ps((f32*)p, affineF32x4(v0, diag, anti, offs, t->linear));
+            _mm_storeu_ps((f32*)p + 4, affineF32x4(v1, diag, anti, offs, t->linear));
+        }
+    }
+    else
+    {
+        /*gathers the pairs of two vertices into one register*/
+        for (; i + 2 <= count; i += 2, p += 2 * stride)
+        {
+            __m128 v = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p);
+            v = _mm_loadh_pi(v, (const __m64*)(p + stride));
+            v = affineF32x4(v, diag, anti, offs, t->linear);
+            _mm_storel_pi((__m64*)p, v);
+            _mm_storeh_pi((__m64*)(p + stride), v);
+        }
+    }
+    affine2DF32Scalar(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("sse2") static void affine2DF64SSE2(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine* t)
+{
+    const f64* k = t->k;
+    const __m128d diag = _mm_setr_pd(k[0], k[4]);
+    const __m128d anti = _mm_setr_pd(k[1], k[3]);
+    const __m128d offs = _mm_setr_pd(k[2], k[5]);
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2, p += 2 * stride)
+    {
+        __m128d v0 = _mm_loadu_pd((const f64*)p);
+        __m128d v1 = _mm_loadu_pd((const f64*)(p + stride));
+        _mm_storeu_pd((f64*)p, affineF64x2(v0, diag, anti, offs, t->linear));
+        _mm_storeu_pd((f64*)(p + stride), affineF64x2(v1, diag, anti, offs, t->linear));
+    }
+    affine2DF64Scalar(p, stride, count - i, t);
+}
+
+/*adds the terms of one edge, a and b are (x, y) pairs*/
+KERNELS_TARGET("sse2") static void shoelaceF64x2(__m128d a, __m128d b, int centroid, __m128d* crossAcc, __m128d* centroidAcc)
+{
+    const __m128d prod = _mm_mul_pd(a, _mm_shuffle_pd(b, b, 1)); /*(ax*by, ay*bx)*/
+    *crossAcc = _mm_add_pd(*crossAcc, prod);
+    if (centroid) {
+        const __m128d cross = _mm_sub_sd(prod, _mm_unpackhi_pd(prod, prod));
+        *centroidAcc = _mm_add_pd(*centroidAcc, _mm_mul_pd(_mm_add_pd(a, b), _mm_unpacklo_pd(cross, cross)));
+    }
+}
+
+KERNELS_TARGET("sse2") static void addShoelaceSumsSSE2(__m128d crossAcc, __m128d centroidAcc, f64 sums[3])
+{
+    f64 c[2], s[2];
+    _mm_storeu_pd(c, crossAcc);
+    _mm_storeu_pd(s, centroidAcc);
+    sums[0] += c[0] - c[1];
+    sums[1] += s[0];
+    sums[2] += s[1];
+}
+
+KERNELS_TARGET("sse2") static void shoelace2DF32SSE2(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3])
+{
+    __m128d crossAcc = _mm_setzero_pd();
+    __m128d centroidAcc = _mm_setzero_pd();
+    __m128d a = _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd((const f64*)p)));
+    u32 i;
+    for (i = 0; i < count; ++i)
+    {
+        p += stride;
+        const __m128d b = _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd((const f64*)p)));
+        shoelaceF64x2(a, b, centroid, &crossAcc, &centroidAcc);
+        a = b;
+    }
+    addShoelaceSumsSSE2(crossAcc, centroidAcc, sums);
+}
+
+KERNELS_TARGET("sse2") static void shoelace2DF64SSE2(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3])
+{
+    __m128d crossAcc = _mm_setzero_pd();
+    __m128d centroidAcc = _mm_setzero_pd();
+    __m128d a = _mm_loadu_pd((const f64*)p);
+    u32 i;
+    for (i = 0; i < count; ++i)
+    {
+        p += stride;
+        const __m128d b = _mm_loadu_pd((const f64*)p);
+        shoelaceF64x2(a, b, centroid, &crossAcc, &centroidAcc);
+        a = b;
+    }
+    addShoelaceSumsSSE2(crossAcc, centroidAcc, sums);
+}
+
+KERNELS_TARGET("sse2") static void affine2DSoAF32SSE2(f32* x, f32* y, u32 count, const struct Kernels_F32Affine* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 px = _mm_loadu_ps(x + i);
+        const __m128 py = _mm_loadu_ps(y + i);
+        if (t->linear) {
+            _mm_storeu_ps(x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(k[0])), _mm_mul_ps(py, _mm_set1_ps(k[1]))), _mm_set1_ps(k[2])));
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(k[3])), _mm_mul_ps(py, _mm_set1_ps(k[4]))), _mm_set1_ps(k[5])));
+        } else {
+            _mm_storeu_ps(x + i, _mm_add_ps(px, _mm_set1_ps(k[2])));
+            _mm_storeu_ps(y + i, _mm_add_ps(py, _mm_set1_ps(k[5])));
+        }
+    }
+    affine2DSoAF32Scalar(x + i, y + i, count - i, t);
+}
+
+KERNELS_TARGET("sse2") static void affine2DSoAF64SSE2(f64* x, f64* y, u32 count, const struct Kernels_F64Affine* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d px = _mm_loadu_pd(x + i);
+        const __m128d py = _mm_loadu_pd(y + i);
+        if (t->linear) {
+            _mm_storeu_pd(x + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(px, _mm_set1_pd(k[0])), _mm_mul_pd(py, _mm_set1_pd(k[1]))), _mm_set1_pd(k[2])));
+            _mm_storeu_pd(y + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(px, _mm_set1_pd(k[3])), _mm_mul_pd(py, _mm_set1_pd(k[4]))), _mm_set1_pd(k[5])));
+        } else {
+            _mm_storeu_pd(x + i, _mm_add_pd(px, _mm_set1_pd(k[2])));
+            _mm_storeu_pd(y + i, _mm_add_pd(py, _mm_set1_pd(k[5])));
+        }
+    }
+    affine2DSoAF64Scalar(x + i, y + i, count - i, t);
+}
+
+/*adds the terms of two edges from deinterleaved positions*/
+KERNELS_TARGET("sse2") static void shoelaceSoAF64x2(__m128d ax, __m128d ay, __m128d bx, __m128d by, int centroid,
+    __m128d* crossAcc, __m128d* cxAcc, __m128d* cyAcc)
+{
+    const __m128d cross = _mm_sub_pd(_mm_mul_pd(ax, by), _mm_mul_pd(bx, ay));
+    *crossAcc = _mm_add_pd(*crossAcc, cross);
+    if (centroid) {
+        *cxAcc = _mm_add_pd(*cxAcc, _mm_mul_pd(_mm_add_pd(ax, bx), cross));
+        *cyAcc = _mm_add_pd(*cyAcc, _mm_mul_pd(_mm_add_pd(ay, by), cross));
+    }
+}
+
+KERNELS_TARGET("sse2") static void addShoelaceSoASumsSSE2(__m128d crossAcc, __m128d cxAcc, __m128d cyAcc, f64 sums[3])
+{
+    f64 c[2], sx[2], sy[2];
+    _mm_storeu_pd(c, crossAcc);
+    _mm_storeu_pd(sx, cxAcc);
+    _mm_storeu_pd(sy, cyAcc);
+    sums[0] += c[0] + c[1];
+    sums[1] += sx[0] + sx[1];
+    sums[2] += sy[0] + sy[1];
+}
+
+KERNELS_TARGET("sse2") static __m128d loadF32x2AsF64(const f32* p)
+{
+    return _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd((const f64*)p)));
+}
+
+KERNELS_TARGET("sse2") static void shoelace2DSoAF32SSE2(const f32* x, const f32* y, u32 count, int centroid, f64 sums[3])
+{
+    __m128d crossAcc = _mm_setzero_pd();
+    __m128d cxAcc = _mm_setzero_pd();
+    __m128d cyAcc = _mm_setzero_pd();
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2)
+        shoelaceSoAF64x2(loadF32x2AsF64(x + i), loadF32x2AsF64(y + i), loadF32x2AsF64(x + i + 1), loadF32x2AsF64(y + i + 1),
+            centroid, &crossAcc, &cxAcc, &cyAcc);
+    addShoelaceSoASumsSSE2(crossAcc, cxAcc, cyAcc, sums);
+    shoelace2DSoAF32Scalar(x + i, y + i, count - i, centroid, sums);
+}
+
+KERNELS_TARGET("sse2") static void shoelace2DSoAF64SSE2(const f64* x, const f64* y, u32 count, int centroid, f64 sums[3])
+{
+    __m128d crossAcc = _mm_setzero_pd();
+    __m128d cxAcc = _mm_setzero_pd();
+    __m128d cyAcc = _mm_setzero_pd();
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2)
+        shoelaceSoAF64x2(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i), _mm_loadu_pd(x + i + 1), _mm_loadu_pd(y + i + 1),
+            centroid, &crossAcc, &cxAcc, &cyAcc);
+    addShoelaceSoASumsSSE2(crossAcc, cxAcc, cyAcc, sums);
+    shoelace2DSoAF64Scalar(x + i, y + i, count - i, centroid, sums);
+}
+
+/*the destination is aligned with ordinary stores, the rest is written with non-temporal stores that bypass the cache*/
+KERNELS_TARGET("sse2") static void streamCopySSE2(u8* dst, const u8* src, size_t bytes)
+{
+    size_t head = (size_t)(-(intptr_t)dst & 15);
+    if (head > bytes)
+        head = bytes;
+    memcpy(dst, src, head);
+    size_t i = head;
+    for (; i + 16 <= bytes; i += 16)
+        _mm_stream_si128((__m128i*)(dst + i), _mm_loadu_si128((const __m128i*)(src + i)));
+    memcpy(dst + i, src + i, bytes - i);
+}
+
+KERNELS_TARGET("sse2") static void streamFenceSSE2(void)
+{
+    _mm_sfence();
+}
+
+/*the SSE2 level has no half-precision conversion instructions, so F16 uses the scalar kernels*/
+
+KERNELS_TARGET("sse2") static void widenI16NormSSE2(const i16* in, f32* out, size_t count)
+{
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    const __m128 lo = _mm_set1_ps(-1.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        /*sign-extend by placing each value in the high half of a 32-bit lane and shifting it down*/
+        const __m128i a = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i b = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(out + i, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(a), scale), lo));
+        _mm_storeu_ps(out + i + 4, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(b), scale), lo));
+    }
+    widenI16NormScalar(in + i, out + i, count - i);
+}
+
+KERNELS_TARGET("sse2") static __m128i narrowI16NormF32x4(__m128 v)
+{
+    v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(32767.0f)));
+}
+
+KERNELS_TARGET("sse2") static void narrowI16NormSSE2(const f32* in, i16* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i a = narrowI16NormF32x4(_mm_loadu_ps(in + i));
+        const __m128i b = narrowI16NormF32x4(_mm_loadu_ps(in + i + 4));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(a, b));
+    }
+    narrowI16NormScalar(in + i, out + i, count - i);
+}
+
+KERNELS_TARGET("sse2") static void widenI32FixedSSE2(const i32* in, f64* out, size_t count)
+{
+    const __m128d scale = _mm_set1_pd(1.0 / 65536.0);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)(in + i))), scale));
+    widenI32FixedScalar(in + i, out + i, count - i);
+}
+
+KERNELS_TARGET("sse2") static void narrowI32FixedSSE2(const f64* in, i32* out, size_t count)
+{
+    const __m128d scale = _mm_set1_pd(65536.0);
+    const __m128d lo = _mm_set1_pd(-2147483648.0);
+    const __m128d hi = _mm_set1_pd(2147483647.0);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d v = _mm_min_pd(_mm_max_pd(_mm_mul_pd(_mm_loadu_pd(in + i), scale), lo), hi);
+        _mm_storel_epi64((__m128i*)(out + i), _mm_cvtpd_epi32(v));
+    }
+    narrowI32FixedScalar(in + i, out + i, count - i);
+}
+
+KERNELS_TARGET("sse2") static void affine3DF32SSE2(u8* p, u32 stride, u32 count, const struct Kernels_F32Affine3D* t)
+{
+    const f32* k = t->k;
+    const __m128 c0 = _mm_setr_ps(k[0], k[4], k[8], 0.0f);
+    const __m128 c1 = _mm_setr_ps(k[1], k[5], k[9], 0.0f);
+    const __m128 c2 = _mm_setr_ps(k[2], k[6], k[10], 0.0f);
+    const __m128 c3 = _mm_setr_ps(k[3], k[7], k[11], 0.0f);
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        f32* pos = (f32*)p;
+        __m128 r;
+        if (t->linear) {
+            r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(pos[0])), _mm_mul_ps(c1, _mm_set1_ps(pos[1])));
+            r = _mm_add_ps(_mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(pos[2]))), c3);
+        } else {
+            r = _mm_add_ps(_mm_setr_ps(pos[0], pos[1], pos[2], 0.0f), c3);
+        }
+        _mm_storel_pi((__m64*)pos, r);
+        _mm_store_ss(pos + 2, _mm_movehl_ps(r, r));
+    }
+}
+
+KERNELS_TARGET("sse2") static void affine3DF64SSE2(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine3D* t)
+{
+    const f64* k = t->k;
+    const __m128d c0 = _mm_setr_pd(k[0], k[4]), c0z = _mm_set_sd(k[8]);
+    const __m128d c1 = _mm_setr_pd(k[1], k[5]), c1z = _mm_set_sd(k[9]);
+    const __m128d c2 = _mm_setr_pd(k[2], k[6]), c2z = _mm_set_sd(k[10]);
+    const __m128d c3 = _mm_setr_pd(k[3], k[7]), c3z = _mm_set_sd(k[11]);
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        f64* pos = (f64*)p;
+        __m128d xy, z;
+        if (t->linear) {
+            const __m128d px = _mm_set1_pd(pos[0]);
+            const __m128d py = _mm_set1_pd(pos[1]);
+            const __m128d pz = _mm_set1_pd(pos[2]);
+            xy = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(c0, px), _mm_mul_pd(c1, py)), _mm_mul_pd(c2, pz)), c3);
+            z = _mm_add_sd(_mm_add_sd(_mm_add_sd(_mm_mul_sd(c0z, px), _mm_mul_sd(c1z, py)), _mm_mul_sd(c2z, pz)), c3z);
+        } else {
+            xy = _mm_add_pd(_mm_loadu_pd(pos), c3);
+            z = _mm_add_sd(_mm_load_sd(pos + 2), c3z);
+        }
+        _mm_storeu_pd(pos, xy);
+        _mm_store_sd(pos + 2, z);
+    }
+}
+
+KERNELS_TARGET("sse2") static void affine3DSoAF32SSE2(f32* x, f32* y, f32* z, u32 count, const struct Kernels_F32Affine3D* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 px = _mm_loadu_ps(x + i);
+        const __m128 py = _mm_loadu_ps(y + i);
+        const __m128 pz = _mm_loadu_ps(z + i);
+        if (t->linear) {
+            _mm_storeu_ps(x + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(k[0])), _mm_mul_ps(py, _mm_set1_ps(k[1]))), _mm_mul_ps(pz, _mm_set1_ps(k[2]))), _mm_set1_ps(k[3])));
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(k[4])), _mm_mul_ps(py, _mm_set1_ps(k[5]))), _mm_mul_ps(pz, _mm_set1_ps(k[6]))), _mm_set1_ps(k[7])));
+            _mm_storeu_ps(z + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(k[8])), _mm_mul_ps(py, _mm_set1_ps(k[9]))), _mm_mul_ps(pz, _mm_set1_ps(k[10]))), _mm_set1_ps(k[11])));
+        } else {
+            _mm_storeu_ps(x + i, _mm_add_ps(px, _mm_set1_ps(k[3])));
+            _mm_storeu_ps(y + i, _mm_add_ps(py, _mm_set1_ps(k[7])));
+            _mm_storeu_ps(z + i, _mm_add_ps(pz, _mm_set1_ps(k[11])));
+        }
+    }
+    affine3DSoAF32Scalar(x + i, y + i, z + i, count - i, t);
+}
+
+KERNELS_TARGET("sse2") static void affine3DSoAF64SSE2(f64* x, f64* y, f64* z, u32 count, const struct Kernels_F64Affine3D* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d px = _mm_loadu_pd(x + i);
+        const __m128d py = _mm_loadu_pd(y + i);
+        const __m128d pz = _mm_loadu_pd(z + i);
+        if (t->linear) {
+            _mm_storeu_pd(x + i, _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(px, _mm_set1_pd(k[0])), _mm_mul_pd(py, _mm_set1_pd(k[1]))), _mm_mul_pd(pz, _mm_set1_pd(k[2]))), _mm_set1_pd(k[3])));
+            _mm_storeu_pd(y + i, _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(px, _mm_set1_pd(k[4])), _mm_mul_pd(py, _mm_set1_pd(k[5]))), _mm_mul_pd(pz, _mm_set1_pd(k[6]))), _mm_set1_pd(k[7])));
+            _mm_storeu_pd(z + i, _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(px, _mm_set1_pd(k[8])), _mm_mul_pd(py, _mm_set1_pd(k[9]))), _mm_mul_pd(pz, _mm_set1_pd(k[10]))), _mm_set1_pd(k[11])));
+        } else {
+            _mm_storeu_pd(x + i, _mm_add_pd(px, _mm_set1_pd(k[3])));
+            _mm_storeu_pd(y + i, _mm_add_pd(py, _mm_set1_pd(k[7])));
+            _mm_storeu_pd(z + i, _mm_add_pd(pz, _mm_set1_pd(k[11])));
+        }
+    }
+    affine3DSoAF64Scalar(x + i, y + i, z + i, count - i, t);
+}
+
+/*the coefficients of a homography in the pair layout*/
+struct Kernels_F32x4Homography { __m128 diag, anti, offs, wDiag, wAnti, wOffs; };
+struct Kernels_F64x2Homography { __m128d diag, anti, offs, wDiag, wAnti, wOffs; };
+
+KERNELS_TARGET("sse2") static struct Kernels_F32x4Homography homographyF32x4Coefficients(const f32* k)
+{
+    struct Kernels_F32x4Homography c;
+    c.diag = _mm_setr_ps(k[0], k[4], k[0], k[4]);
+    c.anti = _mm_setr_ps(k[1], k[3], k[1], k[3]);
+    c.offs = _mm_setr_ps(k[2], k[5], k[2], k[5]);
+    c.wDiag = _mm_setr_ps(k[6], k[7], k[6], k[7]);
+    c.wAnti = _mm_setr_ps(k[7], k[6], k[7], k[6]);
+    c.wOffs = _mm_set1_ps(k[8]);
+    return c;
+}
+
+KERNELS_TARGET("sse2") static struct Kernels_F64x2Homography homographyF64x2Coefficients(const f64* k)
+{
+    struct Kernels_F64x2Homography c;
+    c.diag = _mm_setr_pd(k[0], k[4]);
+    c.anti = _mm_setr_pd(k[1], k[3]);
+    c.offs = _mm_setr_pd(k[2], k[5]);
+    c.wDiag = _mm_setr_pd(k[6], k[7]);
+    c.wAnti = _mm_setr_pd(k[7], k[6]);
+    c.wOffs = _mm_set1_pd(k[8]);
+    return c;
+}
+
+KERNELS_TARGET("sse2") static __m128 homographyF32x4(__m128 v, const struct Kernels_F32x4Homography* c)
+{
+    const __m128 s = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    const __m128 num = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, c->diag), _mm_mul_ps(s, c->anti)), c->offs);
+    const __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, c->wDiag), _mm_mul_ps(s, c->wAnti)), c->wOffs);
+    return _mm_mul_ps(num, _mm_div_ps(_mm_set1_ps(1.0f), w));
+}
+
+KERNELS_TARGET("sse2") static __m128d homographyF64x2(__m128d v, const struct Kernels_F64x2Homography* c)
+{
+    const __m128d s = _mm_shuffle_pd(v, v, 1);
+    const __m128d num = _mm_add_pd(_mm_add_pd(_mm_mul_pd(v, c->diag), _mm_mul_pd(s, c->anti)), c->offs);
+    const __m128d w = _mm_add_pd(_mm_add_pd(_mm_mul_pd(v, c->wDiag), _mm_mul_pd(s, c->wAnti)), c->wOffs);
+    return _mm_mul_pd(num, _mm_div_pd(_mm_set1_pd(1.0), w));
+}
+
+KERNELS_TARGET("sse2") static void homography2DF32SSE2(u8* p, u32 stride, u32 count, const struct Kernels_F32Homography* t)
+{
+    const struct Kernels_F32x4Homography c = homographyF32x4Coefficients(t->k);
+    u32 i = 0;
+    if (stride == 2 * sizeof(f32))
+    {
+        for (; i + 4 <= count; i += 4, p += 4 * stride)
+        {
+            __m128 v0 = _mm_loadu_ps((const f32*)p);
+            __m128 v1 = _mm_loadu_ps((const f32*)p + 4);
+            _mm_storeu_ps((f32*)p, homographyF32x4(v0, &c));
+            _mm_storeu_ps((f32*)p + 4, homographyF32x4(v1, &c));
+        }
+    }
+    else
+    {
+        for (; i + 2 <= count; i += 2, p += 2 * stride)
+        {
+            __m128 v = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p);
+            v = _mm_loadh_pi(v, (const __m64*)(p + stride));
+            v = homographyF32x4(v, &c);
+            _mm_storel_pi((__m64*)p, v);
+            _mm_storeh_pi((__m64*)(p + stride), v);
+        }
+    }
+    homography2DF32Scalar(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("sse2") static void homography2DF64SSE2(u8* p, u32 stride, u32 count, const struct Kernels_F64Homography* t)
+{
+    const struct Kernels_F64x2Homography c = homographyF64x2Coefficients(t->k);
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2, p += 2 * stride)
+    {
+        __m128d v0 = _mm_loadu_pd((const f64*)p);
+        __m128d v1 = _mm_loadu_pd((const f64*)(p + stride));
+        _mm_storeu_pd((f64*)p, homographyF64x2(v0, &c));
+        _mm_storeu_pd((f64*)(p + stride), homographyF64x2(v1, &c));
+    }
+    homography2DF64Scalar(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("sse2") static void homography2DSoAF32SSE2(f32* x, f32* y, u32 count, const struct Kernels_F32Homography* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 px = _mm_loadu_ps(x + i);
+        const __m128 py = _mm_loadu_ps(y + i);
+        const __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(k[6])), _mm_mul_ps(py, _mm_set1_ps(k[7]))), _mm_set1_ps(k[8]));
+        const __m128 r = _mm_div_ps(_mm_set1_ps(1.0f), w);
+        _mm_storeu_ps(x + i, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(k[0])), _mm_mul_ps(py, _mm_set1_ps(k[1]))), _mm_set1_ps(k[2])), r));
+        _mm_storeu_ps(y + i, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(k[3])), _mm_mul_ps(py, _mm_set1_ps(k[4]))), _mm_set1_ps(k[5])), r));
+    }
+    homography2DSoAF32Scalar(x + i, y + i, count - i, t);
+}
+
+KERNELS_TARGET("sse2") static void homography2DSoAF64SSE2(f64* x, f64* y, u32 count, const struct Kernels_F64Homography* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d px = _mm_loadu_pd(x + i);
+        const __m128d py = _mm_loadu_pd(y + i);
+        const __m128d w = _mm_add_pd(_mm_add_pd(_mm_mul_pd(px, _mm_set1_pd(k[6])), _mm_mul_pd(py, _mm_set1_pd(k[7]))), _mm_set1_pd(k[8]));
+        const __m128d r = _mm_div_pd(_mm_set1_pd(1.0), w);
+        _mm_storeu_pd(x + i, _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(px, _mm_set1_pd(k[0])), _mm_mul_pd(py, _mm_set1_pd(k[1]))), _mm_set1_pd(k[2])), r));
+        _mm_storeu_pd(y + i, _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(px, _mm_set1_pd(k[3])), _mm_mul_pd(py, _mm_set1_pd(k[4]))), _mm_set1_pd(k[5])), r));
+    }
+    homography2DSoAF64Scalar(x + i, y + i, count - i, t);
+}
+
+KERNELS_TARGET("sse2") static __m128i xorBytes16(const u8* a, const u8* b)
+{
+    return _mm_xor_si128(_mm_loadu_si128((const __m128i*)a), _mm_loadu_si128((const __m128i*)b));
+}
+
+KERNELS_TARGET("sse2") static int bytesEqual17To32SSE2(const void* a, const void* b, u32 size)
+{
+    const u8* pa = a;
+    const u8* pb = b;
+    const __m128i diff = _mm_or_si128(xorBytes16(pa, pb), xorBytes16(pa + size - 16, pb + size - 16));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) == 0xFFFF;
+}
+
+KERNELS_TARGET("sse2") static int bytesEqual33To64SSE2(const void* a, const void* b, u32 size)
+{
+    const u8* pa = a;
+    const u8* pb = b;
+    const __m128i diff = _mm_or_si128(_mm_or_si128(xorBytes16(pa, pb), xorBytes16(pa + 16, pb + 16)),
+        _mm_or_si128(xorBytes16(pa + size - 32, pb + size - 32), xorBytes16(pa + size - 16, pb + size - 16)));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) == 0xFFFF;
+}
+
+/* AVX2 */
+
+KERNELS_TARGET("avx2") static __m256 affineF32x8(__m256 v, __m256 diag, __m256 anti, __m256 offs, int linear)
+{
+    if (!linear)
+        return _mm256_add_ps(v, offs);
+    const __m256 s = _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(v, diag), _mm256_mul_ps(s, anti)), offs);
+}
+
+KERNELS_TARGET("avx2") static __m256d affineF64x4(__m256d v, __m256d diag, __m256d anti, __m256d offs, int linear)
+{
+    if (!linear)
+        return _mm256_add_pd(v, offs);
+    const __m256d s = _mm256_permute_pd(v, 0x5);
+    return _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(v, diag), _mm256_mul_pd(s, anti)), offs);
+}
+
+KERNELS_TARGET("avx2") static void affine2DF32AVX2(u8* p, u32 stride, u32 count, const struct Kernels_F32Affine* t)
+{
+    const f32* k = t->k;
+    const __m256 diag = _mm256_setr_ps(k[0], k[4], k[0], k[4], k[0], k[4], k[0], k[4]);
+    const __m256 anti = _mm256_setr_ps(k[1], k[3], k[1], k[3], k[1], k[3], k[1], k[3]);
+    const __m256 offs = _mm256_setr_ps(k[2], k[5], k[2], k[5], k[2], k[5], k[2], k[5]);
+    u32 i = 0;
+    if (stride == 2 * sizeof(f32))
+    {
+        for (; i + 8 <= count; i += 8, p += 8 * stride)
+        {
+            __m256 v0 = _mm256_loadu_ps((const f32*)p);
+            __m256 v1 = _mm256_loadu_ps((const f32*)p + 8);
+            _mm256_storeu_ps((f32*)p, affineF32x8(v0, diag, anti, offs, t->linear));
+            _mm256_storeu_ps((f32*)p + 8, affineF32x8(v1, diag, anti, offs, t->linear));
+        }
+    }
+    else
+    {
+        /*gathers the pairs of four vertices into one register*/
+        for (; i + 4 <= count; i += 4, p += 4 * stride)
+        {
+            __m128 lo = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p);
+            __m128 hi = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(p + 2 * stride));
+            lo = _mm_loadh_pi(lo, (const __m64*)(p + stride));
+            hi = _mm_loadh_pi(hi, (const __m64*)(p + 3 * stride));
+            __m256 v = affineF32x8(_mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1), diag, anti, offs, t->linear);
+            lo = _mm256_castps256_ps128(v);
+            hi = _mm256_extractf128_ps(v, 1);
+            _mm_storel_pi((__m64*)p, lo);
+            _mm_storeh_pi((__m64*)(p + stride), lo);
+            _mm_storel_pi((__m64*)(p + 2 * stride), hi);
+            _mm_storeh_pi((__m64*)(p + 3 * stride), hi);
+        }
+    }
+    affine2DF32SSE2(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("avx2") static void affine2DF64AVX2(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine* t)
+{
+    const f64* k = t->k;
+    const __m256d diag = _mm256_setr_pd(k[0], k[4], k[0], k[4]);
+    const __m256d anti = _mm256_setr_pd(k[1], k[3], k[1], k[3]);
+    const __m256d offs = _mm256_setr_pd(k[2], k[5], k[2], k[5]);
+    u32 i = 0;
+    if (stride == 2 * sizeof(f64))
+    {
+        for (; i + 4 <= count; i += 4, p += 4 * stride)
+        {
+            __m256d v0 = _mm256_loadu_pd((const f64*)p);
+            __m256d v1 = _mm256_loadu_pd((const f64*)p + 4);
+            _mm256_storeu_pd((f64*)p, affineF64x4(v0, diag, anti, offs, t->linear));
+            _mm256_storeu_pd((f64*)p + 4, affineF64x4(v1, diag, anti, offs, t->linear));
+        }
+    }
+    else
+    {
+        for (; i + 2 <= count; i += 2, p += 2 * stride)
+        {
+            __m128d lo = _mm_loadu_pd((const f64*)p);
+            __m128d hi = _mm_loadu_pd((const f64*)(p + stride));
+            __m256d v = affineF64x4(_mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1), diag, anti, offs, t->linear);
+            _mm_storeu_pd((f64*)p, _mm256_castpd256_pd128(v));
+            _mm_storeu_pd((f64*)(p + stride), _mm256_extractf128_pd(v, 1));
+        }
+    }
+    affine2DF64SSE2(p, stride, count - i, t);
+}
+
+/*adds the terms of two edges, a and b each hold two (x, y) pairs*/
+KERNELS_TARGET("avx2") static void shoelaceF64x4(__m256d a, __m256d b, int centroid, __m256d* crossAcc, __m256d* centroidAcc)
+{
+    const __m256d prod = _mm256_mul_pd(a, _mm256_permute_pd(b, 0x5));
+    *crossAcc = _mm256_add_pd(*crossAcc, prod);
+    if (centroid) {
+        /*(cross0, cross0, cross1, cross1)*/
+        const __m256d cross = _mm256_hsub_pd(prod, prod);
+        *centroidAcc = _mm256_add_pd(*centroidAcc, _mm256_mul_pd(_mm256_add_pd(a, b), cross));
+    }
+}
+
+KERNELS_TARGET("avx2") static void addShoelaceSumsAVX2(__m256d crossAcc, __m256d centroidAcc, f64 sums[3])
+{
+    f64 c[4], s[4];
+    _mm256_storeu_pd(c, crossAcc);
+    _mm256_storeu_pd(s, centroidAcc);
+    sums[0] += (c[0] - c[1]) + (c[2] - c[3]);
+    sums[1] += s[0] + s[2];
+    sums[2] += s[1] + s[3];
+}
+
+KERNELS_TARGET("avx2") static __m256d loadPairsF32x2(const u8* p, u32 stride)
+{
+    __m128 v;
+    if (stride == 2 * sizeof(f32)) {
+        v = _mm_loadu_ps((const f32*)p);
+    } else {
+        v = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p);
+        v = _mm_loadh_pi(v, (const __m64*)(p + stride));
+    }
+    return _mm256_cvtps_pd(v);
+}
+
+KERNELS_TARGET("avx2") static __m256d loadPairsF64x2(const u8* p, u32 stride)
+{
+    if (stride == 2 * sizeof(f64))
+        return _mm256_loadu_pd((const f64*)p);
+    return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd((const f64*)p)), _mm_loadu_pd((const f64*)(p + stride)), 1);
+}
+
+KERNELS_TARGET("avx2") static void shoelace2DF32AVX2(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3])
+{
+    __m256d crossAcc = _mm256_setzero_pd();
+    __m256d centroidAcc = _mm256_setzero_pd();
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2, p += 2 * stride)
+        shoelaceF64x4(loadPairsF32x2(p, stride), loadPairsF32x2(p + stride, stride), centroid, &crossAcc, &centroidAcc);
+    addShoelaceSumsAVX2(crossAcc, centroidAcc, sums);
+    shoelace2DF32SSE2(p, stride, count - i, centroid, sums);
+}
+
+KERNELS_TARGET("avx2") static void shoelace2DF64AVX2(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3])
+{
+    __m256d crossAcc = _mm256_setzero_pd();
+    __m256d centroidAcc = _mm256_setzero_pd();
+    u32 i = 0;
+    for (; i + 2 <= count; i += 2, p += 2 * stride)
+        shoelaceF64x4(loadPairsF64x2(p, stride), loadPairsF64x2(p + stride, stride), centroid, &crossAcc, &centroidAcc);
+    addShoelaceSumsAVX2(crossAcc, centroidAcc, sums);
+    shoelace2DF64SSE2(p, stride, count - i, centroid, sums);
+}
+
+KERNELS_TARGET("avx2") static void affine2DSoAF32AVX2(f32* x, f32* y, u32 count, const struct Kernels_F32Affine* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 px = _mm256_loadu_ps(x + i);
+        const __m256 py = _mm256_loadu_ps(y + i);
+        if (t->linear) {
+            _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[0])), _mm256_mul_ps(py, _mm256_set1_ps(k[1]))), _mm256_set1_ps(k[2])));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[3])), _mm256_mul_ps(py, _mm256_set1_ps(k[4]))), _mm256_set1_ps(k[5])));
+        } else {
+            _mm256_storeu_ps(x + i, _mm256_add_ps(px, _mm256_set1_ps(k[2])));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(py, _mm256_set1_ps(k[5])));
+        }
+    }
+    affine2DSoAF32SSE2(x + i, y + i, count - i, t);
+}
+
+KERNELS_TARGET("avx2") static void affine2DSoAF64AVX2(f64* x, f64* y, u32 count, const struct Kernels_F64Affine* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d px = _mm256_loadu_pd(x + i);
+        const __m256d py = _mm256_loadu_pd(y + i);
+        if (t->linear) {
+            _mm256_storeu_pd(x + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(k[0])), _mm256_mul_pd(py, _mm256_set1_pd(k[1]))), _mm256_set1_pd(k[2])));
+            _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(k[3])), _mm256_mul_pd(py, _mm256_set1_pd(k[4]))), _mm256_set1_pd(k[5])));
+        } else {
+            _mm256_storeu_pd(x + i, _mm256_add_pd(px, _mm256_set1_pd(k[2])));
+            _mm256_storeu_pd(y + i, _mm256_add_pd(py, _mm256_set1_pd(k[5])));
+        }
+    }
+    affine2DSoAF64SSE2(x + i, y + i, count - i, t);
+}
+
+/*adds the terms of four edges from deinterleaved positions*/
+KERNELS_TARGET("avx2") static void shoelaceSoAF64x4(__m256d ax, __m256d ay, __m256d bx, __m256d by, int centroid,
+    __m256d* crossAcc, __m256d* cxAcc, __m256d* cyAcc)
+{
+    const __m256d cross = _mm256_sub_pd(_mm256_mul_pd(ax, by), _mm256_mul_pd(bx, ay));
+    *crossAcc = _mm256_add_pd(*crossAcc, cross);
+    if (centroid) {
+        *cxAcc = _mm256_add_pd(*cxAcc, _mm256_mul_pd(_mm256_add_pd(ax, bx), cross));
+        *cyAcc = _mm256_add_pd(*cyAcc, _mm256_mul_pd(_mm256_add_pd(ay, by), cross));
+    }
+}
+
+KERNELS_TARGET("avx2") static void addShoelaceSoASumsAVX2(__m256d crossAcc, __m256d cxAcc, __m256d cyAcc, f64 sums[3])
+{
+    f64 c[4], sx[4], sy[4];
+    _mm256_storeu_pd(c, crossAcc);
+    _mm256_storeu_pd(sx, cxAcc);
+    _mm256_storeu_pd(sy, cyAcc);
+    sums[0] += (c[0] + c[1]) + (c[2] + c[3]);
+    sums[1] += (sx[0] + sx[1]) + (sx[2] + sx[3]);
+    sums[2] += (sy[0] + sy[1]) + (sy[2] + sy[3]);
+}
+
+KERNELS_TARGET("avx2") static void shoelace2DSoAF32AVX2(const f32* x, const f32* y, u32 count, int centroid, f64 sums[3])
+{
+    __m256d crossAcc = _mm256_setzero_pd();
+    __m256d cxAcc = _mm256_setzero_pd();
+    __m256d cyAcc = _mm256_setzero_pd();
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+        shoelaceSoAF64x4(_mm256_cvtps_pd(_mm_loadu_ps(x + i)), _mm256_cvtps_pd(_mm_loadu_ps(y + i)),
+            _mm256_cvtps_pd(_mm_loadu_ps(x + i + 1)), _mm256_cvtps_pd(_mm_loadu_ps(y + i + 1)), centroid, &crossAcc, &cxAcc, &cyAcc);
+    addShoelaceSoASumsAVX2(crossAcc, cxAcc, cyAcc, sums);
+    shoelace2DSoAF32SSE2(x + i, y + i, count - i, centroid, sums);
+}
+
+KERNELS_TARGET("avx2") static void shoelace2DSoAF64AVX2(const f64* x, const f64* y, u32 count, int centroid, f64 sums[3])
+{
+    __m256d crossAcc = _mm256_setzero_pd();
+    __m256d cxAcc = _mm256_setzero_pd();
+    __m256d cyAcc = _mm256_setzero_pd();
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+        shoelaceSoAF64x4(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i + 1), _mm256_loadu_pd(y + i + 1),
+            centroid, &crossAcc, &cxAcc, &cyAcc);
+    addShoelaceSoASumsAVX2(crossAcc, cxAcc, cyAcc, sums);
+    shoelace2DSoAF64SSE2(x + i, y + i, count - i, centroid, sums);
+}
+
+KERNELS_TARGET("avx2") static void streamCopyAVX2(u8* dst, const u8* src, size_t bytes)
+{
+    size_t head = (size_t)(-(intptr_t)dst & 31);
+    if (head > bytes)
+        head = bytes;
+    memcpy(dst, src, head);
+    size_t i = head;
+    for (; i + 32 <= bytes; i += 32)
+        _mm256_stream_si256((__m256i*)(dst + i), _mm256_loadu_si256((const __m256i*)(src + i)));
+    memcpy(dst + i, src + i, bytes - i);
+}
+
+/*every CPU with AVX2 also has F16C, which the AVX2 level requires*/
+KERNELS_TARGET("avx2,f16c") static void widenF16AVX2(const u16* in, f32* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+    widenF16Scalar(in + i, out + i, count - i);
+}
+
+KERNELS_TARGET("avx2,f16c") static void narrowF16AVX2(const f32* in, u16* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+    narrowF16Scalar(in + i, out + i, count - i);
+}
+
+KERNELS_TARGET("avx2") static void widenI16NormAVX2(const i16* in, f32* out, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(32767.0f);
+    const __m256 lo = _mm256_set1_ps(-1.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 v = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(in + i))));
+        _mm256_storeu_ps(out + i, _mm256_max_ps(_mm256_div_ps(v, scale), lo));
+    }
+    widenI16NormScalar(in + i, out + i, count - i);
+}
+
+KERNELS_TARGET("avx2") static void narrowI16NormAVX2(const f32* in, i16* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 v = _mm256_loadu_ps(in + i);
+        v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+        const __m256i n = _mm256_cvtps_epi32(_mm256_mul_ps(v, _mm256_set1_ps(32767.0f)));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(_mm256_castsi256_si128(n), _mm256_extracti128_si256(n, 1)));
+    }
+    narrowI16NormScalar(in + i, out + i, count - i);
+}
+
+KERNELS_TARGET("avx2") static void widenI32FixedAVX2(const i32* in, f64* out, size_t count)
+{
+    const __m256d scale = _mm256_set1_pd(1.0 / 65536.0);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(in + i))), scale));
+    widenI32FixedScalar(in + i, out + i, count - i);
+}
+
+KERNELS_TARGET("avx2") static void narrowI32FixedAVX2(const f64* in, i32* out, size_t count)
+{
+    const __m256d scale = _mm256_set1_pd(65536.0);
+    const __m256d lo = _mm256_set1_pd(-2147483648.0);
+    const __m256d hi = _mm256_set1_pd(2147483647.0);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d v = _mm256_min_pd(_mm256_max_pd(_mm256_mul_pd(_mm256_loadu_pd(in + i), scale), lo), hi);
+        _mm_storeu_si128((__m128i*)(out + i), _mm256_cvtpd_epi32(v));
+    }
+    narrowI32FixedScalar(in + i, out + i, count - i);
+}
+
+/*a single F32 vertex fills only three lanes of an SSE register, so the AVX2 level transforms interleaved F32 positions with the SSE2 kernel*/
+KERNELS_TARGET("avx2") static void affine3DF64AVX2(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine3D* t)
+{
+    const f64* k = t->k;
+    const __m256d c0 = _mm256_setr_pd(k[0], k[4], k[8], 0.0);
+    const __m256d c1 = _mm256_setr_pd(k[1], k[5], k[9], 0.0);
+    const __m256d c2 = _mm256_setr_pd(k[2], k[6], k[10], 0.0);
+    const __m256d c3 = _mm256_setr_pd(k[3], k[7], k[11], 0.0);
+    u32 i;
+    for (i = 0; i < count; ++i, p += stride)
+    {
+        f64* pos = (f64*)p;
+        __m256d r;
+        if (t->linear) {
+            r = _mm256_add_pd(_mm256_mul_pd(c0, _mm256_broadcast_sd(pos)), _mm256_mul_pd(c1, _mm256_broadcast_sd(pos + 1)));
+            r = _mm256_add_pd(_mm256_add_pd(r, _mm256_mul_pd(c2, _mm256_broadcast_sd(pos + 2))), c3);
+        } else {
+            r = _mm256_add_pd(_mm256_setr_pd(pos[0], pos[1], pos[2], 0.0), c3);
+        }
+        _mm_storeu_pd(pos, _mm256_castpd256_pd128(r));
+        _mm_store_sd(pos + 2, _mm256_extractf128_pd(r, 1));
+    }
+}
+
+KERNELS_TARGET("avx2") static void affine3DSoAF32AVX2(f32* x, f32* y, f32* z, u32 count, const struct Kernels_F32Affine3D* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 px = _mm256_loadu_ps(x + i);
+        const __m256 py = _mm256_loadu_ps(y + i);
+        const __m256 pz = _mm256_loadu_ps(z + i);
+        if (t->linear) {
+            _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[0])), _mm256_mul_ps(py, _mm256_set1_ps(k[1]))), _mm256_mul_ps(pz, _mm256_set1_ps(k[2]))), _mm256_set1_ps(k[3])));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[4])), _mm256_mul_ps(py, _mm256_set1_ps(k[5]))), _mm256_mul_ps(pz, _mm256_set1_ps(k[6]))), _mm256_set1_ps(k[7])));
+            _mm256_storeu_ps(z + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[8])), _mm256_mul_ps(py, _mm256_set1_ps(k[9]))), _mm256_mul_ps(pz, _mm256_set1_ps(k[10]))), _mm256_set1_ps(k[11])));
+        } else {
+            _mm256_storeu_ps(x + i, _mm256_add_ps(px, _mm256_set1_ps(k[3])));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(py, _mm256_set1_ps(k[7])));
+            _mm256_storeu_ps(z + i, _mm256_add_ps(pz, _mm256_set1_ps(k[11])));
+        }
+    }
+    affine3DSoAF32SSE2(x + i, y + i, z + i, count - i, t);
+}
+
+KERNELS_TARGET("avx2") static void affine3DSoAF64AVX2(f64* x, f64* y, f64* z, u32 count, const struct Kernels_F64Affine3D* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d px = _mm256_loadu_pd(x + i);
+        const __m256d py = _mm256_loadu_pd(y + i);
+        const __m256d pz = _mm256_loadu_pd(z + i);
+        if (t->linear) {
+            _mm256_storeu_pd(x + i, _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(k[0])), _mm256_mul_pd(py, _mm256_set1_pd(k[1]))), _mm256_mul_pd(pz, _mm256_set1_pd(k[2]))), _mm256_set1_pd(k[3])));
+            _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(k[4])), _mm256_mul_pd(py, _mm256_set1_pd(k[5]))), _mm256_mul_pd(pz, _mm256_set1_pd(k[6]))), _mm256_set1_pd(k[7])));
+            _mm256_storeu_pd(z + i, _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(k[8])), _mm256_mul_pd(py, _mm256_set1_pd(k[9]))), _mm256_mul_pd(pz, _mm256_set1_pd(k[10]))), _mm256_set1_pd(k[11])));
+        } else {
+            _mm256_storeu_pd(x + i, _mm256_add_pd(px, _mm256_set1_pd(k[3])));
+            _mm256_storeu_pd(y + i, _mm256_add_pd(py, _mm256_set1_pd(k[7])));
+            _mm256_storeu_pd(z + i, _mm256_add_pd(pz, _mm256_set1_pd(k[11])));
+        }
+    }
+    affine3DSoAF64SSE2(x + i, y + i, z + i, count - i, t);
+}
+
+struct Kernels_F32x8Homography { __m256 diag, anti, offs, wDiag, wAnti, wOffs; };
+struct Kernels_F64x4Homography { __m256d diag, anti, offs, wDiag, wAnti, wOffs; };
+
+KERNELS_TARGET("avx2") static struct Kernels_F32x8Homography homographyF32x8Coefficients(const f32* k)
+{
+    struct Kernels_F32x8Homography c;
+    c.diag = _mm256_setr_ps(k[0], k[4], k[0], k[4], k[0], k[4], k[0], k[4]);
+    c.anti = _mm256_setr_ps(k[1], k[3], k[1], k[3], k[1], k[3], k[1], k[3]);
+    c.offs = _mm256_setr_ps(k[2], k[5], k[2], k[5], k[2], k[5], k[2], k[5]);
+    c.wDiag = _mm256_setr_ps(k[6], k[7], k[6], k[7], k[6], k[7], k[6], k[7]);
+    c.wAnti = _mm256_setr_ps(k[7], k[6], k[7], k[6], k[7], k[6], k[7], k[6]);
+    c.wOffs = _mm256_set1_ps(k[8]);
+    return c;
+}
+
+KERNELS_TARGET("avx2") static struct Kernels_F64x4Homography homographyF64x4Coefficients(const f64* k)
+{
+    struct Kernels_F64x4Homography c;
+    c.diag = _mm256_setr_pd(k[0], k[4], k[0], k[4]);
+    c.anti = _mm256_setr_pd(k[1], k[3], k[1], k[3]);
+    c.offs = _mm256_setr_pd(k[2], k[5], k[2], k[5]);
+    c.wDiag = _mm256_setr_pd(k[6], k[7], k[6], k[7]);
+    c.wAnti = _mm256_setr_pd(k[7], k[6], k[7], k[6]);
+    c.wOffs = _mm256_set1_pd(k[8]);
+    return c;
+}
+
+KERNELS_TARGET("avx2") static __m256 homographyF32x8(__m256 v, const struct Kernels_F32x8Homography* c)
+{
+    const __m256 s = _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+    const __m256 num = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(v, c->diag), _mm256_mul_ps(s, c->anti)), c->offs);
+    const __m256 w = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(v, c->wDiag), _mm256_mul_ps(s, c->wAnti)), c->wOffs);
+    return _mm256_mul_ps(num, _mm256_div_ps(_mm256_set1_ps(1.0f), w));
+}
+
+KERNELS_TARGET("avx2") static __m256d homographyF64x4(__m256d v, const struct Kernels_F64x4Homography* c)
+{
+    const __m256d s = _mm256_permute_pd(v, 0x5);
+    const __m256d num = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(v, c->diag), _mm256_mul_pd(s, c->anti)), c->offs);
+    const __m256d w = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(v, c->wDiag), _mm256_mul_pd(s, c->wAnti)), c->wOffs);
+    return _mm256_mul_pd(num, _mm256_div_pd(_mm256_set1_pd(1.0), w));
+}
+
+KERNELS_TARGET("avx2") static void homography2DF32AVX2(u8* p, u32 stride, u32 count, const struct Kernels_F32Homography* t)
+{
+    const struct Kernels_F32x8Homography c = homographyF32x8Coefficients(t->k);
+    u32 i = 0;
+    if (stride == 2 * sizeof(f32))
+    {
+        for (; i + 8 <= count; i += 8, p += 8 * stride)
+        {
+            __m256 v0 = _mm256_loadu_ps((const f32*)p);
+            __m256 v1 = _mm256_loadu_ps((const f32*)p + 8);
+            _mm256_storeu_ps((f32*)p, homographyF32x8(v0, &c));
+            _mm256_storeu_ps((f32*)p + 8, homographyF32x8(v1, &c));
+        }
+    }
+    else
+    {
+        for (; i + 4 <= count; i += 4, p += 4 * stride)
+        {
+            __m128 lo = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p);
+            __m128 hi = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(p + 2 * stride));
+            lo = _mm_loadh_pi(lo, (const __m64*)(p + stride));
+            hi = _mm_loadh_pi(hi, (const __m64*)(p + 3 * stride));
+            __m256 v = homographyF32x8(_mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1), &c);
+            lo = _mm256_castps256_ps128(v);
+            hi = _mm256_extractf128_ps(v, 1);
+            _mm_storel_pi((__m64*)p, lo);
+            _mm_storeh_pi((__m64*)(p + stride), lo);
+            _mm_storel_pi((__m64*)(p + 2 * stride), hi);
+            _mm_storeh_pi((__m64*)(p + 3 * stride), hi);
+        }
+    }
+    homography2DF32SSE2(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("avx2") static void homography2DF64AVX2(u8* p, u32 stride, u32 count, const struct Kernels_F64Homography* t)
+{
+    const struct Kernels_F64x4Homography c = homographyF64x4Coefficients(t->k);
+    u32 i = 0;
+    if (stride == 2 * sizeof(f64))
+    {
+        for (; i + 4 <= count; i += 4, p += 4 * stride)
+        {
+            __m256d v0 = _mm256_loadu_pd((const f64*)p);
+            __m256d v1 = _mm256_loadu_pd((const f64*)p + 4);
+            _mm256_storeu_pd((f64*)p, homographyF64x4(v0, &c));
+            _mm256_storeu_pd((f64*)p + 4, homographyF64x4(v1, &c));
+        }
+    }
+    else
+    {
+        for (; i + 2 <= count; i += 2, p += 2 * stride)
+        {
+            __m128d lo = _mm_loadu_pd((const f64*)p);
+            __m128d hi = _mm_loadu_pd((const f64*)(p + stride));
+            __m256d v = homographyF64x4(_mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1), &c);
+            _mm_storeu_pd((f64*)p, _mm256_castpd256_pd128(v));
+            _mm_storeu_pd((f64*)(p + stride), _mm256_extractf128_pd(v, 1));
+        }
+    }
+    homography2DF64SSE2(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("avx2") static void homography2DSoAF32AVX2(f32* x, f32* y, u32 count, const struct Kernels_F32Homography* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 px = _mm256_loadu_ps(x + i);
+        const __m256 py = _mm256_loadu_ps(y + i);
+        const __m256 w = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[6])), _mm256_mul_ps(py, _mm256_set1_ps(k[7]))), _mm256_set1_ps(k[8]));
+        const __m256 r = _mm256_div_ps(_mm256_set1_ps(1.0f), w);
+        _mm256_storeu_ps(x + i, _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[0])), _mm256_mul_ps(py, _mm256_set1_ps(k[1]))), _mm256_set1_ps(k[2])), r));
+        _mm256_storeu_ps(y + i, _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[3])), _mm256_mul_ps(py, _mm256_set1_ps(k[4]))), _mm256_set1_ps(k[5])), r));
+    }
+    homography2DSoAF32SSE2(x + i, y + i, count - i, t);
+}
+
+KERNELS_TARGET("avx2") static void homography2DSoAF64AVX2(f64* x, f64* y, u32 count, const struct Kernels_F64Homography* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d px = _mm256_loadu_pd(x + i);
+        const __m256d py = _mm256_loadu_pd(y + i);
+        const __m256d w = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(k[6])), _mm256_mul_pd(py, _mm256_set1_pd(k[7]))), _mm256_set1_pd(k[8]));
+        const __m256d r = _mm256_div_pd(_mm256_set1_pd(1.0), w);
+        _mm256_storeu_pd(x + i, _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(k[0])), _mm256_mul_pd(py, _mm256_set1_pd(k[1]))), _mm256_set1_pd(k[2])), r));
+        _mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(k[3])), _mm256_mul_pd(py, _mm256_set1_pd(k[4]))), _mm256_set1_pd(k[5])), r));
+    }
+    homography2DSoAF64SSE2(x + i, y + i, count - i, t);
+}
+
+KERNELS_TARGET("avx2") static int bytesEqual33To64AVX2(const void* a, const void* b, u32 size)
+{
+    const u8* pa = a;
+    const u8* pb = b;
+    const __m256i diff = _mm256_or_si256(
+        _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)pa), _mm256_loadu_si256((const __m256i*)pb)),
+        _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(pa + size - 32)), _mm256_loadu_si256((const __m256i*)(pb + size - 32))));
+    return _mm256_testz_si256(diff, diff);
+}
+
+/* AVX-512: packed positions use the pair layout, strided positions are gathered into x and y registers and scattered back */
+
+KERNELS_TARGET("avx512f") static __m512i strideOffsets8(u32 stride)
+{
+    const i64 s = (i64)stride;
+    return _mm512_setr_epi64(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+}
+
+KERNELS_TARGET("avx512f") static void affine2DF32AVX512(u8* p, u32 stride, u32 count, const struct Kernels_F32Affine* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    if (stride == 2 * sizeof(f32))
+    {
+        const __m512 diag = _mm512_setr4_ps(k[0], k[4], k[0], k[4]);
+        const __m512 anti = _mm512_setr4_ps(k[1], k[3], k[1], k[3]);
+        const __m512 offs = _mm512_setr4_ps(k[2], k[5], k[2], k[5]);
+        for (; i + 8 <= count; i += 8, p += 8 * stride)
+        {
+            __m512 v = _mm512_loadu_ps(p);
+            if (t->linear) {
+                const __m512 s = _mm512_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+                v = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(v, diag), _mm512_mul_ps(s, anti)), offs);
+            } else {
+                v = _mm512_add_ps(v, offs);
+            }
+            _mm512_storeu_ps(p, v);
+        }
+    }
+    else
+    {
+        const __m512i offsets = strideOffsets8(stride);
+        for (; i + 8 <= count; i += 8, p += 8 * stride)
+        {
+            const __m256 x = _mm512_i64gather_ps(offsets, p, 1);
+            const __m256 y = _mm512_i64gather_ps(offsets, p + sizeof(f32), 1);
+            __m256 rx, ry;
+            if (t->linear) {
+                rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(k[0])), _mm256_mul_ps(y, _mm256_set1_ps(k[1]))), _mm256_set1_ps(k[2]));
+                ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(k[3])), _mm256_mul_ps(y, _mm256_set1_ps(k[4]))), _mm256_set1_ps(k[5]));
+            } else {
+                rx = _mm256_add_ps(x, _mm256_set1_ps(k[2]));
+                ry = _mm256_add_ps(y, _mm256_set1_ps(k[5]));
+            }
+            _mm512_i64scatter_ps(p, offsets, rx, 1);
+            _mm512_i64scatter_ps(p + sizeof(f32), offsets, ry, 1);
+        }
+    }
+    affine2DF32AVX2(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void affine2DF64AVX512(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    if (stride == 2 * sizeof(f64))
+    {
+        const __m512d diag = _mm512_setr4_pd(k[0], k[4], k[0], k[4]);
+        const __m512d anti = _mm512_setr4_pd(k[1], k[3], k[1], k[3]);
+        const __m512d offs = _mm512_setr4_pd(k[2], k[5], k[2], k[5]);
+        for (; i + 4 <= count; i += 4, p += 4 * stride)
+        {
+            __m512d v = _mm512_loadu_pd(p);
+            if (t->linear) {
+                const __m512d s = _mm512_permute_pd(v, 0x55);
+                v = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(v, diag), _mm512_mul_pd(s, anti)), offs);
+            } else {
+                v = _mm512_add_pd(v, offs);
+            }
+            _mm512_storeu_pd(p, v);
+        }
+    }
+    else
+    {
+        const __m512i offsets = strideOffsets8(stride);
+        for (; i + 8 <= count; i += 8, p += 8 * stride)
+        {
+            const __m512d x = _mm512_i64gather_pd(offsets, p, 1);
+            const __m512d y = _mm512_i64gather_pd(offsets, p + sizeof(f64), 1);
+            __m512d rx, ry;
+            if (t->linear) {
+                rx = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(x, _mm512_set1_pd(k[0])), _mm512_mul_pd(y, _mm512_set1_pd(k[1]))), _mm512_set1_pd(k[2]));
+                ry = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(x, _mm512_set1_pd(k[3])), _mm512_mul_pd(y, _mm512_set1_pd(k[4]))), _mm512_set1_pd(k[5]));
+            } else {
+                rx = _mm512_add_pd(x, _mm512_set1_pd(k[2]));
+                ry = _mm512_add_pd(y, _mm512_set1_pd(k[5]));
+            }
+            _mm512_i64scatter_pd(p, offsets, rx, 1);
+            _mm512_i64scatter_pd(p + sizeof(f64), offsets, ry, 1);
+        }
+    }
+    affine2DF64AVX2(p, stride, count - i, t);
+}
+
+/*adds the terms of eight edges from deinterleaved positions*/
+KERNELS_TARGET("avx512f") static void shoelaceF64x8(__m512d ax, __m512d ay, __m512d bx, __m512d by, int centroid,
+    __m512d* crossAcc, __m512d* cxAcc, __m512d* cyAcc)
+{
+    const __m512d cross = _mm512_sub_pd(_mm512_mul_pd(ax, by), _mm512_mul_pd(bx, ay));
+    *crossAcc = _mm512_add_pd(*crossAcc, cross);
+    if (centroid) {
+        *cxAcc = _mm512_add_pd(*cxAcc, _mm512_mul_pd(_mm512_add_pd(ax, bx), cross));
+        *cyAcc = _mm512_add_pd(*cyAcc, _mm512_mul_pd(_mm512_add_pd(ay, by), cross));
+    }
+}
+
+KERNELS_TARGET("avx512f") static void shoelace2DF32AVX512(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3])
+{
+    const __m512i offsets = strideOffsets8(stride);
+    __m512d crossAcc = _mm512_setzero_pd();
+    __m512d cxAcc = _mm512_setzero_pd();
+    __m512d cyAcc = _mm512_setzero_pd();
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8, p += 8 * stride)
+    {
+        const __m512d ax = _mm512_cvtps_pd(_mm512_i64gather_ps(offsets, p, 1));
+        const __m512d ay = _mm512_cvtps_pd(_mm512_i64gather_ps(offsets, p + sizeof(f32), 1));
+        const __m512d bx = _mm512_cvtps_pd(_mm512_i64gather_ps(offsets, p + stride, 1));
+        const __m512d by = _mm512_cvtps_pd(_mm512_i64gather_ps(offsets, p + stride + sizeof(f32), 1));
+        shoelaceF64x8(ax, ay, bx, by, centroid, &crossAcc, &cxAcc, &cyAcc);
+    }
+    sums[0] += _mm512_reduce_add_pd(crossAcc);
+    sums[1] += _mm512_reduce_add_pd(cxAcc);
+    sums[2] += _mm512_reduce_add_pd(cyAcc);
+    shoelace2DF32AVX2(p, stride, count - i, centroid, sums);
+}
+
+KERNELS_TARGET("avx512f") static void shoelace2DF64AVX512(const u8* p, u32 stride, u32 count, int centroid, f64 sums[3])
+{
+    const __m512i offsets = strideOffsets8(stride);
+    __m512d crossAcc = _mm512_setzero_pd();
+    __m512d cxAcc = _mm512_setzero_pd();
+    __m512d cyAcc = _mm512_setzero_pd();
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8, p += 8 * stride)
+    {
+        const __m512d ax = _mm512_i64gather_pd(offsets, p, 1);
+        const __m512d ay = _mm512_i64gather_pd(offsets, p + sizeof(f64), 1);
+        const __m512d bx = _mm512_i64gather_pd(offsets, p + stride, 1);
+        const __m512d by = _mm512_i64gather_pd(offsets, p + stride + sizeof(f64), 1);
+        shoelaceF64x8(ax, ay, bx, by, centroid, &crossAcc, &cxAcc, &cyAcc);
+    }
+    sums[0] += _mm512_reduce_add_pd(crossAcc);
+    sums[1] += _mm512_reduce_add_pd(cxAcc);
+    sums[2] += _mm512_reduce_add_pd(cyAcc);
+    shoelace2DF64AVX2(p, stride, count - i, centroid, sums);
+}
+
+KERNELS_TARGET("avx512f") static void affine2DSoAF32AVX512(f32* x, f32* y, u32 count, const struct Kernels_F32Affine* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m512 px = _mm512_loadu_ps(x + i);
+        const __m512 py = _mm512_loadu_ps(y + i);
+        if (t->linear) {
+            _mm512_storeu_ps(x + i, _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, _mm512_set1_ps(k[0])), _mm512_mul_ps(py, _mm512_set1_ps(k[1]))), _mm512_set1_ps(k[2])));
+            _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, _mm512_set1_ps(k[3])), _mm512_mul_ps(py, _mm512_set1_ps(k[4]))), _mm512_set1_ps(k[5])));
+        } else {
+            _mm512_storeu_ps(x + i, _mm512_add_ps(px, _mm512_set1_ps(k[2])));
+            _mm512_storeu_ps(y + i, _mm512_add_ps(py, _mm512_set1_ps(k[5])));
+        }
+    }
+    affine2DSoAF32AVX2(x + i, y + i, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void affine2DSoAF64AVX512(f64* x, f64* y, u32 count, const struct Kernels_F64Affine* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m512d px = _mm512_loadu_pd(x + i);
+        const __m512d py = _mm512_loadu_pd(y + i);
+        if (t->linear) {
+            _mm512_storeu_pd(x + i, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(px, _mm512_set1_pd(k[0])), _mm512_mul_pd(py, _mm512_set1_pd(k[1]))), _mm512_set1_pd(k[2])));
+            _mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(px, _mm512_set1_pd(k[3])), _mm512_mul_pd(py, _mm512_set1_pd(k[4]))), _mm512_set1_pd(k[5])));
+        } else {
+            _mm512_storeu_pd(x + i, _mm512_add_pd(px, _mm512_set1_pd(k[2])));
+            _mm512_storeu_pd(y + i, _mm512_add_pd(py, _mm512_set1_pd(k[5])));
+        }
+    }
+    affine2DSoAF64AVX2(x + i, y + i, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void shoelace2DSoAF32AVX512(const f32* x, const f32* y, u32 count, int centroid, f64 sums[3])
+{
+    __m512d crossAcc = _mm512_setzero_pd();
+    __m512d cxAcc = _mm512_setzero_pd();
+    __m512d cyAcc = _mm512_setzero_pd();
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+        shoelaceF64x8(_mm512_cvtps_pd(_mm256_loadu_ps(x + i)), _mm512_cvtps_pd(_mm256_loadu_ps(y + i)),
+            _mm512_cvtps_pd(_mm256_loadu_ps(x + i + 1)), _mm512_cvtps_pd(_mm256_loadu_ps(y + i + 1)), centroid, &crossAcc, &cxAcc, &cyAcc);
+    sums[0] += _mm512_reduce_add_pd(crossAcc);
+    sums[1] += _mm512_reduce_add_pd(cxAcc);
+    sums[2] += _mm512_reduce_add_pd(cyAcc);
+    shoelace2DSoAF32AVX2(x + i, y + i, count - i, centroid, sums);
+}
+
+KERNELS_TARGET("avx512f") static void shoelace2DSoAF64AVX512(const f64* x, const f64* y, u32 count, int centroid, f64 sums[3])
+{
+    __m512d crossAcc = _mm512_setzero_pd();
+    __m512d cxAcc = _mm512_setzero_pd();
+    __m512d cyAcc = _mm512_setzero_pd();
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+        shoelaceF64x8(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), _mm512_loadu_pd(x + i + 1), _mm512_loadu_pd(y + i + 1),
+            centroid, &crossAcc, &cxAcc, &cyAcc);
+    sums[0] += _mm512_reduce_add_pd(crossAcc);
+    sums[1] += _mm512_reduce_add_pd(cxAcc);
+    sums[2] += _mm512_reduce_add_pd(cyAcc);
+    shoelace2DSoAF64AVX2(x + i, y + i, count - i, centroid, sums);
+}
+
+KERNELS_TARGET("avx512f") static void streamCopyAVX512(u8* dst, const u8* src, size_t bytes)
+{
+    size_t head = (size_t)(-(intptr_t)dst & 63);
+    if (head > bytes)
+        head = bytes;
+    memcpy(dst, src, head);
+    size_t i = head;
+    for (; i + 64 <= bytes; i += 64)
+        _mm512_stream_si512((void*)(dst + i), _mm512_loadu_si512((const void*)(src + i)));
+    memcpy(dst + i, src + i, bytes - i);
+}
+
+/*transforms the x, y and z registers of eight vertices in place*/
+KERNELS_TARGET("avx512f") static void affine3DF32x8(__m256* x, __m256* y, __m256* z, const struct Kernels_F32Affine3D* t)
+{
+    const f32* k = t->k;
+    if (!t->linear) {
+        *x = _mm256_add_ps(*x, _mm256_set1_ps(k[3]));
+        *y = _mm256_add_ps(*y, _mm256_set1_ps(k[7]));
+        *z = _mm256_add_ps(*z, _mm256_set1_ps(k[11]));
+        return;
+    }
+    const __m256 px = *x, py = *y, pz = *z;
+    *x = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[0])), _mm256_mul_ps(py, _mm256_set1_ps(k[1]))), _mm256_mul_ps(pz, _mm256_set1_ps(k[2]))), _mm256_set1_ps(k[3]));
+    *y = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[4])), _mm256_mul_ps(py, _mm256_set1_ps(k[5]))), _mm256_mul_ps(pz, _mm256_set1_ps(k[6]))), _mm256_set1_ps(k[7]));
+    *z = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(k[8])), _mm256_mul_ps(py, _mm256_set1_ps(k[9]))), _mm256_mul_ps(pz, _mm256_set1_ps(k[10]))), _mm256_set1_ps(k[11]));
+}
+
+KERNELS_TARGET("avx512f") static void affine3DF64x8(__m512d* x, __m512d* y, __m512d* z, const struct Kernels_F64Affine3D* t)
+{
+    const f64* k = t->k;
+    if (!t->linear) {
+        *x = _mm512_add_pd(*x, _mm512_set1_pd(k[3]));
+        *y = _mm512_add_pd(*y, _mm512_set1_pd(k[7]));
+        *z = _mm512_add_pd(*z, _mm512_set1_pd(k[11]));
+        return;
+    }
+    const __m512d px = *x, py = *y, pz = *z;
+    *x = _mm512_add_pd(_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(px, _mm512_set1_pd(k[0])), _mm512_mul_pd(py, _mm512_set1_pd(k[1]))), _mm512_mul_pd(pz, _mm512_set1_pd(k[2]))), _mm512_set1_pd(k[3]));
+    *y = _mm512_add_pd(_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(px, _mm512_set1_pd(k[4])), _mm512_mul_pd(py, _mm512_set1_pd(k[5]))), _mm512_mul_pd(pz, _mm512_set1_pd(k[6]))), _mm512_set1_pd(k[7]));
+    *z = _mm512_add_pd(_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(px, _mm512_set1_pd(k[8])), _mm512_mul_pd(py, _mm512_set1_pd(k[9]))), _mm512_mul_pd(pz, _mm512_set1_pd(k[10]))), _mm512_set1_pd(k[11]));
+}
+
+KERNELS_TARGET("avx512f") static void affine3DF32AVX512(u8* p, u32 stride, u32 count, const struct Kernels_F32Affine3D* t)
+{
+    const __m512i offsets = strideOffsets8(stride);
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8, p += 8 * stride)
+    {
+        __m256 x = _mm512_i64gather_ps(offsets, p, 1);
+        __m256 y = _mm512_i64gather_ps(offsets, p + sizeof(f32), 1);
+        __m256 z = _mm512_i64gather_ps(offsets, p + 2 * sizeof(f32), 1);
+        affine3DF32x8(&x, &y, &z, t);
+        _mm512_i64scatter_ps(p, offsets, x, 1);
+        _mm512_i64scatter_ps(p + sizeof(f32), offsets, y, 1);
+        _mm512_i64scatter_ps(p + 2 * sizeof(f32), offsets, z, 1);
+    }
+    affine3DF32SSE2(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void affine3DF64AVX512(u8* p, u32 stride, u32 count, const struct Kernels_F64Affine3D* t)
+{
+    const __m512i offsets = strideOffsets8(stride);
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8, p += 8 * stride)
+    {
+        __m512d x = _mm512_i64gather_pd(offsets, p, 1);
+        __m512d y = _mm512_i64gather_pd(offsets, p + sizeof(f64), 1);
+        __m512d z = _mm512_i64gather_pd(offsets, p + 2 * sizeof(f64), 1);
+        affine3DF64x8(&x, &y, &z, t);
+        _mm512_i64scatter_pd(p, offsets, x, 1);
+        _mm512_i64scatter_pd(p + sizeof(f64), offsets, y, 1);
+        _mm512_i64scatter_pd(p + 2 * sizeof(f64), offsets, z, 1);
+    }
+    affine3DF64AVX2(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void affine3DSoAF32AVX512(f32* x, f32* y, f32* z, u32 count, const struct Kernels_F32Affine3D* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m512 px = _mm512_loadu_ps(x + i);
+        const __m512 py = _mm512_loadu_ps(y + i);
+        const __m512 pz = _mm512_loadu_ps(z + i);
+        if (t->linear) {
+            _mm512_storeu_ps(x + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, _mm512_set1_ps(k[0])), _mm512_mul_ps(py, _mm512_set1_ps(k[1]))), _mm512_mul_ps(pz, _mm512_set1_ps(k[2]))), _mm512_set1_ps(k[3])));
+            _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, _mm512_set1_ps(k[4])), _mm512_mul_ps(py, _mm512_set1_ps(k[5]))), _mm512_mul_ps(pz, _mm512_set1_ps(k[6]))), _mm512_set1_ps(k[7])));
+            _mm512_storeu_ps(z + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, _mm512_set1_ps(k[8])), _mm512_mul_ps(py, _mm512_set1_ps(k[9]))), _mm512_mul_ps(pz, _mm512_set1_ps(k[10]))), _mm512_set1_ps(k[11])));
+        } else {
+            _mm512_storeu_ps(x + i, _mm512_add_ps(px, _mm512_set1_ps(k[3])));
+            _mm512_storeu_ps(y + i, _mm512_add_ps(py, _mm512_set1_ps(k[7])));
+            _mm512_storeu_ps(z + i, _mm512_add_ps(pz, _mm512_set1_ps(k[11])));
+        }
+    }
+    affine3DSoAF32AVX2(x + i, y + i, z + i, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void affine3DSoAF64AVX512(f64* x, f64* y, f64* z, u32 count, const struct Kernels_F64Affine3D* t)
+{
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d px = _mm512_loadu_pd(x + i);
+        __m512d py = _mm512_loadu_pd(y + i);
+        __m512d pz = _mm512_loadu_pd(z + i);
+        affine3DF64x8(&px, &py, &pz, t);
+        _mm512_storeu_pd(x + i, px);
+        _mm512_storeu_pd(y + i, py);
+        _mm512_storeu_pd(z + i, pz);
+    }
+    affine3DSoAF64AVX2(x + i, y + i, z + i, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void homography2DF32AVX512(u8* p, u32 stride, u32 count, const struct Kernels_F32Homography* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    if (stride == 2 * sizeof(f32))
+    {
+        const __m512 diag = _mm512_setr4_ps(k[0], k[4], k[0], k[4]);
+        const __m512 anti = _mm512_setr4_ps(k[1], k[3], k[1], k[3]);
+        const __m512 offs = _mm512_setr4_ps(k[2], k[5], k[2], k[5]);
+        const __m512 wDiag = _mm512_setr4_ps(k[6], k[7], k[6], k[7]);
+        const __m512 wAnti = _mm512_setr4_ps(k[7], k[6], k[7], k[6]);
+        for (; i + 8 <= count; i += 8, p += 8 * stride)
+        {
+            const __m512 v = _mm512_loadu_ps(p);
+            const __m512 s = _mm512_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m512 num = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(v, diag), _mm512_mul_ps(s, anti)), offs);
+            const __m512 w = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(v, wDiag), _mm512_mul_ps(s, wAnti)), _mm512_set1_ps(k[8]));
+            _mm512_storeu_ps(p, _mm512_mul_ps(num, _mm512_div_ps(_mm512_set1_ps(1.0f), w)));
+        }
+    }
+    else
+    {
+        const __m512i offsets = strideOffsets8(stride);
+        for (; i + 8 <= count; i += 8, p += 8 * stride)
+        {
+            const __m256 x = _mm512_i64gather_ps(offsets, p, 1);
+            const __m256 y = _mm512_i64gather_ps(offsets, p + sizeof(f32), 1);
+            const __m256 w = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(k[6])), _mm256_mul_ps(y, _mm256_set1_ps(k[7]))), _mm256_set1_ps(k[8]));
+            const __m256 r = _mm256_div_ps(_mm256_set1_ps(1.0f), w);
+            const __m256 rx = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(k[0])), _mm256_mul_ps(y, _mm256_set1_ps(k[1]))), _mm256_set1_ps(k[2])), r);
+            const __m256 ry = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(k[3])), _mm256_mul_ps(y, _mm256_set1_ps(k[4]))), _mm256_set1_ps(k[5])), r);
+            _mm512_i64scatter_ps(p, offsets, rx, 1);
+            _mm512_i64scatter_ps(p + sizeof(f32), offsets, ry, 1);
+        }
+    }
+    homography2DF32AVX2(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void homography2DF64AVX512(u8* p, u32 stride, u32 count, const struct Kernels_F64Homography* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    if (stride == 2 * sizeof(f64))
+    {
+        const __m512d diag = _mm512_setr4_pd(k[0], k[4], k[0], k[4]);
+        const __m512d anti = _mm512_setr4_pd(k[1], k[3], k[1], k[3]);
+        const __m512d offs = _mm512_setr4_pd(k[2], k[5], k[2], k[5]);
+        const __m512d wDiag = _mm512_setr4_pd(k[6], k[7], k[6], k[7]);
+        const __m512d wAnti = _mm512_setr4_pd(k[7], k[6], k[7], k[6]);
+        for (; i + 4 <= count; i += 4, p += 4 * stride)
+        {
+            const __m512d v = _mm512_loadu_pd(p);
+            const __m512d s = _mm512_permute_pd(v, 0x55);
+            const __m512d num = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(v, diag), _mm512_mul_pd(s, anti)), offs);
+            const __m512d w = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(v, wDiag), _mm512_mul_pd(s, wAnti)), _mm512_set1_pd(k[8]));
+            _mm512_storeu_pd(p, _mm512_mul_pd(num, _mm512_div_pd(_mm512_set1_pd(1.0), w)));
+        }
+    }
+    else
+    {
+        const __m512i offsets = strideOffsets8(stride);
+        for (; i + 8 <= count; i += 8, p += 8 * stride)
+        {
+            const __m512d x = _mm512_i64gather_pd(offsets, p, 1);
+            const __m512d y = _mm512_i64gather_pd(offsets, p + sizeof(f64), 1);
+            const __m512d w = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(x, _mm512_set1_pd(k[6])), _mm512_mul_pd(y, _mm512_set1_pd(k[7]))), _mm512_set1_pd(k[8]));
+            const __m512d r = _mm512_div_pd(_mm512_set1_pd(1.0), w);
+            const __m512d rx = _mm512_mul_pd(_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(x, _mm512_set1_pd(k[0])), _mm512_mul_pd(y, _mm512_set1_pd(k[1]))), _mm512_set1_pd(k[2])), r);
+            const __m512d ry = _mm512_mul_pd(_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(x, _mm512_set1_pd(k[3])), _mm512_mul_pd(y, _mm512_set1_pd(k[4]))), _mm512_set1_pd(k[5])), r);
+            _mm512_i64scatter_pd(p, offsets, rx, 1);
+            _mm512_i64scatter_pd(p + sizeof(f64), offsets, ry, 1);
+        }
+    }
+    homography2DF64AVX2(p, stride, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void homography2DSoAF32AVX512(f32* x, f32* y, u32 count, const struct Kernels_F32Homography* t)
+{
+    const f32* k = t->k;
+    u32 i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m512 px = _mm512_loadu_ps(x + i);
+        const __m512 py = _mm512_loadu_ps(y + i);
+        const __m512 w = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, _mm512_set1_ps(k[6])), _mm512_mul_ps(py, _mm512_set1_ps(k[7]))), _mm512_set1_ps(k[8]));
+        const __m512 r = _mm512_div_ps(_mm512_set1_ps(1.0f), w);
+        _mm512_storeu_ps(x + i, _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, _mm512_set1_ps(k[0])), _mm512_mul_ps(py, _mm512_set1_ps(k[1]))), _mm512_set1_ps(k[2])), r));
+        _mm512_storeu_ps(y + i, _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(px, _mm512_set1_ps(k[3])), _mm512_mul_ps(py, _mm512_set1_ps(k[4]))), _mm512_set1_ps(k[5])), r));
+    }
+    homography2DSoAF32AVX2(x + i, y + i, count - i, t);
+}
+
+KERNELS_TARGET("avx512f") static void homography2DSoAF64AVX512(f64* x, f64* y, u32 count, const struct Kernels_F64Homography* t)
+{
+    const f64* k = t->k;
+    u32 i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m512d px = _mm512_loadu_pd(x + i);
+        const __m512d py = _mm512_loadu_pd(y + i);
+        const __m512d w = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(px, _mm512_set1_pd(k[6])), _mm512_mul_pd(py, _mm512_set1_pd(k[7]))), _mm512_set1_pd(k[8]));
+        const __m512d r = _mm512_div_pd(_mm512_set1_pd(1.0), w);
+        _mm512_storeu_pd(x + i, _mm512_mul_pd(_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(px, _mm512_set1_pd(k[0])), _mm512_mul_pd(py, _mm512_set1_pd(k[1]))), _mm512_set1_pd(k[2])), r));
+        _mm512_storeu_pd(y + i, _mm512_mul_pd(_mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(px, _mm512_set1_pd(k[3])), _mm512_mul_pd(py, _mm512_set1_pd(k[4]))), _mm512_set1_pd(k[5])), r));
+    }
+    homography2DSoAF64AVX2(x + i, y + i, count - i, t);
+}
+
+static enum SVTL_SimdLevel detectSimdLevel(void)
+{
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    const int maxLeaf = r[0];
+    __cpuid(r, 1);
+    const int sse2 = (r[3] >> 26) & 1;
+    const int osxsave = (r[2] >> 27) & 1;
+    const int avx = (r[2] >> 28) & 1;
+    const int f16c = (r[2] >> 29) & 1;
+    int avx2 = 0, avx512f = 0;
+    if (maxLeaf >= 7) {
+        __cpuidex(r, 7, 0);
+        avx2 = (r[1] >> 5) & 1;
+        avx512f = (r[1] >> 16) & 1;
+    }
+    /*the OS must also save the vector registers on a context switch*/
+    const u64 xcr0 = (osxsave && avx) ? _xgetbv(0) : 0;
+    if (avx512f && f16c && (xcr0 & 0xE6) == 0xE6)
+        return SVTL_SIMD_LEVEL_AVX512;
+    if (avx2 && f16c && (xcr0 & 0x6) == 0x6)
+        return SVTL_SIMD_LEVEL_AVX2;
+    if (sse2)
+        return SVTL_SIMD_LEVEL_SSE2;
+    return SVTL_SIMD_LEVEL_SCALAR;
+#else
+    /*also checks that the OS saves the vector registers*/
+    __builtin_cpu_init();
+    const int f16c = __builtin_cpu_supports("f16c");
+    if (__builtin_cpu_supports("avx512f") && f16c)
+        return SVTL_SIMD_LEVEL_AVX512;
+    if (__builtin_cpu_supports("avx2") && f16c)
+        return SVTL_SIMD_LEVEL_AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return SVTL_SIMD_LEVEL_SSE2;
+    return SVTL_SIMD_LEVEL_SCALAR;
+#endif
+}
+
+#endif /*KERNELS_X86*/
+
+static const struct Kernels_Table scalarKernels = {
+    affine2DF32Scalar, affine2DF64Scalar, shoelace2DF32Scalar, shoelace2DF64Scalar,
+    affine2DSoAF32Scalar, affine2DSoAF64Scalar, shoelace2DSoAF32Scalar, shoelace2DSoAF64Scalar,
+    streamCopyScalar,
+    widenF16Scalar, narrowF16Scalar, widenI16NormScalar, narrowI16NormScalar, widenI32FixedScalar, narrowI32FixedScalar,
+    affine3DF32Scalar, affine3DF64Scalar, affine3DSoAF32Scalar, affine3DSoAF64Scalar,
+    homography2DF32Scalar, homography2DF64Scalar, homography2DSoAF32Scalar, homography2DSoAF64Scalar,
+    bytesEqual17To64Scalar, bytesEqual17To64Scalar };
+#ifdef KERNELS_X86
+static const struct Kernels_Table sse2Kernels = {
+    affine2DF32SSE2, affine2DF64SSE2, shoelace2DF32SSE2, shoelace2DF64SSE2,
+    affine2DSoAF32SSE2, affine2DSoAF64SSE2, shoelace2DSoAF32SSE2, shoelace2DSoAF64SSE2,
+    streamCopySSE2,
+    widenF16Scalar, narrowF16Scalar, widenI16NormSSE2, narrowI16NormSSE2, widenI32FixedSSE2, narrowI32FixedSSE2,
+    affine3DF32SSE2, affine3DF64SSE2, affine3DSoAF32SSE2, affine3DSoAF64SSE2,
+    homography2DF32SSE2, homography2DF64SSE2, homography2DSoAF32SSE2, homography2DSoAF64SSE2,
+    bytesEqual17To32SSE2, bytesEqual33To64SSE2 };
+static const struct Kernels_Table avx2Kernels = {
+    affine2DF32AVX2, affine2DF64AVX2, shoelace2DF32AVX2, shoelace2DF64AVX2,
+    affine2DSoAF32AVX2, affine2DSoAF64AVX2, shoelace2DSoAF32AVX2, shoelace2DSoAF64AVX2,
+    streamCopyAVX2,
+    widenF16AVX2, narrowF16AVX2, widenI16NormAVX2, narrowI16NormAVX2, widenI32FixedAVX2, narrowI32FixedAVX2,
+    affine3DF32SSE2, affine3DF64AVX2, affine3DSoAF32AVX2, affine3DSoAF64AVX2,
+    homography2DF32AVX2, homography2DF64AVX2, homography2DSoAF32AVX2, homography2DSoAF64AVX2,
+    bytesEqual17To32SSE2, bytesEqual33To64AVX2 };
+static const struct Kernels_Table avx512Kernels = {
+    affine2DF32AVX512, affine2DF64AVX512, shoelace2DF32AVX512, shoelace2DF64AVX512,
+    affine2DSoAF32AVX512, affine2DSoAF64AVX512, shoelace2DSoAF32AVX512, shoelace2DSoAF64AVX512,
+    streamCopyAVX512,
+    widenF16AVX2, narrowF16AVX2, widenI16NormAVX2, narrowI16NormAVX2, widenI32FixedAVX2, narrowI32FixedAVX2,
+    affine3DF32AVX512, affine3DF64AVX512, affine3DSoAF32AVX512, affine3DSoAF64AVX512,
+    homography2DF32AVX512, homography2DF64AVX512, homography2DSoAF32AVX512, homography2DSoAF64AVX512,
+    bytesEqual17To32SSE2, bytesEqual33To64AVX2 };
+#endif
+
+static const struct Kernels_Table* kernels = &scalarKernels;
+static enum SVTL_SimdLevel kernelsLevel = SVTL_SIMD_LEVEL_SCALAR;
+static volatile u32 kernelsInitState = 0u; /*0: not selected, 1: selecting, 2: selected*/
+
+void Kernels_init(void)
+{
+    if (ATOMIC_LOAD_U32(&kernelsInitState) == 2u)
+        return;
+    if (ATOMIC_CAS_U32(&kernelsInitState, 0u, 1u)) {
+#ifdef KERNELS_X86
+        Kernels_select(detectSimdLevel());
+#endif
+        ATOMIC_STORE_U32(&kernelsInitState, 2u);
+    } else {
+        while (ATOMIC_LOAD_U32(&kernelsInitState) != 2u)
+            CPU_PAUSE();
+    }
+}
+
+void Kernels_select(enum SVTL_SimdLevel level)
+{
+#ifdef KERNELS_X86
+    switch (level)
+    {
+        case SVTL_SIMD_LEVEL_AVX512: kernels = &avx512Kernels; break;
+        case SVTL_SIMD_LEVEL_AVX2: kernels = &avx2Kernels; break;
+        case SVTL_SIMD_LEVEL_SSE2: kernels = &sse2Kernels; break;
+        default: kernels = &scalarKernels; level = SVTL_SIMD_LEVEL_SCALAR; break;
+    }
+#else
+    level = SVTL_SIMD_LEVEL_SCALAR;
+#endif
+    kernelsLevel = level;
+}
+
+enum SVTL_SimdLevel Kernels_getLevel(void)
+{
+    return kernelsLevel;
+}
+
+static struct Kernels_F32Affine toF32Affine(const struct SVTL_F64Mat2x3* t)
+{
+    struct Kernels_F32Affine k;
+    k.k[0] = (f32)t->m[0][0]; k.k[1] = (f32)t->m[0][1]; k.k[2] = (f32)t->m[0][2];
+    k.k[3] = (f32)t->m[1][0]; k.k[4] = (f32)t->m[1][1]; k.k[5] = (f32)t->m[1][2];
+    k.linear = !isLinearPartIdentity(t);
+    return k;
+}
+
+static struct Kernels_F64Affine toF64Affine(const struct SVTL_F64Mat2x3* t)
+{
+    struct Kernels_F64Affine k;
+    k.k[0] = t->m[0][0]; k.k[1] = t->m[0][1]; k.k[2] = t->m[0][2];
+    k.k[3] = t->m[1][0]; k.k[4] = t->m[1][1]; k.k[5] = t->m[1][2];
+    k.linear = !isLinearPartIdentity(t);
+    return k;
+}
+
+void Kernels_affine2DF32(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat2x3* t)
+{
+    const struct Kernels_F32Affine k = toF32Affine(t);
+    kernels->affine2DF32((u8*)positions, stride, count, &k);
+}
+
+void Kernels_affine2DF64(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat2x3* t)
+{
+    const struct Kernels_F64Affine k = toF64Affine(t);
+    kernels->affine2DF64((u8*)positions, stride, count, &k);
+}
+
+void Kernels_affine2DSoAF32(float* x, float* y, uint32_t count, const struct SVTL_F64Mat2x3* t)
+{
+    const struct Kernels_F32Affine k = toF32Affine(t);
+    kernels->affine2DSoAF32(x, y, count, &k);
+}
+
+void Kernels_affine2DSoAF64(double* x, double* y, uint32_t count, const struct SVTL_F64Mat2x3* t)
+{
+    const struct Kernels_F64Affine k = toF64Affine(t);
+    kernels->affine2DSoAF64(x, y, count, &k);
+}
+
+static int isLinearPart3DIdentity(const struct SVTL_F64Mat4x4* t)
+{
+    return t->m[0][0] == 1.0 && t->m[0][1] == 0.0 && t->m[0][2] == 0.0
+        && t->m[1][0] == 0.0 && t->m[1][1] == 1.0 && t->m[1][2] == 0.0
+        && t->m[2][0] == 0.0 && t->m[2][1] == 0.0 && t->m[2][2] == 1.0;
+}
+
+static struct Kernels_F32Affine3D toF32Affine3D(const struct SVTL_F64Mat4x4* t)
+{
+    struct Kernels_F32Affine3D k;
+    u32 i;
+    for (i = 0; i < 12; ++i)
+        k.k[i] = (f32)t->m[i / 4][i % 4];
+    k.linear = !isLinearPart3DIdentity(t);
+    return k;
+}
+
+static struct Kernels_F64Affine3D toF64Affine3D(const struct SVTL_F64Mat4x4* t)
+{
+    struct Kernels_F64Affine3D k;
+    u32 i;
+    for (i = 0; i < 12; ++i)
+        k.k[i] = t->m[i / 4][i % 4];
+    k.linear = !isLinearPart3DIdentity(t);
+    return k;
+}
+
+void Kernels_affine3DF32(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat4x4* t)
+{
+    const struct Kernels_F32Affine3D k = toF32Affine3D(t);
+    kernels->affine3DF32((u8*)positions, stride, count, &k);
+}
+
+void Kernels_affine3DF64(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat4x4* t)
+{
+    const struct Kernels_F64Affine3D k = toF64Affine3D(t);
+    kernels->affine3DF64((u8*)positions, stride, count, &k);
+}
+
+void Kernels_affine3DSoAF32(float* x, float* y, float* z, uint32_t count, const struct SVTL_F64Mat4x4* t)
+{
+    const struct Kernels_F32Affine3D k = toF32Affine3D(t);
+    kernels->affine3DSoAF32(x, y, z, count, &k);
+}
+
+void Kernels_affine3DSoAF64(double* x, double* y, double* z, uint32_t count, const struct SVTL_F64Mat4x4* t)
+{
+    const struct Kernels_F64Affine3D k = toF64Affine3D(t);
+    kernels->affine3DSoAF64(x, y, z, count, &k);
+}
+
+static struct Kernels_F32Homography toF32Homography(const struct SVTL_F64Mat3x3* t)
+{
+    struct Kernels_F32Homography k;
+    u32 i;
+    for (i = 0; i < 9; ++i)
+        k.k[i] = (f32)t->m[i / 3][i % 3];
+    return k;
+}
+
+static struct Kernels_F64Homography toF64Homography(const struct SVTL_F64Mat3x3* t)
+{
+    struct Kernels_F64Homography k;
+    u32 i;
+    for (i = 0; i < 9; ++i)
+        k.k[i] = t->m[i / 3][i % 3];
+    return k;
+}
+
+void Kernels_homography2DF32(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat3x3* t)
+{
+    const struct Kernels_F32Homography k = toF32Homography(t);
+    kernels->homography2DF32((u8*)positions, stride, count, &k);
+}
+
+void Kernels_homography2DF64(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat3x3* t)
+{
+    const struct Kernels_F64Homography k = toF64Homography(t);
+    kernels->homography2DF64((u8*)positions, stride, count, &k);
+}
+
+void Kernels_homography2DSoAF32(float* x, float* y, uint32_t count, const struct SVTL_F64Mat3x3* t)
+{
+    const struct Kernels_F32Homography k = toF32Homography(t);
+    kernels->homography2DSoAF32(x, y, count, &k);
+}
+
+void Kernels_homography2DSoAF64(double* x, double* y, uint32_t count, const struct SVTL_F64Mat3x3* t)
+{
+    const struct Kernels_F64Homography k = toF64Homography(t);
+    kernels->homography2DSoAF64(x, y, count, &k);
+}
+
+void Kernels_shoelace2DF32(const void* positions, uint32_t stride, uint32_t first, uint32_t count, uint32_t total, int centroid, double sums[3])
+{
+    if (count == 0)
+        return;
+    const u8* p = (const u8*)positions;
+    /*the edges that do not wrap around to the first position*/
+    const u32 direct = first + count < total ? count : total - 1 - first;
+    kernels->shoelace2DF32(p + (size_t)stride * first, stride, direct, centroid, sums);
+    if (direct < count) {
+        const f32* a = (const f32*)(p + (size_t)stride * (total - 1));
+        const f32* b = (const f32*)p;
+        shoelacePair(a[0], a[1], b[0], b[1], centroid, sums);
+    }
+}
+
+void Kernels_shoelace2DF64(const void* positions, uint32_t stride, uint32_t first, uint32_t count, uint32_t total, int centroid, double sums[3])
+{
+    if (count == 0)
+        return;
+    const u8* p = (const u8*)positions;
+    const u32 direct = first + count < total ? count : total - 1 - first;
+    kernels->shoelace2DF64(p + (size_t)stride * first, stride, direct, centroid, sums);
+    if (direct < count) {
+        const f64* a = (const f64*)(p + (size_t)stride * (total - 1));
+        const f64* b = (const f64*)p;
+        shoelacePair(a[0], a[1], b[0], b[1], centroid, sums);
+    }
+}
+
+void Kernels_shoelace2DSoAF32(const float* x, const float* y, uint32_t first, uint32_t count, uint32_t total, int centroid, double sums[3])
+{
+    if (count == 0)
+        return;
+    const u32 direct = first + count < total ? count : total - 1 - first;
+    kernels->shoelace2DSoAF32(x + first, y + first, direct, centroid, sums);
+    if (direct < count)
+        shoelacePair(x[total - 1], y[total - 1], x[0], y[0], centroid, sums);
+}
+
+void Kernels_shoelace2DSoAF64(const double* x, const double* y, uint32_t first, uint32_t count, uint32_t total, int centroid, double sums[3])
+{
+    if (count == 0)
+        return;
+    const u32 direct = first + count < total ? count : total - 1 - first;
+    kernels->shoelace2DSoAF64(x + first, y + first, direct, centroid, sums);
+    if (direct < count)
+        shoelacePair(x[total - 1], y[total - 1], x[0], y[0], centroid, sums);
+}
+
+void Kernels_streamCopy(void* dst, const void* src, size_t bytes)
+{
+    kernels->streamCopy((u8*)dst, (const u8*)src, bytes);
+}
+
+void Kernels_widenF16(const uint16_t* in, float* out, size_t count)
+{
+    kernels->widenF16(in, out, count);
+}
+
+void Kernels_narrowF16(const float* in, uint16_t* out, size_t count)
+{
+    kernels->narrowF16(in, out, count);
+}
+
+void Kernels_widenI16Norm(const int16_t* in, float* out, size_t count)
+{
+    kernels->widenI16Norm(in, out, count);
+}
+
+void Kernels_narrowI16Norm(const float* in, int16_t* out, size_t count)
+{
+    kernels->narrowI16Norm(in, out, count);
+}
+
+void Kernels_widenI32Fixed(const int32_t* in, double* out, size_t count)
+{
+    kernels->widenI32Fixed(in, out, count);
+}
+
+void Kernels_narrowI32Fixed(const double* in, int32_t* out, size_t count)
+{
+    kernels->narrowI32Fixed(in, out, count);
+}
+
+Kernels_BytesEqual_T Kernels_getBytesEqual(uint32_t size)
+{
+    if (size >= 8 && size <= 16)
+        return bytesEqual8To16;
+    if (size >= 17 && size <= 32)
+        return kernels->bytesEqual17To32;
+    if (size >= 33 && size <= 64)
+        return kernels->bytesEqual33To64;
+    return bytesEqualMemcmp;
+}
+
+void Kernels_streamFence(void)
+{
+#ifdef KERNELS_X86
+    if (kernelsLevel != SVTL_SIMD_LEVEL_SCALAR)
+        streamFenceSSE2();
+#endif
+}
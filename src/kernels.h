@@ -0,0 +1,97 @@
+/*
+Copyright (C) 2025 Tripp Robins
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this
+software and associated documentation files (the "Software"), to deal in the Software
+without restriction, including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+Vectorized per-vertex loops. Positions are addressed as a base pointer and a byte stride, so the kernels
+serve packed position arrays as well as positions interleaved with other vertex attributes.
+The SoA kernels take separate packed x and y arrays.*/
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "../svtl.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+Selects the kernels for the instruction sets of the CPU. It is safe to call more than once and from several threads.*/
+void Kernels_init(void);
+
+/*
+Selects the kernels for the given instruction set, which the CPU must support. Kernels_init calls it with the best supported one.*/
+void Kernels_select(enum SVTL_SimdLevel level);
+
+enum SVTL_SimdLevel Kernels_getLevel(void);
+
+/*
+Applies an affine transform to count 2D positions.
+@param void* positions - the first position
+@param uint32_t stride - the distance in bytes between consecutive positions
+@param uint32_t count - the number of positions
+@param const struct SVTL_F64Mat2x3* t - the transform. F32 positions are transformed in single precision.*/
+void Kernels_affine2DF32(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat2x3* t);
+void Kernels_affine2DF64(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat2x3* t);
+void Kernels_affine2DSoAF32(float* x, float* y, uint32_t count, const struct SVTL_F64Mat2x3* t);
+void Kernels_affine2DSoAF64(double* x, double* y, uint32_t count, const struct SVTL_F64Mat2x3* t);
+
+/*
+Applies a 3D affine transform, the top three rows of t, to count 3D positions. The bottom row of t is ignored.*/
+void Kernels_affine3DF32(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat4x4* t);
+void Kernels_affine3DF64(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat4x4* t);
+void Kernels_affine3DSoAF32(float* x, float* y, float* z, uint32_t count, const struct SVTL_F64Mat4x4* t);
+void Kernels_affine3DSoAF64(double* x, double* y, double* z, uint32_t count, const struct SVTL_F64Mat4x4* t);
+
+/*
+Applies a projective transform to count 2D positions, dividing each by w = m[2][0]*x + m[2][1]*y + m[2][2].*/
+void Kernels_homography2DF32(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat3x3* t);
+void Kernels_homography2DF64(void* positions, uint32_t stride, uint32_t count, const struct SVTL_F64Mat3x3* t);
+void Kernels_homography2DSoAF32(float* x, float* y, uint32_t count, const struct SVTL_F64Mat3x3* t);
+void Kernels_homography2DSoAF64(double* x, double* y, uint32_t count, const struct SVTL_F64Mat3x3* t);
+
+/*
+Adds the shoelace terms of the edges first..first+count-1 of a closed polygon of total positions, where edge i runs from position i to position (i + 1) % total.
+sums[0] += sum of cross(p[i], p[i+1]); when centroid is non-zero, sums[1] and sums[2] also accumulate (x[i] + x[i+1]) * cross and (y[i] + y[i+1]) * cross.
+@param const void* positions - the first position of the polygon*/
+void Kernels_shoelace2DF32(const void* positions, uint32_t stride, uint32_t first, uint32_t count, uint32_t total, int centroid, double sums[3]);
+void Kernels_shoelace2DF64(const void* positions, uint32_t stride, uint32_t first, uint32_t count, uint32_t total, int centroid, double sums[3]);
+void Kernels_shoelace2DSoAF32(const float* x, const float* y, uint32_t first, uint32_t count, uint32_t total, int centroid, double sums[3]);
+void Kernels_shoelace2DSoAF64(const double* x, const double* y, uint32_t first, uint32_t count, uint32_t total, int centroid, double sums[3]);
+
+/*
+Compares two blocks of size bytes, returning non-zero when they are equal.*/
+typedef int (*Kernels_BytesEqual_T)(const void* a, const void* b, uint32_t size);
+
+/*
+Returns the fastest equality function for blocks of size bytes, for the selected instruction set. Sizes from 8 to 64 bytes have versions without a loop.*/
+Kernels_BytesEqual_T Kernels_getBytesEqual(uint32_t size);
+
+/*
+Copies bytes to dst with non-temporal stores, which bypass the cache. Kernels_streamFence must be called before the copy is read by another thread.*/
+void Kernels_streamCopy(void* dst, const void* src, size_t bytes);
+void Kernels_streamFence(void);
+
+/*
+Converts count components of a compact position type to F32, or I32_FIXED components to F64, and back.
+Narrowing rounds to nearest even and clamps I16_NORM values to [-1, 1] and I32_FIXED values to the 32-bit range.*/
+void Kernels_widenF16(const uint16_t* in, float* out, size_t count);
+void Kernels_narrowF16(const float* in, uint16_t* out, size_t count);
+void Kernels_widenI16Norm(const int16_t* in, float* out, size_t count);
+void Kernels_narrowI16Norm(const float* in, int16_t* out, size_t count);
+void Kernels_widenI32Fixed(const int32_t* in, double* out, size_t count);
+void Kernels_narrowI32Fixed(const double* in, int32_t* out, size_t count);
+
+#endif /*!KERNELS_H*/
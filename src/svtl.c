@@ -18,11 +18,29 @@ TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR TH
 #include "../svtl.h"
 #include "threadpool.h"
 #include "hashmap.h"
+#include "cthreads.h"
+#include "atomics.h"
+#include "kernels.h"
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <math.h>
 #include <assert.h>
-#define TASK_COUNT 2u
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+#define MAX_WORKER_COUNT 1024u
+#define DEFAULT_PARALLEL_THRESHOLD 8192u
+#define DEFAULT_JOIN_SPIN_COUNT 4096u
+#define DISPATCH_INLINE_ARGS_SIZE 192u
+/*every *_Args struct is followed by this, so one that outgrows the inline arguments of a serial dispatch fails to compile*/
+#define DISPATCH_ARGS_FIT(name) typedef char name##_FitsInlineArgs[(sizeof(struct name) <= DISPATCH_INLINE_ARGS_SIZE) ? 1 : -1]
+#define DISPATCH_CHUNKS_PER_TASK 16u
+#define DISPATCH_MIN_CHUNK_SIZE 1024u
+#define SCRATCH_ALIGNMENT 16u
+#define CACHE_LINE_SIZE 64u
 #define THREAD_TIMEOUT_MS 60000 // 20 seconds
 
 typedef	uint8_t u8;
@@ -37,570 +55,3057 @@ typedef float f32;
 typedef double f64;
 
 
+/*a reusable allocation that holds the task arguments and task handles of one parallel operation.
+Released blocks are kept on a free list, so steady-state operations do not allocate*/
+struct SVTL_ScratchBlock
+{
+    struct SVTL_ScratchBlock* next;
+    size_t capacity;
+};
+#define SCRATCH_HEADER_SIZE ((sizeof(struct SVTL_ScratchBlock) + SCRATCH_ALIGNMENT - 1) / SCRATCH_ALIGNMENT * SCRATCH_ALIGNMENT)
+
+/*the task backend, settings and scratch memory used by operations*/
+struct SVTL_Context_T
+{
+    SVTL_LaunchTask_T launchTask; /*NULL to use the context's own thread pool*/
+    SVTL_JoinTask_T joinTask;
+    SVTL_LaunchTaskBatch_T launchTaskBatch; /*takes precedence over launchTask when set*/
+    SVTL_JoinTaskBatch_T joinTaskBatch;
+    u16 taskHandleSize;
+    u32 workerCount; /*0 until resolved to the number of online CPUs*/
+    u32 parallelThreshold;
+    u32 joinSpinCount;
+
+    bool initialized;
+    ThreadPoolHandle threadPool;
+    bool threadPoolExists;
+
+    struct cthreads_mutex scratchMutex;
+    struct SVTL_ScratchBlock* scratchFreeList;
+};
+
+/*used by the functions that do not take a context. Its settings persist across SVTL_register/SVTL_unregister,
+so callbacks may be set before SVTL_register*/
+static struct SVTL_Context_T defaultContext = { NULL, NULL, NULL, NULL, sizeof(ThreadPoolTaskHandle), 0u, DEFAULT_PARALLEL_THRESHOLD, DEFAULT_JOIN_SPIN_COUNT };
+static volatile u32 registerLock = 0u; /*guards svtlUsageCount and the initialisation of defaultContext*/
 static u64 svtlUsageCount = 0u;
-ThreadPoolHandle threadPool={0};
-bool threadPoolExists=false;
 
-static u16 taskHandleSize=sizeof(ThreadPoolTaskHandle);
-static errno_t(*launchTask)(SVTL_Task, SVTL_TaskHandle)=NULL;
-static errno_t(*joinTask)(SVTL_TaskHandle)=NULL;
+static u32 getOnlineCpuCount(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (u32)info.dwNumberOfProcessors : 1u;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (u32)n : 1u;
+#endif
+}
+
+/*creates or destroys the context's thread pool to match its launch callback and worker count*/
+static void updateThreadPool(SVTL_Context ctx)
+{
+    bool wantPool = ctx->initialized && ctx->launchTask == NULL && ctx->launchTaskBatch == NULL;
+    if (ctx->threadPoolExists && (!wantPool || ctx->threadPool.threadCount != ctx->workerCount)) {
+        ThreadPool_Destroy(&ctx->threadPool);
+        ctx->threadPoolExists = false;
+    }
+    if (wantPool && !ctx->threadPoolExists) {
+        ctx->threadPool.threadCount = (u16)ctx->workerCount;
+        ctx->threadPoolExists = ThreadPool_New(&ctx->threadPool, THREAD_TIMEOUT_MS)==0;
+    }
+    /*with a single CPU, a spinning join only delays the worker it waits for*/
+    if (ctx->threadPoolExists)
+        ThreadPool_SetJoinSpinCount(ctx->threadPool, getOnlineCpuCount() > 1 ? ctx->joinSpinCount : 0u);
+}
 
-static errno_t defaultLaunchTask(SVTL_Task task, void* tphdl) {
-    ThreadPoolTask t = {task.args, task.func};
-    return ThreadPool_LaunchTask(threadPool, t,  tphdl);
+static errno_t initContext(SVTL_Context ctx)
+{
+    if (ctx->workerCount == 0)
+        ctx->workerCount = getOnlineCpuCount() < MAX_WORKER_COUNT ? getOnlineCpuCount() : MAX_WORKER_COUNT;
+    if (cthreads_mutex_init(&ctx->scratchMutex, NULL))
+        return -1;
+    ctx->scratchFreeList = NULL;
+    ctx->initialized = true;
+    updateThreadPool(ctx);
+    return 0;
+}
+
+static void shutdownContext(SVTL_Context ctx)
+{
+    ctx->initialized = false;
+    updateThreadPool(ctx);
+    while (ctx->scratchFreeList) {
+        struct SVTL_ScratchBlock* next = ctx->scratchFreeList->next;
+        free(ctx->scratchFreeList);
+        ctx->scratchFreeList = next;
+    }
+    cthreads_mutex_destroy(&ctx->scratchMutex);
 }
-static errno_t defaultJoinTask(void* tphdl) {
-    ThreadPool_JoinTask(tphdl);
+
+SVTL_API errno_t SVTL_createContext(SVTL_Context* ctxOut)
+{
+    Kernels_init();
+    SVTL_Context ctx = calloc(1, sizeof(struct SVTL_Context_T));
+    if (!ctx)
+        return -1;
+    ctx->taskHandleSize = sizeof(ThreadPoolTaskHandle);
+    ctx->parallelThreshold = DEFAULT_PARALLEL_THRESHOLD;
+    ctx->joinSpinCount = DEFAULT_JOIN_SPIN_COUNT;
+    if (initContext(ctx)) {
+        free(ctx);
+        return -1;
+    }
+    *ctxOut = ctx;
     return 0;
 }
+
+SVTL_API void SVTL_destroyContext(SVTL_Context ctx)
+{
+    if (!ctx || ctx == &defaultContext)
+        return;
+    shutdownContext(ctx);
+    free(ctx);
+}
+
+SVTL_API SVTL_Context SVTL_getDefaultContext(void)
+{
+    return &defaultContext;
+}
+
+SVTL_API void SVTL_setTaskLaunchCallbackCtx(SVTL_Context ctx, SVTL_LaunchTask_T cb) {
+    ctx->launchTask = cb;
+    if (cb == NULL && ctx->launchTaskBatch == NULL)
+        ctx->taskHandleSize = sizeof(ThreadPoolTaskHandle);
+    updateThreadPool(ctx);
+}
+
+SVTL_API void SVTL_setTaskJoinCallbackCtx(SVTL_Context ctx, SVTL_JoinTask_T cb) {
+    ctx->joinTask = cb;
+}
+
+SVTL_API void SVTL_setTaskBatchLaunchCallbackCtx(SVTL_Context ctx, SVTL_LaunchTaskBatch_T cb) {
+    ctx->launchTaskBatch = cb;
+    if (cb == NULL && ctx->launchTask == NULL)
+        ctx->taskHandleSize = sizeof(ThreadPoolTaskHandle);
+    updateThreadPool(ctx);
+}
+
+SVTL_API void SVTL_setTaskBatchJoinCallbackCtx(SVTL_Context ctx, SVTL_JoinTaskBatch_T cb) {
+    ctx->joinTaskBatch = cb;
+}
+
+SVTL_API void SVTL_setTaskHandleSizeCtx(SVTL_Context ctx, uint16_t size) {
+    ctx->taskHandleSize = size;
+}
+
+SVTL_API void SVTL_setWorkerCountCtx(SVTL_Context ctx, uint32_t count)
+{
+    if (count == 0)
+        count = getOnlineCpuCount();
+    if (count > MAX_WORKER_COUNT)
+        count = MAX_WORKER_COUNT;
+    ctx->workerCount = count;
+    updateThreadPool(ctx);
+}
+
+SVTL_API uint32_t SVTL_getWorkerCountCtx(SVTL_Context ctx)
+{
+    return ctx->workerCount;
+}
+
+SVTL_API void SVTL_setParallelThresholdCtx(SVTL_Context ctx, uint32_t count)
+{
+    ctx->parallelThreshold = count;
+}
+
+SVTL_API uint32_t SVTL_getParallelThresholdCtx(SVTL_Context ctx)
+{
+    return ctx->parallelThreshold;
+}
+
+SVTL_API void SVTL_setJoinSpinCountCtx(SVTL_Context ctx, uint32_t count)
+{
+    ctx->joinSpinCount = count;
+    updateThreadPool(ctx);
+}
+
+SVTL_API uint32_t SVTL_getJoinSpinCountCtx(SVTL_Context ctx)
+{
+    return ctx->joinSpinCount;
+}
+
 /*
 /// sets the callback to launch a task/thread.*/
 SVTL_API void SVTL_setTaskLaunchCallback(SVTL_LaunchTask_T cb) {
-    launchTask = cb;
-    if (launchTask!=defaultLaunchTask) {
-        if (threadPoolExists) {
-            ThreadPool_Destroy(&threadPool);
-            threadPoolExists=false;
-        }
-    } else {
-        if (!threadPoolExists) {
-            taskHandleSize=sizeof(ThreadPoolTaskHandle);
-            threadPool.threadCount = TASK_COUNT;
-            ThreadPool_New(&threadPool, THREAD_TIMEOUT_MS);
-            threadPoolExists=true;
-        }
-    }
+    SVTL_setTaskLaunchCallbackCtx(&defaultContext, cb);
 }
 
 /*
 /// sets the callback to join a task/thread. The argument of the function pointer should be a task handle.*/
 SVTL_API void SVTL_setTaskJoinCallback(SVTL_JoinTask_T cb) {
-    joinTask = cb;
+    SVTL_setTaskJoinCallbackCtx(&defaultContext, cb);
 }
 
 SVTL_API void setTaskHandleSize(u16 size) {
-    taskHandleSize = size;
+    SVTL_setTaskHandleSizeCtx(&defaultContext, size);
+}
+
+SVTL_API void SVTL_setTaskBatchLaunchCallback(SVTL_LaunchTaskBatch_T cb) {
+    SVTL_setTaskBatchLaunchCallbackCtx(&defaultContext, cb);
+}
+
+SVTL_API void SVTL_setTaskBatchJoinCallback(SVTL_JoinTaskBatch_T cb) {
+    SVTL_setTaskBatchJoinCallbackCtx(&defaultContext, cb);
+}
+
+SVTL_API void SVTL_setWorkerCount(uint32_t count)
+{
+    SVTL_setWorkerCountCtx(&defaultContext, count);
+}
+
+SVTL_API uint32_t SVTL_getWorkerCount(void)
+{
+    return SVTL_getWorkerCountCtx(&defaultContext);
+}
+
+SVTL_API void SVTL_setParallelThreshold(uint32_t count)
+{
+    SVTL_setParallelThresholdCtx(&defaultContext, count);
+}
+
+SVTL_API uint32_t SVTL_getParallelThreshold(void)
+{
+    return SVTL_getParallelThresholdCtx(&defaultContext);
+}
+
+SVTL_API void SVTL_setJoinSpinCount(uint32_t count)
+{
+    SVTL_setJoinSpinCountCtx(&defaultContext, count);
+}
+
+SVTL_API uint32_t SVTL_getJoinSpinCount(void)
+{
+    return SVTL_getJoinSpinCountCtx(&defaultContext);
+}
+
+SVTL_API enum SVTL_SimdLevel SVTL_getSimdLevel(void)
+{
+    return Kernels_getLevel();
 }
 
-static void DBG_VALIDATE_INSTANCE_USAGE() {
+static void DBG_VALIDATE_INSTANCE_USAGE(SVTL_Context ctx) {
     #ifndef NDEBUG
-       if (launchTask==NULL || joinTask==NULL) {
-            assert(00&&"launchTask & joinTask must be valid function pointers");
+       if (!ctx->initialized) {
+            assert(00&&"SVTL_register must be called before using the default context");
+       }
+       if (ctx->launchTask!=NULL && ctx->joinTask==NULL) {
+            assert(00&&"a join callback must be set along with a custom launch callback");
+       }
+       if (ctx->launchTaskBatch!=NULL && ctx->joinTaskBatch==NULL) {
+            assert(00&&"a batch join callback must be set along with a batch launch callback");
        }
     #endif
 }
 
+static errno_t contextLaunchTask(SVTL_Context ctx, SVTL_Task task, SVTL_TaskHandle hdl)
+{
+    if (ctx->launchTask)
+        return ctx->launchTask(task, hdl);
+    if (!ctx->threadPoolExists)
+        return -1;
+    ThreadPoolTask t = {task.args, task.func};
+    return ThreadPool_LaunchTask(ctx->threadPool, t, hdl);
+}
+
+static errno_t contextLaunchTaskBatch(SVTL_Context ctx, const SVTL_Task* tasks, u32 taskCount, SVTL_TaskHandle hdl)
+{
+    return ctx->launchTaskBatch(tasks, taskCount, hdl);
+}
+
+static errno_t contextJoinTaskBatch(SVTL_Context ctx, SVTL_TaskHandle hdl)
+{
+    return ctx->joinTaskBatch(hdl);
+}
+
+static errno_t contextJoinTask(SVTL_Context ctx, SVTL_TaskHandle hdl)
+{
+    if (ctx->launchTask)
+        return ctx->joinTask(hdl);
+    ThreadPool_JoinTask(hdl);
+    return 0;
+}
+
+static struct SVTL_ScratchBlock* acquireScratch(SVTL_Context ctx, size_t bytes)
+{
+    cthreads_mutex_lock(&ctx->scratchMutex);
+    struct SVTL_ScratchBlock* block = ctx->scratchFreeList;
+    if (block)
+        ctx->scratchFreeList = block->next;
+    cthreads_mutex_unlock(&ctx->scratchMutex);
+
+    if (block && block->capacity >= bytes)
+        return block;
+
+    /*grow the block to the largest size requested so far*/
+    free(block);
+    block = malloc(SCRATCH_HEADER_SIZE + bytes);
+    if (!block)
+        return NULL;
+    block->capacity = bytes;
+    return block;
+}
+
+static void releaseScratch(SVTL_Context ctx, struct SVTL_ScratchBlock* block)
+{
+    cthreads_mutex_lock(&ctx->scratchMutex);
+    block->next = ctx->scratchFreeList;
+    ctx->scratchFreeList = block;
+    cthreads_mutex_unlock(&ctx->scratchMutex);
+}
+
+static u8* scratchData(struct SVTL_ScratchBlock* block)
+{
+    return (u8*)block + SCRATCH_HEADER_SIZE;
+}
+
 SVTL_API errno_t SVTL_register(void)
 {
+    errno_t err = 0;
+    Kernels_init();
+    SPIN_LOCK(&registerLock);
     svtlUsageCount++;
     if (svtlUsageCount==1) {
-        if (launchTask==NULL) {
-            SVTL_setTaskLaunchCallback(defaultLaunchTask);
-            SVTL_setTaskJoinCallback(defaultJoinTask);
-        }
+        err = initContext(&defaultContext);
+        if (err)
+            svtlUsageCount--;
     }
-    return 0;
+    SPIN_UNLOCK(&registerLock);
+    return err;
 }
 
 SVTL_API void SVTL_unregister(void)
 {
-    if (svtlUsageCount>0)
+    SPIN_LOCK(&registerLock);
+    if (svtlUsageCount>0) {
         svtlUsageCount--;
-    if (svtlUsageCount==0) {
-        if (threadPoolExists==true) {
-            ThreadPool_Destroy(&threadPool);
-            launchTask=NULL;
-            joinTask=NULL;
-            threadPoolExists=false;
-        }
+        if (svtlUsageCount==0)
+            shutdownContext(&defaultContext);
     }
+    SPIN_UNLOCK(&registerLock);
+}
+
+static u32 getSegmentSize(u32 count, u32 divisions, u32 divisionIdx)
+{
+    u32 size = count / divisions;
+    if (divisionIdx < count % divisions)
+        size += 1;
+    return size;
 }
 
-struct SVTL_translate2D_Args
+/*the vertices an operation runs over, resolved from either layout. Vertex i has its x component at x + i * stride
+and its y component at y + i * stride: interleaved positions have y one component after x, SoA positions have separate packed arrays.
+Read-only vertex infos are resolved to the same view, and are only read through it.
+VEC3 positions are viewed as their VEC2 type with z set, so the 2D operations apply to their x and y alone*/
+struct SVTL_VertexView
 {
-    const struct SVTL_VertexInfo* vi; u32 firstVertexIndex; u32 vertexCount; struct SVTL_F64Vec2 displacement;
+    u8* x;
+    u8* y;
+    u8* z; /*NULL for 2D positions*/
+    u32 stride;
+    u32 count;
+    const void* indices;
+    enum SVTL_PositionType positionType;
+    enum SVTL_IndexType indexType;
+    enum SVTL_TopologyType topologyType;
+    bool primitiveRestartEnabled;
+    bool soa;
 };
-static void* SVTL_translate2D_ThreadSegment(void *v)
-{
-    struct SVTL_translate2D_Args* args = (struct SVTL_translate2D_Args*)v;
-    const struct SVTL_VertexInfo* vi = args->vi;
-    u32 firstVertexIndex = args->firstVertexIndex;
-    u32 vertexCount = args->vertexCount;
-    struct SVTL_F64Vec2 displacement = args->displacement;
-    void* vertices = vi->vertices;
-
-    u32 i = firstVertexIndex;
-    const u32 end = firstVertexIndex + vertexCount;
-    if (vi->positionType == SVTL_POS_TYPE_VEC2_F32) {
-        for (; i < end; ++i)
-        {
-            struct SVTL_F32Vec2* pos = (struct SVTL_F32Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x += (f32)displacement.x;
-            pos->y += (f32)displacement.y;
-        }
-    }
-    else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64)
-    {
-        for (; i < end; ++i)
-        {
-            struct SVTL_F64Vec2* pos = (struct SVTL_F64Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x += displacement.x;
-            pos->y += displacement.y;
-        }
+
+static u32 positionComponentSize(enum SVTL_PositionType type)
+{
+    switch (type) {
+    case SVTL_POS_TYPE_VEC2_F64:
+    case SVTL_POS_TYPE_VEC3_F64: return (u32)sizeof(f64);
+    case SVTL_POS_TYPE_VEC2_F16:
+    case SVTL_POS_TYPE_VEC2_I16_NORM: return (u32)sizeof(u16);
+    default: return (u32)sizeof(f32);
     }
-    return NULL;
 }
 
+/*the compact position types are transformed and reduced in F32, or in F64 for I32_FIXED, which F32 cannot hold exactly*/
+static bool isCompactPositionType(enum SVTL_PositionType type)
+{
+    return type != SVTL_POS_TYPE_VEC2_F32 && type != SVTL_POS_TYPE_VEC2_F64;
+}
 
-static u32 getSegmentSize(u32 count, u32 divisions, u32 divisionIdx)
+static bool is3DPositionType(enum SVTL_PositionType type)
 {
-    i32 i = divisionIdx;
-    i32 j = (count + 1) / divisions;
-    i32 k = count - (i + 1) * j;
-    if (i == (i32)divisions - 1)
-        j += k;
-    return j;
+    return type == SVTL_POS_TYPE_VEC3_F32 || type == SVTL_POS_TYPE_VEC3_F64;
 }
 
-static u32 getSegmentSizeGrouped(u32 count, u32 groupSize, u32 divisions, u32 divisionIdx)
+/*the VEC2 type with the components of a position type*/
+static enum SVTL_PositionType planarPositionType(enum SVTL_PositionType type)
 {
-    u32 groupCount =  (count + groupSize - 1) / groupSize; /*ceil (count/groupSize)*/
-    u32 groupsInDiv = groupCount / divisions;
-    u32 groupRemainder = groupCount % divisions;
-    
-    if (divisionIdx < groupRemainder)
-        groupsInDiv += 1;
-    
-    
-    u32 max_ = groupsInDiv * groupSize * (divisionIdx+1);
-    return max_ > count ? groupSize-(max_-count) : groupsInDiv * groupSize;
+    switch (type) {
+    case SVTL_POS_TYPE_VEC3_F32: return SVTL_POS_TYPE_VEC2_F32;
+    case SVTL_POS_TYPE_VEC3_F64: return SVTL_POS_TYPE_VEC2_F64;
+    default: return type;
+    }
 }
 
-SVTL_API errno_t SVTL_translate2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 displacement)
+static enum SVTL_PositionType widePositionType(enum SVTL_PositionType type)
 {
-    DBG_VALIDATE_INSTANCE_USAGE();
+    return type == SVTL_POS_TYPE_VEC2_F64 || type == SVTL_POS_TYPE_VEC2_I32_FIXED ? SVTL_POS_TYPE_VEC2_F64 : SVTL_POS_TYPE_VEC2_F32;
+}
 
-    struct SVTL_translate2D_Args* dataList = malloc(sizeof(struct SVTL_translate2D_Args) * TASK_COUNT);
-    SVTL_TaskHandle* taskHandles = malloc(taskHandleSize * TASK_COUNT);
-    if (!dataList || !taskHandles) {
-        return -1;
+/*converts count components of a compact type to its wide type*/
+static void widenComponents(enum SVTL_PositionType type, const void* in, void* out, size_t count)
+{
+    switch (type) {
+    case SVTL_POS_TYPE_VEC2_F16: Kernels_widenF16(in, out, count); break;
+    case SVTL_POS_TYPE_VEC2_I16_NORM: Kernels_widenI16Norm(in, out, count); break;
+    case SVTL_POS_TYPE_VEC2_I32_FIXED: Kernels_widenI32Fixed(in, out, count); break;
+    default: break;
     }
+}
 
-    u8 i;
-    for (i=0; i < TASK_COUNT; ++i) {
-        SVTL_Task task;
-        struct SVTL_translate2D_Args* fData = &dataList[i];
-        fData->vi = vi;
-        fData->firstVertexIndex = i * (vi->count + 1) / TASK_COUNT;
-        fData->vertexCount = getSegmentSize(vi->count, TASK_COUNT, i);
-        fData->displacement = displacement;
-        task.args = fData;
-        task.func = SVTL_translate2D_ThreadSegment;
-        launchTask(task,(u8*)taskHandles+(i*taskHandleSize));
+static void narrowComponents(enum SVTL_PositionType type, const void* in, void* out, size_t count)
+{
+    switch (type) {
+    case SVTL_POS_TYPE_VEC2_F16: Kernels_narrowF16(in, out, count); break;
+    case SVTL_POS_TYPE_VEC2_I16_NORM: Kernels_narrowI16Norm(in, out, count); break;
+    case SVTL_POS_TYPE_VEC2_I32_FIXED: Kernels_narrowI32Fixed(in, out, count); break;
+    default: break;
     }
+}
+
+static f64 loadComponent(enum SVTL_PositionType type, const u8* p)
+{
+    if (type == SVTL_POS_TYPE_VEC2_F32)
+        return *(const f32*)p;
+    if (type == SVTL_POS_TYPE_VEC2_F64)
+        return *(const f64*)p;
+
+    union { u8 raw[sizeof(i32)]; f32 f; f64 d; } in, out;
+    memcpy(in.raw, p, positionComponentSize(type));
+    widenComponents(type, in.raw, &out, 1);
+    return widePositionType(type) == SVTL_POS_TYPE_VEC2_F64 ? out.d : out.f;
+}
 
-    for (i = 0; i < TASK_COUNT; ++i) {
-        joinTask((u8*)taskHandles+(i*taskHandleSize));
+static void storeComponent(enum SVTL_PositionType type, u8* p, f64 v)
+{
+    if (type == SVTL_POS_TYPE_VEC2_F32) {
+        *(f32*)p = (f32)v;
+        return;
+    }
+    if (type == SVTL_POS_TYPE_VEC2_F64) {
+        *(f64*)p = v;
+        return;
     }
 
-    free(dataList);
-    free(taskHandles);
-    return 0;
+    union { u8 raw[sizeof(i32)]; f32 f; f64 d; } in, out;
+    if (widePositionType(type) == SVTL_POS_TYPE_VEC2_F64)
+        in.d = v;
+    else
+        in.f = (f32)v;
+    narrowComponents(type, &in, out.raw, 1);
+    memcpy(p, out.raw, positionComponentSize(type));
 }
 
-struct SVTL_rotate2D_Args
+static struct SVTL_VertexView interleavedView(const void* vertices, u32 stride, u32 positionOffset, u32 count, const void* indices,
+    enum SVTL_PositionType positionType, enum SVTL_IndexType indexType, enum SVTL_TopologyType topologyType, bool primitiveRestartEnabled)
 {
-    const struct SVTL_VertexInfo* vi;  u32 firstVertexIndex; u32 vertexCount; f64 radians; struct SVTL_F64Vec2 origin;
-};
+    struct SVTL_VertexView v;
+    v.x = (u8*)vertices + positionOffset;
+    v.y = v.x + positionComponentSize(positionType);
+    v.z = is3DPositionType(positionType) ? v.y + positionComponentSize(positionType) : NULL;
+    v.stride = stride;
+    v.count = count;
+    v.indices = indices;
+    v.positionType = planarPositionType(positionType);
+    v.indexType = indexType;
+    v.topologyType = topologyType;
+    v.primitiveRestartEnabled = primitiveRestartEnabled;
+    v.soa = false;
+    return v;
+}
+
+static struct SVTL_VertexView soaView(const void* x, const void* y, const void* z, u32 count, const void* indices,
+    enum SVTL_PositionType positionType, enum SVTL_IndexType indexType, enum SVTL_TopologyType topologyType, bool primitiveRestartEnabled)
+{
+    struct SVTL_VertexView v;
+    v.x = (u8*)x;
+    v.y = (u8*)y;
+    v.z = is3DPositionType(positionType) ? (u8*)z : NULL;
+    v.stride = positionComponentSize(positionType);
+    v.count = count;
+    v.indices = indices;
+    v.positionType = planarPositionType(positionType);
+    v.indexType = indexType;
+    v.topologyType = topologyType;
+    v.primitiveRestartEnabled = primitiveRestartEnabled;
+    v.soa = true;
+    return v;
+}
 
-static void* SVTL_rotate2D_ThreadSegment(void* v)
+static struct SVTL_VertexView viewOf(const struct SVTL_VertexInfo* vi)
 {
-    struct SVTL_rotate2D_Args* args  = (struct SVTL_rotate2D_Args*)v;
+    return interleavedView(vi->vertices, vi->stride, vi->positionOffset, vi->count, vi->indices,
+        vi->positionType, vi->indexType, vi->topologyType, vi->primitiveRestartEnabled);
+}
 
-    const struct SVTL_VertexInfo* vi = args->vi;
-    u32 firstVertexIndex = args->firstVertexIndex;
-    u32 vertexCount = args->vertexCount;
-    struct SVTL_F64Vec2 origin = args->origin;
-    f64 radians = args->radians;
-    void* vertices = vi->vertices;
+static struct SVTL_VertexView viewOfReadOnly(const struct SVTL_VertexInfoReadOnly* vi)
+{
+    return interleavedView(vi->vertices, vi->stride, vi->positionOffset, vi->count, vi->indices,
+        vi->positionType, vi->indexType, vi->topologyType, vi->primitiveRestartEnabled);
+}
 
-    f64 c = cos(radians);
-    f64 s = sin(radians);
+static struct SVTL_VertexView viewOfSoA(const struct SVTL_VertexInfoSoA* vi)
+{
+    return soaView(vi->x, vi->y, vi->z, vi->count, vi->indices, vi->positionType, vi->indexType, vi->topologyType, vi->primitiveRestartEnabled);
+}
 
-   
-    u32 i = firstVertexIndex;
-    const u32 end = firstVertexIndex + vertexCount;
-    if (vi->positionType == SVTL_POS_TYPE_VEC2_F32) {
-        for (; i < end; ++i)
-        {
-            struct SVTL_F32Vec2* pos = (struct SVTL_F32Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x -= (f32)origin.x;
-            pos->y -= (f32)origin.y;
-            f64 rx = pos->x * (f32)c - pos->y * (f32)s;
-            f64 ry = pos->x * (f32)s + pos->y * (f32)c;
-            pos->x = (f32)(rx + origin.x);
-            pos->y = (f32)(ry + origin.y);
-        }
-    }
-    else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64)
-    {
-        for (; i < end; ++i)
-        {
-            struct SVTL_F64Vec2* pos = (struct SVTL_F64Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x -= origin.x;
-            pos->y -= origin.y;
-            f64 rx = pos->x * c - pos->y * s;
-            f64 ry = pos->x * s + pos->y * c;
-            pos->x = rx + origin.x;
-            pos->y = ry + origin.y;
-        }
+static struct SVTL_VertexView viewOfSoAReadOnly(const struct SVTL_VertexInfoSoAReadOnly* vi)
+{
+    return soaView(vi->x, vi->y, vi->z, vi->count, vi->indices, vi->positionType, vi->indexType, vi->topologyType, vi->primitiveRestartEnabled);
+}
+
+static struct SVTL_F64Vec2 loadPosition(const struct SVTL_VertexView* v, u32 idx)
+{
+    struct SVTL_F64Vec2 p;
+    const size_t offset = (size_t)v->stride * idx;
+    if (v->positionType == SVTL_POS_TYPE_VEC2_F32) {
+        p.x = *(const f32*)(v->x + offset);
+        p.y = *(const f32*)(v->y + offset);
+    } else if (v->positionType == SVTL_POS_TYPE_VEC2_F64) {
+        p.x = *(const f64*)(v->x + offset);
+        p.y = *(const f64*)(v->y + offset);
+    } else {
+        p.x = loadComponent(v->positionType, v->x + offset);
+        p.y = loadComponent(v->positionType, v->y + offset);
     }
-    return NULL;
+    return p;
 }
 
-SVTL_API errno_t SVTL_rotate2D(const struct SVTL_VertexInfo* vi, f64 radians, struct SVTL_F64Vec2 origin)
+/*vertices of a compact position type widened at once, plus one more slot for the vertex that closes a polygon*/
+#define WIDEN_BLOCK_VERTEX_COUNT 256u
+
+struct SVTL_WidenBlock
 {
-    DBG_VALIDATE_INSTANCE_USAGE();
+    union {
+        u8 bytes[2 * (WIDEN_BLOCK_VERTEX_COUNT + 1) * sizeof(f64)];
+        f64 align_;
+    } wide;
+    union {
+        u8 bytes[2 * (WIDEN_BLOCK_VERTEX_COUNT + 1) * sizeof(i32)];
+        f64 align_;
+    } raw;
+};
 
-    struct SVTL_rotate2D_Args* argList = malloc(sizeof(struct SVTL_rotate2D_Args) * TASK_COUNT);
-    SVTL_TaskHandle* taskHandles = malloc(taskHandleSize * TASK_COUNT);
-    if (!argList || !taskHandles) {
-        return -1;
+/*a view of the widened positions of a block: packed pairs for interleaved views, and x then y arrays for SoA views*/
+static struct SVTL_VertexView wideBlockView(struct SVTL_WidenBlock* block, const struct SVTL_VertexView* v)
+{
+    const enum SVTL_PositionType type = widePositionType(v->positionType);
+    const u32 ws = positionComponentSize(type);
+    struct SVTL_VertexView w = *v;
+    w.positionType = type;
+    w.x = block->wide.bytes;
+    w.y = v->soa ? w.x + (size_t)ws * (WIDEN_BLOCK_VERTEX_COUNT + 1) : w.x + ws;
+    w.stride = v->soa ? ws : 2 * ws;
+    return w;
+}
+
+/*widens count positions of v starting at first into the block, starting at slot at*/
+static void widenBlock(struct SVTL_WidenBlock* block, const struct SVTL_VertexView* v, u32 first, u32 count, u32 at)
+{
+    const struct SVTL_VertexView w = wideBlockView(block, v);
+    const u32 cs = positionComponentSize(v->positionType);
+    const size_t offset = (size_t)v->stride * first;
+    if (v->soa) {
+        widenComponents(v->positionType, v->x + offset, w.x + (size_t)w.stride * at, count);
+        widenComponents(v->positionType, v->y + offset, w.y + (size_t)w.stride * at, count);
+        return;
     }
 
-    u8 i;
-    for (i = 0; i < TASK_COUNT; ++i)
-    {
-        SVTL_Task task;
-        struct SVTL_rotate2D_Args* fData = &argList[i];
-        fData->vi = vi;
-        fData->firstVertexIndex = i * (vi->count + 1) / TASK_COUNT;
-        fData->vertexCount = getSegmentSize(vi->count, TASK_COUNT, i);
-        fData->radians = radians;
-        fData->origin = origin;
-        task.args = fData;
-        task.func = SVTL_rotate2D_ThreadSegment;
-        launchTask(task,(u8*)taskHandles+(i*taskHandleSize));
+    const u8* in = v->x + offset;
+    if (v->stride != 2 * cs || v->y != v->x + cs) {
+        /*positions interleaved with other attributes are gathered into packed pairs first*/
+        u32 i;
+        for (i = 0; i < count; ++i) {
+            memcpy(block->raw.bytes + (size_t)2 * cs * i, v->x + offset + (size_t)v->stride * i, cs);
+            memcpy(block->raw.bytes + (size_t)2 * cs * i + cs, v->y + offset + (size_t)v->stride * i, cs);
+        }
+        in = block->raw.bytes;
     }
+    widenComponents(v->positionType, in, w.x + (size_t)w.stride * at, 2 * (size_t)count);
+}
 
-    for (i = 0; i < TASK_COUNT; ++i)
-    {
-        joinTask((u8*)taskHandles+(i*taskHandleSize));
+/*narrows the first count positions of the block back into v, starting at first*/
+static void narrowBlock(struct SVTL_WidenBlock* block, const struct SVTL_VertexView* v, u32 first, u32 count)
+{
+    const struct SVTL_VertexView w = wideBlockView(block, v);
+    const u32 cs = positionComponentSize(v->positionType);
+    const size_t offset = (size_t)v->stride * first;
+    if (v->soa) {
+        narrowComponents(v->positionType, w.x, v->x + offset, count);
+        narrowComponents(v->positionType, w.y, v->y + offset, count);
+        return;
     }
 
-    free(argList);
-    free(taskHandles);
-    return 0;
+    if (v->stride == 2 * cs && v->y == v->x + cs) {
+        narrowComponents(v->positionType, w.x, v->x + offset, 2 * (size_t)count);
+        return;
+    }
+    narrowComponents(v->positionType, w.x, block->raw.bytes, 2 * (size_t)count);
+    u32 i;
+    for (i = 0; i < count; ++i) {
+        memcpy(v->x + offset + (size_t)v->stride * i, block->raw.bytes + (size_t)2 * cs * i, cs);
+        memcpy(v->y + offset + (size_t)v->stride * i, block->raw.bytes + (size_t)2 * cs * i + cs, cs);
+    }
 }
 
+static void affinePositions(const struct SVTL_VertexView* v, u32 first, u32 count, const struct SVTL_F64Mat2x3* t)
+{
+    const size_t offset = (size_t)v->stride * first;
+    if (isCompactPositionType(v->positionType)) {
+        struct SVTL_WidenBlock block;
+        const struct SVTL_VertexView w = wideBlockView(&block, v);
+        const u32 end = first + count;
+        u32 b;
+        for (b = first; b < end; b += WIDEN_BLOCK_VERTEX_COUNT) {
+            const u32 n = end - b < WIDEN_BLOCK_VERTEX_COUNT ? end - b : WIDEN_BLOCK_VERTEX_COUNT;
+            widenBlock(&block, v, b, n, 0);
+            affinePositions(&w, 0, n, t);
+            narrowBlock(&block, v, b, n);
+        }
+    } else if (v->soa) {
+        if (v->positionType == SVTL_POS_TYPE_VEC2_F32)
+            Kernels_affine2DSoAF32((f32*)(v->x + offset), (f32*)(v->y + offset), count, t);
+        else
+            Kernels_affine2DSoAF64((f64*)(v->x + offset), (f64*)(v->y + offset), count, t);
+    } else {
+        if (v->positionType == SVTL_POS_TYPE_VEC2_F32)
+            Kernels_affine2DF32(v->x + offset, v->stride, count, t);
+        else
+            Kernels_affine2DF64(v->x + offset, v->stride, count, t);
+    }
+}
 
-struct SVTL_scale2D_Args
+static void homographyPositions(const struct SVTL_VertexView* v, u32 first, u32 count, const struct SVTL_F64Mat3x3* t)
 {
-    const struct SVTL_VertexInfo* vi;  u32 firstVertexIndex; u32 vertexCount; struct SVTL_F64Vec2 scaleFactor; struct SVTL_F64Vec2 origin;
-};
-static void* SVTL_scale2D_ThreadSegment(void* v)
-{
-    struct SVTL_scale2D_Args* args  = (struct SVTL_scale2D_Args*)v;
-    const struct SVTL_VertexInfo* vi = args->vi;
-    u32 firstVertexIndex = args->firstVertexIndex;
-    u32 vertexCount = args->vertexCount;
-    struct SVTL_F64Vec2 origin = args->origin;
-    struct SVTL_F64Vec2 scaleFactor = args->scaleFactor;
-    void* vertices = vi->vertices;
-
-    u32 i = firstVertexIndex;
-    const u32 end = firstVertexIndex + vertexCount;
-    if (vi->positionType == SVTL_POS_TYPE_VEC2_F32) {
-        for (; i < end; ++i)
-        {
-            struct SVTL_F32Vec2* pos = (struct SVTL_F32Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x -= (f32)origin.x;
-            pos->y -= (f32)origin.y;
-            pos->x *= (f32)scaleFactor.x;
-            pos->y *= (f32)scaleFactor.y;
-            pos->x += (f32)origin.x;
-            pos->y += (f32)origin.x;
+    const size_t offset = (size_t)v->stride * first;
+    if (isCompactPositionType(v->positionType)) {
+        struct SVTL_WidenBlock block;
+        const struct SVTL_VertexView w = wideBlockView(&block, v);
+        const u32 end = first + count;
+        u32 b;
+        for (b = first; b < end; b += WIDEN_BLOCK_VERTEX_COUNT) {
+            const u32 n = end - b < WIDEN_BLOCK_VERTEX_COUNT ? end - b : WIDEN_BLOCK_VERTEX_COUNT;
+            widenBlock(&block, v, b, n, 0);
+            homographyPositions(&w, 0, n, t);
+            narrowBlock(&block, v, b, n);
         }
+    } else if (v->soa) {
+        if (v->positionType == SVTL_POS_TYPE_VEC2_F32)
+            Kernels_homography2DSoAF32((f32*)(v->x + offset), (f32*)(v->y + offset), count, t);
+        else
+            Kernels_homography2DSoAF64((f64*)(v->x + offset), (f64*)(v->y + offset), count, t);
+    } else {
+        if (v->positionType == SVTL_POS_TYPE_VEC2_F32)
+            Kernels_homography2DF32(v->x + offset, v->stride, count, t);
+        else
+            Kernels_homography2DF64(v->x + offset, v->stride, count, t);
     }
-    else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64)
-    {
-        for (; i < end; ++i)
-        {
-            struct SVTL_F64Vec2* pos = (struct SVTL_F64Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x -= origin.x;
-            pos->y -= origin.y;
-            pos->x *= scaleFactor.x;
-            pos->y *= scaleFactor.y;
-            pos->x += origin.x;
-            pos->y += origin.x;
+}
+
+/*adds the shoelace terms of the edges first..first+count-1 of the closed polygon formed by the first total positions of v*/
+static void shoelacePositions(const struct SVTL_VertexView* v, u32 first, u32 count, u32 total, int centroid, f64 sums[3])
+{
+    if (isCompactPositionType(v->positionType)) {
+        /*each block is widened with the vertex following it, so its last edge closes within the block*/
+        struct SVTL_WidenBlock block;
+        const struct SVTL_VertexView w = wideBlockView(&block, v);
+        const u32 end = first + count;
+        u32 b;
+        for (b = first; b < end; b += WIDEN_BLOCK_VERTEX_COUNT) {
+            const u32 n = end - b < WIDEN_BLOCK_VERTEX_COUNT ? end - b : WIDEN_BLOCK_VERTEX_COUNT;
+            widenBlock(&block, v, b, n, 0);
+            widenBlock(&block, v, (b + n) % total, 1, n);
+            shoelacePositions(&w, 0, n, n + 1, centroid, sums);
         }
+    } else if (v->soa) {
+        if (v->positionType == SVTL_POS_TYPE_VEC2_F32)
+            Kernels_shoelace2DSoAF32((const f32*)v->x, (const f32*)v->y, first, count, total, centroid, sums);
+        else
+            Kernels_shoelace2DSoAF64((const f64*)v->x, (const f64*)v->y, first, count, total, centroid, sums);
+    } else {
+        if (v->positionType == SVTL_POS_TYPE_VEC2_F32)
+            Kernels_shoelace2DF32(v->x, v->stride, first, count, total, centroid, sums);
+        else
+            Kernels_shoelace2DF64(v->x, v->stride, first, count, total, centroid, sums);
     }
+}
+
+/*the leading members shared by every *_Args struct*/
+struct SVTL_SegmentArgs
+{
+    const void* vi; u32 first; u32 count;
+};
+
+/*the chunks a task has yet to run, [head, tail) relative to firstChunk. The task takes chunks from the head and idle tasks steal from the tail;
+both ends are packed into one word, head in the low 16 bits, so either is claimed with a single compare-and-swap*/
+struct SVTL_ChunkQueue
+{
+    struct SVTL_Dispatch* dispatch;
+    u32 taskIdx;
+    u32 firstChunk;
+    volatile u32 range;
+    u8 pad_[CACHE_LINE_SIZE - sizeof(void*) - 3 * sizeof(u32)]; /*each queue has a cache line to itself, as it is claimed from on every chunk*/
+};
+
+/*splits an operation over count elements into chunks, which are queued across one task per worker.
+Operations below the parallel threshold are run on the calling thread, with their arguments stored inline*/
+struct SVTL_Dispatch
+{
+    SVTL_Context ctx;
+    union {
+        u8 bytes[DISPATCH_INLINE_ARGS_SIZE];
+        f64 align_;
+        void* alignPtr_;
+    } inlineArgs;
+    struct SVTL_ScratchBlock* scratch;
+    u8* argList;
+    u8* taskHandles; /*one handle per task, or a single one when the tasks are launched as a batch*/
+    SVTL_Task* batchTasks; /*NULL unless the tasks are launched by the context's batch launch callback*/
+    struct SVTL_ChunkQueue* queues;
+    u8* chunkResults; /*chunkResultSize bytes per chunk, zeroed by beginDispatch*/
+    void* (*func)(void*);
+    size_t argSize;
+    size_t argStride;
+    size_t chunkResultSize;
+    u32 taskCount;
+    u32 launchedCount;
+    u32 count;
+    u32 chunkSize;
+    u32 chunkSkew;
+    u32 chunkCount;
+    struct SVTL_Fence_T* fence; /*NULL unless the operation was started by runDispatchAsync*/
+};
+
+/*wraps a task of an asynchronous operation, so its completion can be polled without the join callback*/
+struct SVTL_AsyncTask
+{
+    struct SVTL_Fence_T* fence;
+    void* (*func)(void*);
+    void* args;
+};
+
+/*an operation running in the background. The fence, its copy of the vertex view and its task wrappers share one scratch block,
+the task arguments and handles are held in a second one until SVTL_waitFence*/
+struct SVTL_Fence_T
+{
+    struct SVTL_Dispatch dispatch;
+    struct SVTL_VertexView view;
+    struct SVTL_ScratchBlock* block;
+    struct SVTL_AsyncTask* asyncTasks;
+    volatile u32 pendingCount;
+};
+
+static void* asyncTaskMain(void* v)
+{
+    struct SVTL_AsyncTask* task = v;
+    task->func(task->args);
+    ATOMIC_FETCH_ADD_U32(&task->fence->pendingCount, (u32)-1);
     return NULL;
 }
 
-SVTL_API errno_t SVTL_scale2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin)
+static u8* alignToCacheLine(u8* p)
 {
-    struct SVTL_scale2D_Args* argList = malloc(sizeof(struct SVTL_scale2D_Args) * TASK_COUNT);
-    SVTL_TaskHandle* taskHandles = malloc(taskHandleSize * TASK_COUNT);
-    if (!argList || !taskHandles) {
-        return -1;
+    return p + ((CACHE_LINE_SIZE - (uintptr_t)p % CACHE_LINE_SIZE) % CACHE_LINE_SIZE);
+}
+
+/*the number of elements of a strided array after which element offsets repeat within a cache line*/
+static u32 cacheLinePeriod(u32 stride)
+{
+    u32 lowBit = stride & (~stride + 1u);
+    if (lowBit == 0 || lowBit > CACHE_LINE_SIZE)
+        lowBit = CACHE_LINE_SIZE;
+    return CACHE_LINE_SIZE / lowBit;
+}
+
+/*spreads the chunks over the task queues, so the next launchDispatch runs every chunk again*/
+static void rewindDispatch(struct SVTL_Dispatch* d)
+{
+    u32 firstChunk = 0;
+    u32 i;
+    if (!d->queues)
+        return;
+    for (i = 0; i < d->taskCount; ++i) {
+        const u32 queued = getSegmentSize(d->chunkCount, d->taskCount, i);
+        d->queues[i].dispatch = d;
+        d->queues[i].taskIdx = i;
+        d->queues[i].firstChunk = firstChunk;
+        d->queues[i].range = queued << 16;
+        firstChunk += queued;
     }
+}
 
-    u8 i;
-    for (i = 0; i < TASK_COUNT; ++i)
+/*allocates the task arguments and copies argsTemplate into each of them.
+Chunks are a multiple of groupSize elements, and each task runs its segment function once per chunk with the same arguments,
+in whatever order it claims or steals them. Segments that reduce therefore write each chunk's result to dispatchChunkResult,
+chunkResultSize bytes per chunk, which the caller combines in chunk order so the result does not depend on the schedule.
+Each task's arguments start on a cache line of their own.
+When the segments write the vertices of a view, chunk boundaries are placed at the start of a cache line of its positions where the stride allows,
+so no two tasks write the same line.
+Per-task members may be set through dispatchArgs before launchDispatch*/
+static errno_t beginDispatch(struct SVTL_Dispatch* d, SVTL_Context ctx, const void* argsTemplate, size_t argSize,
+    const struct SVTL_VertexView* written, u32 count, u32 groupSize, size_t chunkResultSize)
+{
+    u32 groupCount = (count + groupSize - 1) / groupSize;
+    d->ctx = ctx;
+    d->taskCount = groupCount < ctx->workerCount ? groupCount : ctx->workerCount;
+    if (d->taskCount == 0)
+        d->taskCount = 1;
+    d->argSize = argSize;
+    d->argStride = argSize;
+    d->chunkResultSize = chunkResultSize;
+    d->count = count;
+    d->launchedCount = 0;
+    d->fence = NULL;
+    d->queues = NULL;
+    d->batchTasks = NULL;
+
+    /*enough chunks per task to even out uneven costs, each large enough to amortise claiming it*/
+    u32 chunkGroups = (groupCount + d->taskCount * DISPATCH_CHUNKS_PER_TASK - 1) / (d->taskCount * DISPATCH_CHUNKS_PER_TASK);
+    const u32 minChunkGroups = (DISPATCH_MIN_CHUNK_SIZE + groupSize - 1) / groupSize;
+    if (chunkGroups < minChunkGroups)
+        chunkGroups = minChunkGroups;
+
+    /*chunk c runs from c * chunkSize - chunkSkew, so with chunkSize a multiple of the period,
+    every boundary falls on the first element that starts a cache line*/
+    d->chunkSkew = 0;
+    if (written)
     {
-        SVTL_Task task;
-        struct SVTL_scale2D_Args* fData = &argList[i];
-        fData->vi = vi;
-        fData->firstVertexIndex = i * (vi->count + 1) / TASK_COUNT;
-        fData->vertexCount = getSegmentSize(vi->count, TASK_COUNT, i);
-        fData->scaleFactor = scaleFactor;
-        fData->origin = origin;
-        task.args = fData;
-        task.func = SVTL_scale2D_ThreadSegment;
-        launchTask(task,(u8*)taskHandles+(i*taskHandleSize));
+        const u32 period = cacheLinePeriod(written->stride);
+        chunkGroups = (chunkGroups + period - 1) / period * period;
+        u32 i;
+        for (i = 0; i < period; ++i) {
+            if (((uintptr_t)written->x + (uintptr_t)i * written->stride) % CACHE_LINE_SIZE == 0) {
+                d->chunkSkew = (period - i) % period / groupSize * groupSize;
+                break;
+            }
+        }
     }
+    d->chunkSize = chunkGroups * groupSize;
+    const u32 chunkCount = (u32)(((u64)count + d->chunkSkew + d->chunkSize - 1) / d->chunkSize);
+    if (d->taskCount > chunkCount)
+        d->taskCount = chunkCount;
 
-    for (i = 0; i < TASK_COUNT; ++i)
+    if (count < ctx->parallelThreshold || d->taskCount <= 1)
+    {
+        /*the operation runs as a single chunk, whose result follows the arguments*/
+        const size_t resultOffset = (argSize + sizeof(f64) - 1) / sizeof(f64) * sizeof(f64);
+        assert(resultOffset + chunkResultSize <= DISPATCH_INLINE_ARGS_SIZE);
+        d->taskCount = 1;
+        d->chunkCount = 1;
+        d->scratch = NULL;
+        d->argList = d->inlineArgs.bytes;
+        d->taskHandles = NULL;
+        d->chunkResults = d->inlineArgs.bytes + resultOffset;
+    }
+    else
     {
-        joinTask((u8*)taskHandles+(i*taskHandleSize));
+        /*task handles follow the arguments, sized by the launch callback's taskHandleSize, and the chunk queues follow the handles.
+        A batch launch also needs the list of tasks it is given, and the chunk results come last*/
+        const bool batched = ctx->launchTaskBatch != NULL;
+        d->argStride = (argSize + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+        size_t argBytes = d->argStride * d->taskCount;
+        size_t handleBytes = ((size_t)ctx->taskHandleSize * (batched ? 1u : d->taskCount) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+        size_t queueBytes = sizeof(struct SVTL_ChunkQueue) * d->taskCount;
+        size_t batchBytes = batched ? (sizeof(SVTL_Task) * d->taskCount + sizeof(f64) - 1) / sizeof(f64) * sizeof(f64) : 0u;
+        d->scratch = acquireScratch(ctx, CACHE_LINE_SIZE + argBytes + handleBytes + queueBytes + batchBytes + chunkResultSize * chunkCount);
+        if (!d->scratch)
+            return -1;
+        d->chunkCount = chunkCount;
+        d->argList = alignToCacheLine(scratchData(d->scratch));
+        d->taskHandles = d->argList + argBytes;
+        d->queues = (struct SVTL_ChunkQueue*)(d->taskHandles + handleBytes);
+        if (batched)
+            d->batchTasks = (SVTL_Task*)((u8*)d->queues + queueBytes);
+        d->chunkResults = (u8*)d->queues + queueBytes + batchBytes;
+        rewindDispatch(d);
     }
 
-    free(argList);
-    free(taskHandles);
+    u32 i;
+    for (i = 0; i < d->taskCount; ++i)
+        memcpy(d->argList + i * d->argStride, argsTemplate, argSize);
+    memset(d->chunkResults, 0, chunkResultSize * d->chunkCount);
     return 0;
 }
-struct SVTL_skew2D_Args
-{
-    const struct SVTL_VertexInfo* vi;  u32 firstVertexIndex; u32 vertexCount; struct SVTL_F64Vec2 skewFactor; struct SVTL_F64Vec2 origin;
-};
 
-
-static void* SVTL_skew2D_ThreadSegment(void *v)
+static void* dispatchArgs(const struct SVTL_Dispatch* d, u32 taskIdx)
 {
-    DBG_VALIDATE_INSTANCE_USAGE();
+    return d->argList + taskIdx * d->argStride;
+}
 
-    struct SVTL_skew2D_Args* args  = (struct SVTL_skew2D_Args*)v;
+static void* dispatchChunkResult(const struct SVTL_Dispatch* d, u32 chunk)
+{
+    return d->chunkResults + chunk * d->chunkResultSize;
+}
+
+/*the chunk a segment starting at first runs, for dispatches whose chunks are not aligned to a written view*/
+static u32 chunkOfSegment(u32 first, u32 chunkSize)
+{
+    return first / chunkSize;
+}
+
+/*claims the chunk at the head of the queue, or at the tail when stealing. Returns false once the queue is empty*/
+static bool claimChunk(struct SVTL_ChunkQueue* q, bool steal, u32* chunkOut)
+{
+    for (;;)
+    {
+        const u32 range = ATOMIC_LOAD_U32(&q->range);
+        const u32 head = range & 0xFFFFu;
+        const u32 tail = range >> 16;
+        if (head >= tail)
+            return false;
+        if (ATOMIC_CAS_U32(&q->range, range, steal ? range - 0x10000u : range + 1u)) {
+            *chunkOut = q->firstChunk + (steal ? tail - 1 : head);
+            return true;
+        }
+    }
+}
+
+static void runChunk(const struct SVTL_Dispatch* d, struct SVTL_SegmentArgs* seg, u32 chunk)
+{
+    const u64 end = (u64)(chunk + 1) * d->chunkSize - d->chunkSkew;
+    seg->first = chunk == 0 ? 0u : (u32)((u64)chunk * d->chunkSize - d->chunkSkew);
+    seg->count = (u32)(end < d->count ? end : d->count) - seg->first;
+    d->func(seg);
+}
+
+/*runs the chunks of the task's own queue, then steals from the other queues until every queue is empty.
+Queues are never refilled, so one pass over the others is enough*/
+static void* dispatchTaskMain(void* v)
+{
+    struct SVTL_ChunkQueue* q = v;
+    const struct SVTL_Dispatch* d = q->dispatch;
+    struct SVTL_SegmentArgs* seg = dispatchArgs(d, q->taskIdx);
+    u32 chunk;
+    while (claimChunk(q, false, &chunk))
+        runChunk(d, seg, chunk);
+
+    u32 i;
+    for (i = 1; i < d->taskCount; ++i) {
+        struct SVTL_ChunkQueue* victim = &d->queues[(q->taskIdx + i) % d->taskCount];
+        while (claimChunk(victim, true, &chunk))
+            runChunk(d, seg, chunk);
+    }
+    return NULL;
+}
+
+/*launches one task per chunk queue, or runs the whole operation as one segment when it has no queues.
+If a task cannot be launched, it and the remaining tasks are run on the calling thread, as are all of them if a batch cannot be launched*/
+static void launchDispatch(struct SVTL_Dispatch* d, void*(*func)(void*))
+{
+    u32 i;
+    d->func = func;
+    d->launchedCount = 0;
+    for (i = 0; i < d->taskCount; ++i)
+    {
+        SVTL_Task task;
+        if (d->queues) {
+            task.args = &d->queues[i];
+            task.func = dispatchTaskMain;
+        } else {
+            struct SVTL_SegmentArgs* seg = dispatchArgs(d, i);
+            seg->first = 0;
+            seg->count = d->count;
+            task.args = seg;
+            task.func = func;
+        }
+        if (d->fence) {
+            struct SVTL_AsyncTask* asyncTask = &d->fence->asyncTasks[i];
+            asyncTask->fence = d->fence;
+            asyncTask->func = task.func;
+            asyncTask->args = task.args;
+            task.args = asyncTask;
+            task.func = asyncTaskMain;
+        }
+        if (d->batchTasks)
+            d->batchTasks[i] = task;
+        else if (d->taskHandles && d->launchedCount == i && contextLaunchTask(d->ctx, task, d->taskHandles + i * d->ctx->taskHandleSize) == 0)
+            d->launchedCount++;
+        else
+            task.func(task.args);
+    }
+
+    if (d->batchTasks)
+    {
+        if (contextLaunchTaskBatch(d->ctx, d->batchTasks, d->taskCount, d->taskHandles) == 0) {
+            d->launchedCount = d->taskCount;
+        } else {
+            for (i = 0; i < d->taskCount; ++i)
+                d->batchTasks[i].func(d->batchTasks[i].args);
+        }
+    }
+}
+
+/*waits for every task. The task arguments stay readable until releaseDispatch*/
+static errno_t joinDispatch(struct SVTL_Dispatch* d)
+{
+    errno_t err = 0;
+    u32 i;
+    if (d->batchTasks) {
+        if (d->launchedCount && contextJoinTaskBatch(d->ctx, d->taskHandles))
+            err = -1;
+        d->launchedCount = 0;
+        return err;
+    }
+    for (i = 0; i < d->launchedCount; ++i) {
+        if (contextJoinTask(d->ctx, d->taskHandles + i * d->ctx->taskHandleSize))
+            err = -1;
+    }
+    d->launchedCount = 0;
+    return err;
+}
+
+static void releaseDispatch(struct SVTL_Dispatch* d)
+{
+    if (d->scratch)
+        releaseScratch(d->ctx, d->scratch);
+}
+
+/*runs func over count elements across the workers and waits for it to complete.
+written is the view the segments write, whose cache lines the chunks are aligned to, or NULL*/
+static errno_t runDispatch(SVTL_Context ctx, void*(*func)(void*), const void* argsTemplate, size_t argSize,
+    const struct SVTL_VertexView* written, u32 count)
+{
+    struct SVTL_Dispatch d;
+    if (beginDispatch(&d, ctx, argsTemplate, argSize, written, count, 1, 0))
+        return -1;
+    launchDispatch(&d, func);
+    errno_t err = joinDispatch(&d);
+    releaseDispatch(&d);
+    return err;
+}
+
+/*starts func over count elements across the workers and returns without waiting for it.
+The view is copied into the fence, so the caller's vertex info may go out of scope; the vertices themselves may not.
+The segments are taken to write the view, and chunks are aligned to its cache lines*/
+static errno_t runDispatchAsync(SVTL_Context ctx, void*(*func)(void*), const void* argsTemplate, size_t argSize,
+    const struct SVTL_VertexView* view, u32 count, SVTL_Fence* fenceOut)
+{
+    /*the worker count bounds the task count*/
+    struct SVTL_ScratchBlock* block = acquireScratch(ctx, sizeof(struct SVTL_Fence_T) + sizeof(struct SVTL_AsyncTask) * ctx->workerCount);
+    if (!block)
+        return -1;
+    struct SVTL_Fence_T* fence = (struct SVTL_Fence_T*)scratchData(block);
+    fence->view = *view;
+    fence->block = block;
+    fence->asyncTasks = (struct SVTL_AsyncTask*)(fence + 1);
+    if (beginDispatch(&fence->dispatch, ctx, argsTemplate, argSize, view, count, 1, 0)) {
+        releaseScratch(ctx, block);
+        return -1;
+    }
+    fence->dispatch.fence = fence;
+    fence->pendingCount = fence->dispatch.taskCount;
+
+    u32 i;
+    for (i = 0; i < fence->dispatch.taskCount; ++i)
+        ((struct SVTL_SegmentArgs*)dispatchArgs(&fence->dispatch, i))->vi = &fence->view;
+
+    launchDispatch(&fence->dispatch, func);
+    *fenceOut = fence;
+    return 0;
+}
+
+SVTL_API bool SVTL_pollFence(SVTL_Fence fence)
+{
+    return ATOMIC_LOAD_U32(&fence->pendingCount) == 0u;
+}
+
+SVTL_API errno_t SVTL_waitFence(SVTL_Fence fence)
+{
+    SVTL_Context ctx = fence->dispatch.ctx;
+    errno_t err = joinDispatch(&fence->dispatch);
+    releaseDispatch(&fence->dispatch);
+    releaseScratch(ctx, fence->block);
+    return err;
+}
+
+SVTL_API errno_t SVTL_translate2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 displacement)
+{
+    return SVTL_applyAffine2DCtx(ctx, vi, SVTL_mat2x3Translate(displacement));
+}
+
+SVTL_API errno_t SVTL_translate2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 displacement)
+{
+    return SVTL_translate2DCtx(&defaultContext, vi, displacement);
+}
+
+SVTL_API errno_t SVTL_translate2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 displacement, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DAsyncCtx(ctx, vi, SVTL_mat2x3Translate(displacement), fenceOut);
+}
+
+SVTL_API errno_t SVTL_translate2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 displacement, SVTL_Fence* fenceOut)
+{
+    return SVTL_translate2DAsyncCtx(&defaultContext, vi, displacement, fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, f64 radians, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_applyAffine2DCtx(ctx, vi, SVTL_mat2x3Rotate(radians, origin));
+}
+
+SVTL_API errno_t SVTL_rotate2D(const struct SVTL_VertexInfo* vi, f64 radians, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_rotate2DCtx(&defaultContext, vi, radians, origin);
+}
+
+SVTL_API errno_t SVTL_rotate2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, f64 radians, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DAsyncCtx(ctx, vi, SVTL_mat2x3Rotate(radians, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate2DAsync(const struct SVTL_VertexInfo* vi, f64 radians, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_rotate2DAsyncCtx(&defaultContext, vi, radians, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_scale2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_applyAffine2DCtx(ctx, vi, SVTL_mat2x3Scale(scaleFactor, origin));
+}
+
+SVTL_API errno_t SVTL_scale2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_scale2DCtx(&defaultContext, vi, scaleFactor, origin);
+}
+
+SVTL_API errno_t SVTL_scale2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DAsyncCtx(ctx, vi, SVTL_mat2x3Scale(scaleFactor, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_scale2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_scale2DAsyncCtx(&defaultContext, vi, scaleFactor, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_skew2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_applyAffine2DCtx(ctx, vi, SVTL_mat2x3Skew(skewFactor, origin));
+}
+
+SVTL_API errno_t SVTL_skew2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_skew2DCtx(&defaultContext, vi, skewFactor, origin);
+}
+
+SVTL_API errno_t SVTL_skew2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DAsyncCtx(ctx, vi, SVTL_mat2x3Skew(skewFactor, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_skew2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_skew2DAsyncCtx(&defaultContext, vi, skewFactor, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_mirror2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Line2 mirrorLine)
+{
+    return SVTL_applyAffine2DCtx(ctx, vi, SVTL_mat2x3Mirror(mirrorLine));
+}
+
+SVTL_API errno_t SVTL_mirror2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Line2 mirrorLine)
+{
+    return SVTL_mirror2DCtx(&defaultContext, vi, mirrorLine);
+}
+
+SVTL_API errno_t SVTL_mirror2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Line2 mirrorLine, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DAsyncCtx(ctx, vi, SVTL_mat2x3Mirror(mirrorLine), fenceOut);
+}
+
+SVTL_API errno_t SVTL_mirror2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Line2 mirrorLine, SVTL_Fence* fenceOut)
+{
+    return SVTL_mirror2DAsyncCtx(&defaultContext, vi, mirrorLine, fenceOut);
+}
+
+SVTL_API errno_t SVTL_translate2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 displacement)
+{
+    return SVTL_applyAffine2DSoACtx(ctx, vi, SVTL_mat2x3Translate(displacement));
+}
+
+SVTL_API errno_t SVTL_translate2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 displacement)
+{
+    return SVTL_translate2DSoACtx(&defaultContext, vi, displacement);
+}
+
+SVTL_API errno_t SVTL_translate2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 displacement, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DSoAAsyncCtx(ctx, vi, SVTL_mat2x3Translate(displacement), fenceOut);
+}
+
+SVTL_API errno_t SVTL_translate2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 displacement, SVTL_Fence* fenceOut)
+{
+    return SVTL_translate2DSoAAsyncCtx(&defaultContext, vi, displacement, fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, f64 radians, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_applyAffine2DSoACtx(ctx, vi, SVTL_mat2x3Rotate(radians, origin));
+}
+
+SVTL_API errno_t SVTL_rotate2DSoA(const struct SVTL_VertexInfoSoA* vi, f64 radians, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_rotate2DSoACtx(&defaultContext, vi, radians, origin);
+}
+
+SVTL_API errno_t SVTL_rotate2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, f64 radians, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DSoAAsyncCtx(ctx, vi, SVTL_mat2x3Rotate(radians, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, f64 radians, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_rotate2DSoAAsyncCtx(&defaultContext, vi, radians, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_scale2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_applyAffine2DSoACtx(ctx, vi, SVTL_mat2x3Scale(scaleFactor, origin));
+}
+
+SVTL_API errno_t SVTL_scale2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_scale2DSoACtx(&defaultContext, vi, scaleFactor, origin);
+}
+
+SVTL_API errno_t SVTL_scale2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DSoAAsyncCtx(ctx, vi, SVTL_mat2x3Scale(scaleFactor, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_scale2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_scale2DSoAAsyncCtx(&defaultContext, vi, scaleFactor, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_skew2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_applyAffine2DSoACtx(ctx, vi, SVTL_mat2x3Skew(skewFactor, origin));
+}
+
+SVTL_API errno_t SVTL_skew2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_skew2DSoACtx(&defaultContext, vi, skewFactor, origin);
+}
+
+SVTL_API errno_t SVTL_skew2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DSoAAsyncCtx(ctx, vi, SVTL_mat2x3Skew(skewFactor, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_skew2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_skew2DSoAAsyncCtx(&defaultContext, vi, skewFactor, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_mirror2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Line2 mirrorLine)
+{
+    return SVTL_applyAffine2DSoACtx(ctx, vi, SVTL_mat2x3Mirror(mirrorLine));
+}
+
+SVTL_API errno_t SVTL_mirror2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Line2 mirrorLine)
+{
+    return SVTL_mirror2DSoACtx(&defaultContext, vi, mirrorLine);
+}
+
+SVTL_API errno_t SVTL_mirror2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Line2 mirrorLine, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DSoAAsyncCtx(ctx, vi, SVTL_mat2x3Mirror(mirrorLine), fenceOut);
+}
+
+SVTL_API errno_t SVTL_mirror2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Line2 mirrorLine, SVTL_Fence* fenceOut)
+{
+    return SVTL_mirror2DSoAAsyncCtx(&defaultContext, vi, mirrorLine, fenceOut);
+}
+
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Identity(void)
+{
+    struct SVTL_F64Mat2x3 m = {{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}}};
+    return m;
+}
+
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Multiply(struct SVTL_F64Mat2x3 lhs, struct SVTL_F64Mat2x3 rhs)
+{
+    struct SVTL_F64Mat2x3 r;
+    u8 row;
+    for (row = 0; row < 2; ++row)
+    {
+        r.m[row][0] = lhs.m[row][0] * rhs.m[0][0] + lhs.m[row][1] * rhs.m[1][0];
+        r.m[row][1] = lhs.m[row][0] * rhs.m[0][1] + lhs.m[row][1] * rhs.m[1][1];
+        r.m[row][2] = lhs.m[row][0] * rhs.m[0][2] + lhs.m[row][1] * rhs.m[1][2] + lhs.m[row][2];
+    }
+    return r;
+}
+
+/*builds the matrix for the linear part l about origin o: p' = l(p - o) + o*/
+static struct SVTL_F64Mat2x3 aboutOrigin(f64 a, f64 b, f64 c, f64 d, struct SVTL_F64Vec2 o)
+{
+    struct SVTL_F64Mat2x3 m;
+    m.m[0][0] = a; m.m[0][1] = b; m.m[0][2] = o.x - (a * o.x + b * o.y);
+    m.m[1][0] = c; m.m[1][1] = d; m.m[1][2] = o.y - (c * o.x + d * o.y);
+    return m;
+}
+
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Translate(struct SVTL_F64Vec2 displacement)
+{
+    struct SVTL_F64Mat2x3 m = SVTL_mat2x3Identity();
+    m.m[0][2] = displacement.x;
+    m.m[1][2] = displacement.y;
+    return m;
+}
+
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Rotate(f64 radians, struct SVTL_F64Vec2 origin)
+{
+    f64 c = cos(radians);
+    f64 s = sin(radians);
+    return aboutOrigin(c, -s, s, c, origin);
+}
+
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Scale(struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin)
+{
+    return aboutOrigin(scaleFactor.x, 0.0, 0.0, scaleFactor.y, origin);
+}
+
+/*x is sheared first, and y by the sheared x: y' = y + ky * (x + kx * y) = ky * x + (1 + kx * ky) * y*/
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Skew(struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin)
+{
+    return aboutOrigin(1.0, skewFactor.x, skewFactor.y, 1.0 + skewFactor.x * skewFactor.y, origin);
+}
+
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Mirror(struct SVTL_F64Line2 mirrorLine)
+{
+    /*reflection across a line through the center at angle dir*/
+    f64 c = cos(2.0 * mirrorLine.dir);
+    f64 s = sin(2.0 * mirrorLine.dir);
+    return aboutOrigin(c, s, s, -c, mirrorLine.center);
+}
+
+struct SVTL_applyAffine2D_Args
+{
+    const struct SVTL_VertexView* vi; u32 firstVertexIndex; u32 vertexCount; struct SVTL_F64Mat2x3 transform;
+};
+DISPATCH_ARGS_FIT(SVTL_applyAffine2D_Args);
+static void* SVTL_applyAffine2D_ThreadSegment(void* __args)
+{
+    struct SVTL_applyAffine2D_Args* args = __args;
+    affinePositions(args->vi, args->firstVertexIndex, args->vertexCount, &args->transform);
+    return NULL;
+}
+
+static errno_t applyAffine2D(SVTL_Context ctx, const struct SVTL_VertexView* view, struct SVTL_F64Mat2x3 transform)
+{
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
+
+    struct SVTL_applyAffine2D_Args args;
+    args.vi = view;
+    args.transform = transform;
+    return runDispatch(ctx, SVTL_applyAffine2D_ThreadSegment, &args, sizeof(args), view, view->count);
+}
+
+static errno_t applyAffine2DAsync(SVTL_Context ctx, const struct SVTL_VertexView* view, struct SVTL_F64Mat2x3 transform, SVTL_Fence* fenceOut)
+{
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
+
+    struct SVTL_applyAffine2D_Args args;
+    args.vi = view;
+    args.transform = transform;
+    return runDispatchAsync(ctx, SVTL_applyAffine2D_ThreadSegment, &args, sizeof(args), view, view->count, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat2x3 transform)
+{
+    const struct SVTL_VertexView view = viewOf(vi);
+    return applyAffine2D(ctx, &view, transform);
+}
+
+SVTL_API errno_t SVTL_applyAffine2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat2x3 transform)
+{
+    return SVTL_applyAffine2DCtx(&defaultContext, vi, transform);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat2x3 transform, SVTL_Fence* fenceOut)
+{
+    const struct SVTL_VertexView view = viewOf(vi);
+    return applyAffine2DAsync(ctx, &view, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat2x3 transform, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DAsyncCtx(&defaultContext, vi, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat2x3 transform)
+{
+    const struct SVTL_VertexView view = viewOfSoA(vi);
+    return applyAffine2D(ctx, &view, transform);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat2x3 transform)
+{
+    return SVTL_applyAffine2DSoACtx(&defaultContext, vi, transform);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat2x3 transform, SVTL_Fence* fenceOut)
+{
+    const struct SVTL_VertexView view = viewOfSoA(vi);
+    return applyAffine2DAsync(ctx, &view, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat2x3 transform, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DSoAAsyncCtx(&defaultContext, vi, transform, fenceOut);
+}
+
+SVTL_API struct SVTL_F64Mat3x3 SVTL_mat3x3Identity(void)
+{
+    const struct SVTL_F64Mat3x3 m = { { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } } };
+    return m;
+}
+
+SVTL_API struct SVTL_F64Mat3x3 SVTL_mat3x3Multiply(struct SVTL_F64Mat3x3 lhs, struct SVTL_F64Mat3x3 rhs)
+{
+    struct SVTL_F64Mat3x3 r;
+    u32 i, j;
+    for (i = 0; i < 3; ++i)
+        for (j = 0; j < 3; ++j)
+            r.m[i][j] = lhs.m[i][0] * rhs.m[0][j] + lhs.m[i][1] * rhs.m[1][j] + lhs.m[i][2] * rhs.m[2][j];
+    return r;
+}
+
+SVTL_API struct SVTL_F64Mat3x3 SVTL_mat3x3FromAffine(struct SVTL_F64Mat2x3 transform)
+{
+    const struct SVTL_F64Mat3x3 m = { {
+        { transform.m[0][0], transform.m[0][1], transform.m[0][2] },
+        { transform.m[1][0], transform.m[1][1], transform.m[1][2] },
+        { 0.0, 0.0, 1.0 } } };
+    return m;
+}
+
+struct SVTL_applyHomography2D_Args
+{
+    const struct SVTL_VertexView* vi; u32 firstVertexIndex; u32 vertexCount; struct SVTL_F64Mat3x3 transform;
+};
+DISPATCH_ARGS_FIT(SVTL_applyHomography2D_Args);
+static void* SVTL_applyHomography2D_ThreadSegment(void* __args)
+{
+    struct SVTL_applyHomography2D_Args* args = __args;
+    homographyPositions(args->vi, args->firstVertexIndex, args->vertexCount, &args->transform);
+    return NULL;
+}
+
+/*a bottom row of (0, 0, 1) leaves w at 1, so the transform is affine and runs without the division*/
+static bool isAffineHomography(const struct SVTL_F64Mat3x3* t, struct SVTL_F64Mat2x3* affineOut)
+{
+    if (t->m[2][0] != 0.0 || t->m[2][1] != 0.0 || t->m[2][2] != 1.0)
+        return false;
+    u32 i;
+    for (i = 0; i < 3; ++i) {
+        affineOut->m[0][i] = t->m[0][i];
+        affineOut->m[1][i] = t->m[1][i];
+    }
+    return true;
+}
+
+static errno_t applyHomography2D(SVTL_Context ctx, const struct SVTL_VertexView* view, struct SVTL_F64Mat3x3 transform)
+{
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
+
+    struct SVTL_F64Mat2x3 affine;
+    if (isAffineHomography(&transform, &affine))
+        return applyAffine2D(ctx, view, affine);
+
+    struct SVTL_applyHomography2D_Args args;
+    args.vi = view;
+    args.transform = transform;
+    return runDispatch(ctx, SVTL_applyHomography2D_ThreadSegment, &args, sizeof(args), view, view->count);
+}
+
+static errno_t applyHomography2DAsync(SVTL_Context ctx, const struct SVTL_VertexView* view, struct SVTL_F64Mat3x3 transform, SVTL_Fence* fenceOut)
+{
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
+
+    struct SVTL_F64Mat2x3 affine;
+    if (isAffineHomography(&transform, &affine))
+        return applyAffine2DAsync(ctx, view, affine, fenceOut);
+
+    struct SVTL_applyHomography2D_Args args;
+    args.vi = view;
+    args.transform = transform;
+    return runDispatchAsync(ctx, SVTL_applyHomography2D_ThreadSegment, &args, sizeof(args), view, view->count, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyHomography2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat3x3 transform)
+{
+    const struct SVTL_VertexView view = viewOf(vi);
+    return applyHomography2D(ctx, &view, transform);
+}
+
+SVTL_API errno_t SVTL_applyHomography2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat3x3 transform)
+{
+    return SVTL_applyHomography2DCtx(&defaultContext, vi, transform);
+}
+
+SVTL_API errno_t SVTL_applyHomography2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat3x3 transform, SVTL_Fence* fenceOut)
+{
+    const struct SVTL_VertexView view = viewOf(vi);
+    return applyHomography2DAsync(ctx, &view, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyHomography2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat3x3 transform, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyHomography2DAsyncCtx(&defaultContext, vi, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyHomography2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat3x3 transform)
+{
+    const struct SVTL_VertexView view = viewOfSoA(vi);
+    return applyHomography2D(ctx, &view, transform);
+}
+
+SVTL_API errno_t SVTL_applyHomography2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat3x3 transform)
+{
+    return SVTL_applyHomography2DSoACtx(&defaultContext, vi, transform);
+}
+
+SVTL_API errno_t SVTL_applyHomography2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat3x3 transform, SVTL_Fence* fenceOut)
+{
+    const struct SVTL_VertexView view = viewOfSoA(vi);
+    return applyHomography2DAsync(ctx, &view, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyHomography2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat3x3 transform, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyHomography2DSoAAsyncCtx(&defaultContext, vi, transform, fenceOut);
+}
+
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Identity(void)
+{
+    struct SVTL_F64Mat4x4 m = {{{1.0, 0.0, 0.0, 0.0}, {0.0, 1.0, 0.0, 0.0}, {0.0, 0.0, 1.0, 0.0}, {0.0, 0.0, 0.0, 1.0}}};
+    return m;
+}
+
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Multiply(struct SVTL_F64Mat4x4 lhs, struct SVTL_F64Mat4x4 rhs)
+{
+    struct SVTL_F64Mat4x4 r;
+    u8 row, col;
+    for (row = 0; row < 4; ++row)
+    {
+        for (col = 0; col < 4; ++col)
+            r.m[row][col] = lhs.m[row][0] * rhs.m[0][col] + lhs.m[row][1] * rhs.m[1][col] + lhs.m[row][2] * rhs.m[2][col] + lhs.m[row][3] * rhs.m[3][col];
+    }
+    return r;
+}
+
+/*builds the matrix for the linear part l about origin o: p' = l(p - o) + o*/
+static struct SVTL_F64Mat4x4 aboutOrigin3D(const f64 l[3][3], struct SVTL_F64Vec3 o)
+{
+    struct SVTL_F64Mat4x4 m = SVTL_mat4x4Identity();
+    u8 row;
+    for (row = 0; row < 3; ++row)
+    {
+        const f64 oRow = row == 0 ? o.x : row == 1 ? o.y : o.z;
+        m.m[row][0] = l[row][0];
+        m.m[row][1] = l[row][1];
+        m.m[row][2] = l[row][2];
+        m.m[row][3] = oRow - (l[row][0] * o.x + l[row][1] * o.y + l[row][2] * o.z);
+    }
+    return m;
+}
+
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Translate(struct SVTL_F64Vec3 displacement)
+{
+    struct SVTL_F64Mat4x4 m = SVTL_mat4x4Identity();
+    m.m[0][3] = displacement.x;
+    m.m[1][3] = displacement.y;
+    m.m[2][3] = displacement.z;
+    return m;
+}
+
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Rotate(struct SVTL_F64Vec3 axis, f64 radians, struct SVTL_F64Vec3 origin)
+{
+    const f64 length = sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    if (length == 0.0)
+        return SVTL_mat4x4Identity();
+
+    /*Rodrigues' rotation formula: l = cI + s[a]x + (1 - c)aa^T for the unit axis a*/
+    const f64 x = axis.x / length, y = axis.y / length, z = axis.z / length;
+    const f64 c = cos(radians);
+    const f64 s = sin(radians);
+    const f64 t = 1.0 - c;
+    const f64 l[3][3] = {
+        {t * x * x + c, t * x * y - s * z, t * x * z + s * y},
+        {t * x * y + s * z, t * y * y + c, t * y * z - s * x},
+        {t * x * z - s * y, t * y * z + s * x, t * z * z + c}};
+    return aboutOrigin3D(l, origin);
+}
+
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4RotateQuat(struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin)
+{
+    const f64 lengthSq = rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z + rotation.w * rotation.w;
+    if (lengthSq == 0.0)
+        return SVTL_mat4x4Identity();
+
+    /*scaling the products by 2 / |q|^2 normalizes the quaternion*/
+    const f64 k = 2.0 / lengthSq;
+    const f64 x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+    const f64 l[3][3] = {
+        {1.0 - k * (y * y + z * z), k * (x * y - w * z), k * (x * z + w * y)},
+        {k * (x * y + w * z), 1.0 - k * (x * x + z * z), k * (y * z - w * x)},
+        {k * (x * z - w * y), k * (y * z + w * x), 1.0 - k * (x * x + y * y)}};
+    return aboutOrigin3D(l, origin);
+}
+
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Scale(struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin)
+{
+    const f64 l[3][3] = {
+        {scaleFactor.x, 0.0, 0.0},
+        {0.0, scaleFactor.y, 0.0},
+        {0.0, 0.0, scaleFactor.z}};
+    return aboutOrigin3D(l, origin);
+}
+
+struct SVTL_applyAffine3D_Args
+{
+    const struct SVTL_VertexView* vi; u32 firstVertexIndex; u32 vertexCount; struct SVTL_F64Mat4x4 transform;
+};
+DISPATCH_ARGS_FIT(SVTL_applyAffine3D_Args);
+static void* SVTL_applyAffine3D_ThreadSegment(void* __args)
+{
+    struct SVTL_applyAffine3D_Args* args = __args;
+    const struct SVTL_VertexView* vi = args->vi;
+    const size_t offset = (size_t)vi->stride * args->firstVertexIndex;
+
+    if (vi->soa) {
+        if (vi->positionType == SVTL_POS_TYPE_VEC2_F32)
+            Kernels_affine3DSoAF32((f32*)(vi->x + offset), (f32*)(vi->y + offset), (f32*)(vi->z + offset), args->vertexCount, &args->transform);
+        else
+            Kernels_affine3DSoAF64((f64*)(vi->x + offset), (f64*)(vi->y + offset), (f64*)(vi->z + offset), args->vertexCount, &args->transform);
+    } else {
+        if (vi->positionType == SVTL_POS_TYPE_VEC2_F32)
+            Kernels_affine3DF32(vi->x + offset, vi->stride, args->vertexCount, &args->transform);
+        else
+            Kernels_affine3DF64(vi->x + offset, vi->stride, args->vertexCount, &args->transform);
+    }
+    return NULL;
+}
+
+static errno_t initAffine3DArgs(struct SVTL_applyAffine3D_Args* args, const struct SVTL_VertexView* view, struct SVTL_F64Mat4x4 transform)
+{
+    if (!view->z)
+        return -1;
+    if (transform.m[3][0] != 0.0 || transform.m[3][1] != 0.0 || transform.m[3][2] != 0.0 || transform.m[3][3] != 1.0)
+        return -1;
+    args->vi = view;
+    args->transform = transform;
+    return 0;
+}
+
+static errno_t applyAffine3D(SVTL_Context ctx, const struct SVTL_VertexView* view, struct SVTL_F64Mat4x4 transform)
+{
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
+
+    struct SVTL_applyAffine3D_Args args;
+    if (initAffine3DArgs(&args, view, transform))
+        return -1;
+    return runDispatch(ctx, SVTL_applyAffine3D_ThreadSegment, &args, sizeof(args), view, view->count);
+}
+
+static errno_t applyAffine3DAsync(SVTL_Context ctx, const struct SVTL_VertexView* view, struct SVTL_F64Mat4x4 transform, SVTL_Fence* fenceOut)
+{
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
+
+    struct SVTL_applyAffine3D_Args args;
+    if (initAffine3DArgs(&args, view, transform))
+        return -1;
+    return runDispatchAsync(ctx, SVTL_applyAffine3D_ThreadSegment, &args, sizeof(args), view, view->count, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyAffine3DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat4x4 transform)
+{
+    const struct SVTL_VertexView view = viewOf(vi);
+    return applyAffine3D(ctx, &view, transform);
+}
+
+SVTL_API errno_t SVTL_applyAffine3D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat4x4 transform)
+{
+    return SVTL_applyAffine3DCtx(&defaultContext, vi, transform);
+}
+
+SVTL_API errno_t SVTL_applyAffine3DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat4x4 transform, SVTL_Fence* fenceOut)
+{
+    const struct SVTL_VertexView view = viewOf(vi);
+    return applyAffine3DAsync(ctx, &view, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyAffine3DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat4x4 transform, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DAsyncCtx(&defaultContext, vi, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_translate3DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 displacement)
+{
+    return SVTL_applyAffine3DCtx(ctx, vi, SVTL_mat4x4Translate(displacement));
+}
+
+SVTL_API errno_t SVTL_translate3D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 displacement)
+{
+    return SVTL_translate3DCtx(&defaultContext, vi, displacement);
+}
+
+SVTL_API errno_t SVTL_translate3DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 displacement, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DAsyncCtx(ctx, vi, SVTL_mat4x4Translate(displacement), fenceOut);
+}
+
+SVTL_API errno_t SVTL_translate3DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 displacement, SVTL_Fence* fenceOut)
+{
+    return SVTL_translate3DAsyncCtx(&defaultContext, vi, displacement, fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate3DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 axis, f64 radians, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_applyAffine3DCtx(ctx, vi, SVTL_mat4x4Rotate(axis, radians, origin));
+}
+
+SVTL_API errno_t SVTL_rotate3D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 axis, f64 radians, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_rotate3DCtx(&defaultContext, vi, axis, radians, origin);
+}
+
+SVTL_API errno_t SVTL_rotate3DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 axis, f64 radians, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DAsyncCtx(ctx, vi, SVTL_mat4x4Rotate(axis, radians, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate3DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 axis, f64 radians, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_rotate3DAsyncCtx(&defaultContext, vi, axis, radians, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate3DQuatCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_applyAffine3DCtx(ctx, vi, SVTL_mat4x4RotateQuat(rotation, origin));
+}
+
+SVTL_API errno_t SVTL_rotate3DQuat(const struct SVTL_VertexInfo* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_rotate3DQuatCtx(&defaultContext, vi, rotation, origin);
+}
+
+SVTL_API errno_t SVTL_rotate3DQuatAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DAsyncCtx(ctx, vi, SVTL_mat4x4RotateQuat(rotation, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate3DQuatAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_rotate3DQuatAsyncCtx(&defaultContext, vi, rotation, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_scale3DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_applyAffine3DCtx(ctx, vi, SVTL_mat4x4Scale(scaleFactor, origin));
+}
+
+SVTL_API errno_t SVTL_scale3D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_scale3DCtx(&defaultContext, vi, scaleFactor, origin);
+}
+
+SVTL_API errno_t SVTL_scale3DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DAsyncCtx(ctx, vi, SVTL_mat4x4Scale(scaleFactor, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_scale3DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_scale3DAsyncCtx(&defaultContext, vi, scaleFactor, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyAffine3DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat4x4 transform)
+{
+    const struct SVTL_VertexView view = viewOfSoA(vi);
+    return applyAffine3D(ctx, &view, transform);
+}
+
+SVTL_API errno_t SVTL_applyAffine3DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat4x4 transform)
+{
+    return SVTL_applyAffine3DSoACtx(&defaultContext, vi, transform);
+}
+
+SVTL_API errno_t SVTL_applyAffine3DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat4x4 transform, SVTL_Fence* fenceOut)
+{
+    const struct SVTL_VertexView view = viewOfSoA(vi);
+    return applyAffine3DAsync(ctx, &view, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyAffine3DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat4x4 transform, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DSoAAsyncCtx(&defaultContext, vi, transform, fenceOut);
+}
+
+SVTL_API errno_t SVTL_translate3DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 displacement)
+{
+    return SVTL_applyAffine3DSoACtx(ctx, vi, SVTL_mat4x4Translate(displacement));
+}
+
+SVTL_API errno_t SVTL_translate3DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 displacement)
+{
+    return SVTL_translate3DSoACtx(&defaultContext, vi, displacement);
+}
+
+SVTL_API errno_t SVTL_translate3DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 displacement, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DSoAAsyncCtx(ctx, vi, SVTL_mat4x4Translate(displacement), fenceOut);
+}
+
+SVTL_API errno_t SVTL_translate3DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 displacement, SVTL_Fence* fenceOut)
+{
+    return SVTL_translate3DSoAAsyncCtx(&defaultContext, vi, displacement, fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate3DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 axis, f64 radians, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_applyAffine3DSoACtx(ctx, vi, SVTL_mat4x4Rotate(axis, radians, origin));
+}
+
+SVTL_API errno_t SVTL_rotate3DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 axis, f64 radians, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_rotate3DSoACtx(&defaultContext, vi, axis, radians, origin);
+}
+
+SVTL_API errno_t SVTL_rotate3DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 axis, f64 radians, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DSoAAsyncCtx(ctx, vi, SVTL_mat4x4Rotate(axis, radians, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate3DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 axis, f64 radians, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_rotate3DSoAAsyncCtx(&defaultContext, vi, axis, radians, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate3DQuatSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_applyAffine3DSoACtx(ctx, vi, SVTL_mat4x4RotateQuat(rotation, origin));
+}
+
+SVTL_API errno_t SVTL_rotate3DQuatSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_rotate3DQuatSoACtx(&defaultContext, vi, rotation, origin);
+}
+
+SVTL_API errno_t SVTL_rotate3DQuatSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DSoAAsyncCtx(ctx, vi, SVTL_mat4x4RotateQuat(rotation, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_rotate3DQuatSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_rotate3DQuatSoAAsyncCtx(&defaultContext, vi, rotation, origin, fenceOut);
+}
+
+SVTL_API errno_t SVTL_scale3DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_applyAffine3DSoACtx(ctx, vi, SVTL_mat4x4Scale(scaleFactor, origin));
+}
+
+SVTL_API errno_t SVTL_scale3DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin)
+{
+    return SVTL_scale3DSoACtx(&defaultContext, vi, scaleFactor, origin);
+}
+
+SVTL_API errno_t SVTL_scale3DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine3DSoAAsyncCtx(ctx, vi, SVTL_mat4x4Scale(scaleFactor, origin), fenceOut);
+}
+
+SVTL_API errno_t SVTL_scale3DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut)
+{
+    return SVTL_scale3DSoAAsyncCtx(&defaultContext, vi, scaleFactor, origin, fenceOut);
+}
+
+/*the meshes of a batch are laid end to end in one index space of totalCount vertices, which is split across the workers by vertex count.
+firstVertices[i] is the index of the first vertex of item i, and firstVertices[itemCount] the total*/
+struct SVTL_applyAffine2DBatch_Args
+{
+    const void* vi; u32 firstVertexIndex; u32 vertexCount;
+    const void* items;
+    const u32* firstVertices;
+    u32 itemCount;
+    bool soa;
+};
+DISPATCH_ARGS_FIT(SVTL_applyAffine2DBatch_Args);
+
+static void* SVTL_applyAffine2DBatch_ThreadSegment(void* __args)
+{
+    struct SVTL_applyAffine2DBatch_Args* args = __args;
+    const u32* firstVertices = args->firstVertices;
+    const u32 first = args->firstVertexIndex;
+    const u32 end = first + args->vertexCount;
+
+    /*the last item that starts at or before first*/
+    u32 lo = 0, hi = args->itemCount;
+    while (hi - lo > 1) {
+        const u32 mid = lo + (hi - lo) / 2;
+        if (firstVertices[mid] <= first)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    u32 i;
+    for (i = lo; i < args->itemCount && firstVertices[i] < end; ++i)
+    {
+        const u32 begin = first > firstVertices[i] ? first - firstVertices[i] : 0u;
+        const u32 stop = (end < firstVertices[i + 1] ? end : firstVertices[i + 1]) - firstVertices[i];
+        if (stop <= begin)
+            continue;
+
+        struct SVTL_VertexView view;
+        struct SVTL_applyAffine2D_Args affine;
+        if (args->soa) {
+            const struct SVTL_Affine2DBatchItemSoA* item = (const struct SVTL_Affine2DBatchItemSoA*)args->items + i;
+            view = viewOfSoA(&item->vi);
+            affine.transform = item->transform;
+        } else {
+            const struct SVTL_Affine2DBatchItem* item = (const struct SVTL_Affine2DBatchItem*)args->items + i;
+            view = viewOf(&item->vi);
+            affine.transform = item->transform;
+        }
+        affine.vi = &view;
+        affine.firstVertexIndex = begin;
+        affine.vertexCount = stop - begin;
+        SVTL_applyAffine2D_ThreadSegment(&affine);
+    }
+    return NULL;
+}
+
+static errno_t applyAffine2DBatch(SVTL_Context ctx, const void* items, u32 itemCount, bool soa)
+{
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
+
+    if (itemCount == 0)
+        return 0;
 
-    const struct SVTL_VertexInfo* vi = args->vi;
-    u32 firstVertexIndex = args->firstVertexIndex;
-    u32 vertexCount = args->vertexCount;
-    struct SVTL_F64Vec2 origin = args->origin;
-    struct SVTL_F64Vec2 skewFactor = args->skewFactor;
-    void* vertices = vi->vertices;
+    struct SVTL_ScratchBlock* block = acquireScratch(ctx, sizeof(u32) * ((size_t)itemCount + 1));
+    if (!block)
+        return -1;
+    u32* firstVertices = (u32*)scratchData(block);
+
+    u64 total = 0;
+    u32 i;
+    for (i = 0; i < itemCount; ++i)
+    {
+        firstVertices[i] = (u32)total;
+        total += soa ? ((const struct SVTL_Affine2DBatchItemSoA*)items)[i].vi.count : ((const struct SVTL_Affine2DBatchItem*)items)[i].vi.count;
+    }
+    if (total > UINT32_MAX) {
+        releaseScratch(ctx, block);
+        return -1;
+    }
+    firstVertices[itemCount] = (u32)total;
+
+    struct SVTL_applyAffine2DBatch_Args args;
+    args.vi = NULL;
+    args.items = items;
+    args.firstVertices = firstVertices;
+    args.itemCount = itemCount;
+    args.soa = soa;
+    errno_t err = runDispatch(ctx, SVTL_applyAffine2DBatch_ThreadSegment, &args, sizeof(args), NULL, (u32)total);
+    releaseScratch(ctx, block);
+    return err;
+}
+
+SVTL_API errno_t SVTL_applyAffine2DBatchCtx(SVTL_Context ctx, const struct SVTL_Affine2DBatchItem* items, uint32_t itemCount)
+{
+    return applyAffine2DBatch(ctx, items, itemCount, false);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DBatch(const struct SVTL_Affine2DBatchItem* items, uint32_t itemCount)
+{
+    return SVTL_applyAffine2DBatchCtx(&defaultContext, items, itemCount);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DBatchSoACtx(SVTL_Context ctx, const struct SVTL_Affine2DBatchItemSoA* items, uint32_t itemCount)
+{
+    return applyAffine2DBatch(ctx, items, itemCount, true);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DBatchSoA(const struct SVTL_Affine2DBatchItemSoA* items, uint32_t itemCount)
+{
+    return SVTL_applyAffine2DBatchSoACtx(&defaultContext, items, itemCount);
+}
+
+#define COMMAND_BUFFER_INITIAL_CAPACITY 8u
+
+struct SVTL_CommandBuffer_T
+{
+    struct SVTL_F64Mat2x3* transforms; /*in the order they were recorded*/
+    u32 transformCount;
+    u32 transformCapacity;
+};
+
+SVTL_API errno_t SVTL_createCommandBuffer(SVTL_CommandBuffer* cmdOut)
+{
+    struct SVTL_CommandBuffer_T* cmd = malloc(sizeof(struct SVTL_CommandBuffer_T));
+    if (!cmd)
+        return -1;
+    cmd->transforms = malloc(sizeof(struct SVTL_F64Mat2x3) * COMMAND_BUFFER_INITIAL_CAPACITY);
+    if (!cmd->transforms) {
+        free(cmd);
+        return -1;
+    }
+    cmd->transformCount = 0;
+    cmd->transformCapacity = COMMAND_BUFFER_INITIAL_CAPACITY;
+    *cmdOut = cmd;
+    return 0;
+}
+
+SVTL_API void SVTL_destroyCommandBuffer(SVTL_CommandBuffer cmd)
+{
+    if (!cmd)
+        return;
+    free(cmd->transforms);
+    free(cmd);
+}
+
+SVTL_API void SVTL_resetCommandBuffer(SVTL_CommandBuffer cmd)
+{
+    cmd->transformCount = 0;
+}
+
+SVTL_API errno_t SVTL_cmdAffine2D(SVTL_CommandBuffer cmd, struct SVTL_F64Mat2x3 transform)
+{
+    if (cmd->transformCount == cmd->transformCapacity) {
+        struct SVTL_F64Mat2x3* transforms = realloc(cmd->transforms, sizeof(struct SVTL_F64Mat2x3) * cmd->transformCapacity * 2);
+        if (!transforms)
+            return -1;
+        cmd->transforms = transforms;
+        cmd->transformCapacity *= 2;
+    }
+    cmd->transforms[cmd->transformCount++] = transform;
+    return 0;
+}
+
+SVTL_API errno_t SVTL_cmdTranslate2D(SVTL_CommandBuffer cmd, struct SVTL_F64Vec2 displacement)
+{
+    return SVTL_cmdAffine2D(cmd, SVTL_mat2x3Translate(displacement));
+}
+
+SVTL_API errno_t SVTL_cmdRotate2D(SVTL_CommandBuffer cmd, f64 radians, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_cmdAffine2D(cmd, SVTL_mat2x3Rotate(radians, origin));
+}
+
+SVTL_API errno_t SVTL_cmdScale2D(SVTL_CommandBuffer cmd, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_cmdAffine2D(cmd, SVTL_mat2x3Scale(scaleFactor, origin));
+}
+
+SVTL_API errno_t SVTL_cmdSkew2D(SVTL_CommandBuffer cmd, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin)
+{
+    return SVTL_cmdAffine2D(cmd, SVTL_mat2x3Skew(skewFactor, origin));
+}
+
+SVTL_API errno_t SVTL_cmdMirror2D(SVTL_CommandBuffer cmd, struct SVTL_F64Line2 mirrorLine)
+{
+    return SVTL_cmdAffine2D(cmd, SVTL_mat2x3Mirror(mirrorLine));
+}
+
+/*the recorded transforms composed into one, so the vertices are swept once however many commands were recorded*/
+static struct SVTL_F64Mat2x3 composeCommandBuffer(SVTL_CommandBuffer cmd)
+{
+    struct SVTL_F64Mat2x3 transform = cmd->transforms[0];
+    u32 i;
+    for (i = 1; i < cmd->transformCount; ++i)
+        transform = SVTL_mat2x3Multiply(cmd->transforms[i], transform);
+    return transform;
+}
+
+static errno_t submitCommandBuffer(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexView* view)
+{
+    if (cmd->transformCount == 0)
+        return 0;
+    return applyAffine2D(ctx, view, composeCommandBuffer(cmd));
+}
+
+static errno_t submitCommandBufferAsync(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexView* view, SVTL_Fence* fenceOut)
+{
+    /*an empty buffer still hands back a fence, from a dispatch over no vertices*/
+    if (cmd->transformCount == 0) {
+        DBG_VALIDATE_INSTANCE_USAGE(ctx);
+        struct SVTL_applyAffine2D_Args args;
+        args.vi = view;
+        args.transform = SVTL_mat2x3Identity();
+        return runDispatchAsync(ctx, SVTL_applyAffine2D_ThreadSegment, &args, sizeof(args), view, 0u, fenceOut);
+    }
+    return applyAffine2DAsync(ctx, view, composeCommandBuffer(cmd), fenceOut);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfo* vi)
+{
+    const struct SVTL_VertexView view = viewOf(vi);
+    return submitCommandBuffer(ctx, cmd, &view);
+}
+
+SVTL_API errno_t SVTL_submitCommandBuffer(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfo* vi)
+{
+    return SVTL_submitCommandBufferCtx(&defaultContext, cmd, vi);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferAsyncCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfo* vi, SVTL_Fence* fenceOut)
+{
+    const struct SVTL_VertexView view = viewOf(vi);
+    return submitCommandBufferAsync(ctx, cmd, &view, fenceOut);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferAsync(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfo* vi, SVTL_Fence* fenceOut)
+{
+    return SVTL_submitCommandBufferAsyncCtx(&defaultContext, cmd, vi, fenceOut);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferSoACtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoSoA* vi)
+{
+    const struct SVTL_VertexView view = viewOfSoA(vi);
+    return submitCommandBuffer(ctx, cmd, &view);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferSoA(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoSoA* vi)
+{
+    return SVTL_submitCommandBufferSoACtx(&defaultContext, cmd, vi);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferSoAAsyncCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoSoA* vi, SVTL_Fence* fenceOut)
+{
+    const struct SVTL_VertexView view = viewOfSoA(vi);
+    return submitCommandBufferAsync(ctx, cmd, &view, fenceOut);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferSoAAsync(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoSoA* vi, SVTL_Fence* fenceOut)
+{
+    return SVTL_submitCommandBufferSoAAsyncCtx(&defaultContext, cmd, vi, fenceOut);
+}
+
+/*the bytes an out-of-place operation stages per block: the block is read from the source, transformed and written to the destination while in L1*/
+#define STAGING_BLOCK_BYTES 16384u
+/*out-of-place outputs at least this large are written with non-temporal stores, so they do not evict the caller's working set*/
+#define STREAM_STORE_MIN_BYTES (1u << 20)
+
+/*reads positions from a source and writes the transformed positions, and optionally whole vertices, to the destination view vi*/
+struct SVTL_transformTo_Args
+{
+    const struct SVTL_VertexView* vi; u32 firstVertexIndex; u32 vertexCount;
+    const u8* srcX; const u8* srcY; u32 srcStride; enum SVTL_PositionType srcPositionType;
+    u32 positionOffset; /*of both the source and the destination when copyVertices is set*/
+    struct SVTL_F64Mat2x3 transform;
+    bool applyTransform; /*unset to only copy or convert, as for an empty command buffer*/
+    bool copyVertices;
+    bool stream;
+};
+DISPATCH_ARGS_FIT(SVTL_transformTo_Args);
+
+/*converts count positions to packed pairs of outType*/
+static void gatherPositions(u8* out, enum SVTL_PositionType outType, const u8* x, const u8* y, u32 stride, enum SVTL_PositionType type, u32 count)
+{
+    const u32 componentSize = positionComponentSize(type);
+    if (type == outType && y == x + componentSize && stride == 2 * componentSize) {
+        memcpy(out, x, (size_t)count * stride);
+        return;
+    }
+
+    u32 i;
+    if (type == outType) {
+        for (i = 0; i < count; ++i, x += stride, y += stride) {
+            memcpy(out + (size_t)2 * componentSize * i, x, componentSize);
+            memcpy(out + (size_t)2 * componentSize * i + componentSize, y, componentSize);
+        }
+        return;
+    }
+    if (isCompactPositionType(type) || isCompactPositionType(outType)) {
+        const u32 outComponentSize = positionComponentSize(outType);
+        for (i = 0; i < count; ++i, x += stride, y += stride) {
+            storeComponent(outType, out + (size_t)2 * outComponentSize * i, loadComponent(type, x));
+            storeComponent(outType, out + (size_t)2 * outComponentSize * i + outComponentSize, loadComponent(type, y));
+        }
+        return;
+    }
+
+    for (i = 0; i < count; ++i, x += stride, y += stride)
+    {
+        const f64 px = type == SVTL_POS_TYPE_VEC2_F32 ? *(const f32*)x : *(const f64*)x;
+        const f64 py = type == SVTL_POS_TYPE_VEC2_F32 ? *(const f32*)y : *(const f64*)y;
+        if (outType == SVTL_POS_TYPE_VEC2_F32) {
+            ((f32*)out)[2 * i] = (f32)px;
+            ((f32*)out)[2 * i + 1] = (f32)py;
+        } else {
+            ((f64*)out)[2 * i] = px;
+            ((f64*)out)[2 * i + 1] = py;
+        }
+    }
+}
+
+static void* SVTL_transformTo_ThreadSegment(void* __args)
+{
+    struct SVTL_transformTo_Args* args = __args;
+    const struct SVTL_VertexView* dst = args->vi;
+    const u32 first = args->firstVertexIndex;
+    const u32 end = first + args->vertexCount;
+
+    const u32 componentSize = positionComponentSize(dst->positionType);
+    u8* dstVertices = dst->x - args->positionOffset;
+    const u8* srcVertices = args->srcX - args->positionOffset;
+    const u32 stageStride = args->copyVertices ? dst->stride : 2 * componentSize;
+    const u32 blockCapacity = STAGING_BLOCK_BYTES / stageStride;
+
+    if (blockCapacity == 0)
+    {
+        /*vertices too large to stage are copied and transformed in the destination*/
+        memcpy(dstVertices + (size_t)dst->stride * first, srcVertices + (size_t)dst->stride * first, (size_t)dst->stride * args->vertexCount);
+        if (args->applyTransform)
+            affinePositions(dst, first, args->vertexCount, &args->transform);
+        return NULL;
+    }
+
+    union {
+        u8 bytes[STAGING_BLOCK_BYTES];
+        f64 align_;
+    } staging;
+    struct SVTL_VertexView stage = *dst;
+    stage.x = staging.bytes + (args->copyVertices ? args->positionOffset : 0u);
+    stage.y = stage.x + componentSize;
+    stage.z = dst->z ? stage.y + componentSize : NULL;
+    stage.stride = stageStride;
+    stage.soa = false;
+
+    const bool dstPacked = !dst->soa && dst->stride == 2 * componentSize;
+    u32 blockStart;
+    for (blockStart = first; blockStart < end; blockStart += blockCapacity)
+    {
+        const u32 blockCount = end - blockStart < blockCapacity ? end - blockStart : blockCapacity;
+        if (args->copyVertices)
+            memcpy(staging.bytes, srcVertices + (size_t)stageStride * blockStart, (size_t)stageStride * blockCount);
+        else
+            gatherPositions(staging.bytes, dst->positionType, args->srcX + (size_t)args->srcStride * blockStart,
+                args->srcY + (size_t)args->srcStride * blockStart, args->srcStride, args->srcPositionType, blockCount);
+
+        if (args->applyTransform)
+            affinePositions(&stage, 0, blockCount, &args->transform);
+
+        u8* out = NULL;
+        if (args->copyVertices)
+            out = dstVertices + (size_t)stageStride * blockStart;
+        else if (dstPacked)
+            out = dst->x + (size_t)stageStride * blockStart;
+
+        if (out && args->stream) {
+            Kernels_streamCopy(out, staging.bytes, (size_t)stageStride * blockCount);
+        } else if (out) {
+            memcpy(out, staging.bytes, (size_t)stageStride * blockCount);
+        } else {
+            u32 i;
+            for (i = 0; i < blockCount; ++i) {
+                memcpy(dst->x + (size_t)dst->stride * (blockStart + i), staging.bytes + (size_t)stageStride * i, componentSize);
+                memcpy(dst->y + (size_t)dst->stride * (blockStart + i), staging.bytes + (size_t)stageStride * i + componentSize, componentSize);
+            }
+        }
+    }
+    if (args->stream)
+        Kernels_streamFence();
+    return NULL;
+}
+
+static errno_t initTransformToArgs(struct SVTL_transformTo_Args* args, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, bool copyVertices)
+{
+    if (dst->count < src->count)
+        return -1;
+    if (copyVertices && (src->stride != dst->stride || src->positionOffset != dst->positionOffset || src->positionType != dst->positionType))
+        return -1;
+    /*only x and y are transformed and gathered, so the z of 3D positions is carried over by copying whole vertices*/
+    if (!copyVertices && (is3DPositionType(src->positionType) || is3DPositionType(dst->positionType)))
+        return -1;
+
+    const u32 componentSize = positionComponentSize(src->positionType);
+    args->srcX = (const u8*)src->vertices + src->positionOffset;
+    args->srcY = args->srcX + componentSize;
+    args->srcStride = src->stride;
+    args->srcPositionType = src->positionType;
+    args->positionOffset = dst->positionOffset;
+    args->copyVertices = copyVertices;
+
+    const u64 outBytes = (u64)src->count * (copyVertices ? dst->stride : 2u * positionComponentSize(dst->positionType));
+    const bool contiguous = copyVertices || dst->stride == 2u * positionComponentSize(dst->positionType);
+    args->stream = contiguous && outBytes >= STREAM_STORE_MIN_BYTES;
+    args->applyTransform = true;
+    return 0;
+}
+
+static errno_t transformTo(SVTL_Context ctx, struct SVTL_transformTo_Args* args, const struct SVTL_VertexInfo* dst, u32 count, SVTL_Fence* fenceOut)
+{
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
+
+    const struct SVTL_VertexView view = viewOf(dst);
+    args->vi = &view;
+    if (fenceOut)
+        return runDispatchAsync(ctx, SVTL_transformTo_ThreadSegment, args, sizeof(*args), &view, count, fenceOut);
+    return runDispatch(ctx, SVTL_transformTo_ThreadSegment, args, sizeof(*args), &view, count);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DToCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, struct SVTL_F64Mat2x3 transform, bool copyVertices)
+{
+    struct SVTL_transformTo_Args args;
+    if (initTransformToArgs(&args, src, dst, copyVertices))
+        return -1;
+    args.transform = transform;
+    return transformTo(ctx, &args, dst, src->count, NULL);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DTo(const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, struct SVTL_F64Mat2x3 transform, bool copyVertices)
+{
+    return SVTL_applyAffine2DToCtx(&defaultContext, src, dst, transform, copyVertices);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DToAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, struct SVTL_F64Mat2x3 transform, bool copyVertices, SVTL_Fence* fenceOut)
+{
+    struct SVTL_transformTo_Args args;
+    if (initTransformToArgs(&args, src, dst, copyVertices))
+        return -1;
+    args.transform = transform;
+    return transformTo(ctx, &args, dst, src->count, fenceOut);
+}
+
+SVTL_API errno_t SVTL_applyAffine2DToAsync(const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, struct SVTL_F64Mat2x3 transform, bool copyVertices, SVTL_Fence* fenceOut)
+{
+    return SVTL_applyAffine2DToAsyncCtx(&defaultContext, src, dst, transform, copyVertices, fenceOut);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferToCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, bool copyVertices)
+{
+    struct SVTL_transformTo_Args args;
+    if (initTransformToArgs(&args, src, dst, copyVertices))
+        return -1;
+    args.applyTransform = cmd->transformCount > 0;
+    if (args.applyTransform)
+        args.transform = composeCommandBuffer(cmd);
+    return transformTo(ctx, &args, dst, src->count, NULL);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferTo(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, bool copyVertices)
+{
+    return SVTL_submitCommandBufferToCtx(&defaultContext, cmd, src, dst, copyVertices);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferToAsyncCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, bool copyVertices, SVTL_Fence* fenceOut)
+{
+    struct SVTL_transformTo_Args args;
+    if (initTransformToArgs(&args, src, dst, copyVertices))
+        return -1;
+    args.applyTransform = cmd->transformCount > 0;
+    if (args.applyTransform)
+        args.transform = composeCommandBuffer(cmd);
+    return transformTo(ctx, &args, dst, src->count, fenceOut);
+}
+
+SVTL_API errno_t SVTL_submitCommandBufferToAsync(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, bool copyVertices, SVTL_Fence* fenceOut)
+{
+    return SVTL_submitCommandBufferToAsyncCtx(&defaultContext, cmd, src, dst, copyVertices, fenceOut);
+}
+
+#define DEDUP_MAX_INLINE_STRIDE 64u
+
+/*an entry of a vertex table. Vertices of up to DEDUP_MAX_INLINE_STRIDE bytes are copied into the entry in place of the pointer,
+so equal hashes are confirmed without reading the source vertices again*/
+typedef struct
+{
+    u32 vIndex;
+    u32 pad_;
+    const void* vertex;
+} vertexHashmapPair;
+
+/*a hash map of vertices of one stride, compared with the equality kernel for that stride.
+The map is the udata of its compare callback, so the table must not move once created*/
+struct SVTL_VertexTable
+{
+    struct hashmap* map;
+    Kernels_BytesEqual_T equal;
+    u8* keyBuffer; /*the entry being looked up, for copied vertices larger than DEDUP_MAX_INLINE_STRIDE. NULL otherwise*/
+    u32 stride;
+    bool inlined;
+};
+
+static const u8* vertexTableEntryVertex(const struct SVTL_VertexTable* t, const vertexHashmapPair* pair)
+{
+    return t->inlined ? (const u8*)&pair->vertex : (const u8*)pair->vertex;
+}
+
+static int vpair_compare(const void *a, const void *b, void *udata)
+{
+    const struct SVTL_VertexTable* t = udata;
+    return !t->equal(vertexTableEntryVertex(t, a), vertexTableEntryVertex(t, b), t->stride);
+}
+
+static u64 vertexHash(const u8* vertex, u32 stride)
+{
+    return hashmap_xxhash3(vertex, stride, 0, 0);
+}
+
+/*the hash map grows once it holds 60% of its buckets, so a table sized for n vertices has room for n * 5 / 3*/
+#define VERTEX_TABLE_CAPACITY(vertexCount) ((size_t)(vertexCount) * 5u / 3u + 1u)
+
+/*the map has no hash callback, as every vertex is hashed once by vertexHash and passed with it.
+With copies set, the table copies vertices of every stride, so they may be freed once inserted*/
+static errno_t vertexTableCreate(struct SVTL_VertexTable* t, u32 stride, size_t capacity, bool copies)
+{
+    t->stride = stride;
+    t->inlined = copies || stride <= DEDUP_MAX_INLINE_STRIDE;
+    t->equal = Kernels_getBytesEqual(stride);
+    t->keyBuffer = NULL;
+    const size_t entrySize = t->inlined ? offsetof(vertexHashmapPair, vertex) + stride : sizeof(vertexHashmapPair);
+    if (stride > DEDUP_MAX_INLINE_STRIDE && t->inlined) {
+        t->keyBuffer = malloc(entrySize);
+        if (!t->keyBuffer) {
+            t->map = NULL;
+            return -1;
+        }
+    }
+    t->map = hashmap_new(entrySize, capacity, 0, 0, NULL, vpair_compare, NULL, t);
+    if (!t->map) {
+        free(t->keyBuffer);
+        t->keyBuffer = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+static void vertexTableDestroy(struct SVTL_VertexTable* t)
+{
+    hashmap_free(t->map);
+    free(t->keyBuffer);
+    t->map = NULL;
+    t->keyBuffer = NULL;
+}
+
+/*returns the index stored with a vertex equal to vertex, or adds vertex with vIndex and returns vIndex.
+Returns UINT32_MAX if the vertex could not be added*/
+static u32 vertexTableInsert(struct SVTL_VertexTable* t, const u8* vertex, u64 hash, u32 vIndex)
+{
+    u64 entry[(sizeof(vertexHashmapPair) - sizeof(void*) + DEDUP_MAX_INLINE_STRIDE) / sizeof(u64)];
+    vertexHashmapPair* key = t->keyBuffer ? (vertexHashmapPair*)t->keyBuffer : (vertexHashmapPair*)entry;
+    key->vIndex = vIndex;
+    if (t->inlined)
+        memcpy(&key->vertex, vertex, t->stride);
+    else
+        key->vertex = vertex;
+
+    const vertexHashmapPair* pair = hashmap_get_with_hash(t->map, key, hash);
+    if (pair)
+        return pair->vIndex;
+    hashmap_set_with_hash(t->map, key, hash);
+    return hashmap_oom(t->map) ? UINT32_MAX : vIndex;
+}
+
+/*deduplicates the vertices on the calling thread, through an empty table of their stride*/
+static errno_t unindexedToIndexed2DWithTable(struct SVTL_VertexTable* table, const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut)
+{
+    const u32 vertexCount = vi->count;
+    u32 indexedVertexCount = 0;
+    u32 i;
+    for (i = 0; i < vertexCount; ++i)
+    {
+        const u8* vertex = (u8*)vi->vertices + (size_t)vi->stride * i;
+        const u32 idx = vertexTableInsert(table, vertex, vertexHash(vertex, vi->stride), indexedVertexCount);
+        if (idx == UINT32_MAX)
+            return -1;
+        if (idx == indexedVertexCount) {
+            if (verticesOut) {
+                memcpy((u8*)verticesOut + (size_t)vi->stride * idx, vertex, vi->stride); }
+            indexedVertexCount++;
+        }
+
+        if (indicesOut) {
+            indicesOut[i] = idx; }
+    }
+    if (vertexCountOut)
+        *vertexCountOut = indexedVertexCount;
+    return 0;
+}
+
+static errno_t unindexedToIndexed2DSerial(const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut)
+{
+    struct SVTL_VertexTable table;
+    if (vertexTableCreate(&table, vi->stride, 0, false))
+        return -1;
+    errno_t err = unindexedToIndexed2DWithTable(&table, vi, verticesOut, vertexCountOut, indicesOut);
+    vertexTableDestroy(&table);
+    return err;
+}
+
+/*
+The parallel conversion splits the vertices into shards by the top bits of their hash, so equal vertices always share a shard,
+and deduplicates each shard on its own. Within a shard the vertices are visited in index order, so the first vertex each one is found equal to
+is its first occurrence in the whole list. The new indices are then given to the first occurrences in index order,
+which makes the output identical to the serial conversion whatever the worker count. The passes are:
+    1. hash each vertex and count the vertices of each shard per block
+    2. list the vertex indices of each shard in index order, with offsets from the counts
+    3. deduplicate the shards, recording the first occurrence of each vertex
+    4. count the first occurrences per block
+    5. number the first occurrences and copy them out, with offsets from the counts
+    6. replace each first occurrence with its new index
+Passes 1, 2, 4, 5 and 6 run over blocks of consecutive vertices, pass 3 over the shard lists. Each shard is deduplicated by the task
+whose segment of the lists holds its start, so a shard is never split*/
+#define DEDUP_BLOCK_VERTEX_COUNT 16384u
+#define DEDUP_SHARDS_PER_WORKER 4u
+#define DEDUP_MAX_SHARD_COUNT 256u
+
+struct SVTL_unindexedToIndexed2D_Args
+{
+    const struct SVTL_VertexInfoReadOnly* vi; u32 first; u32 count;
+    void* verticesOut;
+    u32* indicesOut;
+    u32* firstOccurrences; /*the first vertex equal to each vertex. indicesOut when it is given*/
+    u32* order; /*the vertex indices of each shard, shard by shard. Reused in pass 5 for the new index of each first occurrence*/
+    u16* shards; /*the shard of each vertex*/
+    u32* blockCounts; /*the vertex count of each shard of each block, then its offset in order*/
+    u32* shardStarts; /*the offset of each shard in order, and the vertex count at shardStarts[shardCount]*/
+    u32* blockFirsts; /*the first occurrence count of each block, then the new index of its first one*/
+    u32 shardShift;
+    u32 shardCount;
+    struct SVTL_VertexTable table; /*per task, reused for each shard it deduplicates*/
+    bool failed;
+};
+DISPATCH_ARGS_FIT(SVTL_unindexedToIndexed2D_Args);
+
+static void* SVTL_unindexedToIndexed2DHash_ThreadSegment(void* __args)
+{
+    struct SVTL_unindexedToIndexed2D_Args* args = __args;
+    const u8* vertices = args->vi->vertices;
+    const u32 stride = args->vi->stride;
+    const u32 end = args->first + args->count;
+    u32 i;
+    for (i = args->first; i < end; ++i)
+    {
+        const u32 shard = (u32)(vertexHash(vertices + (size_t)stride * i, stride) >> args->shardShift);
+        args->shards[i] = (u16)shard;
+        args->blockCounts[(size_t)(i / DEDUP_BLOCK_VERTEX_COUNT) * args->shardCount + shard]++;
+    }
+    return NULL;
+}
+
+static void* SVTL_unindexedToIndexed2DScatter_ThreadSegment(void* __args)
+{
+    struct SVTL_unindexedToIndexed2D_Args* args = __args;
+    const u32 end = args->first + args->count;
+    u32 i;
+    for (i = args->first; i < end; ++i)
+        args->order[args->blockCounts[(size_t)(i / DEDUP_BLOCK_VERTEX_COUNT) * args->shardCount + args->shards[i]]++] = i;
+    return NULL;
+}
+
+static void* SVTL_unindexedToIndexed2DShard_ThreadSegment(void* __args)
+{
+    struct SVTL_unindexedToIndexed2D_Args* args = __args;
+    const u8* vertices = args->vi->vertices;
+    const u32 stride = args->vi->stride;
+    const u32* shardStarts = args->shardStarts;
+    const u32 first = args->first;
+    const u32 end = first + args->count;
+
+    /*the first shard that starts at or after first*/
+    u32 lo = 0, hi = args->shardCount;
+    while (lo < hi) {
+        const u32 mid = lo + (hi - lo) / 2;
+        if (shardStarts[mid] < first)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
 
-    u32 i = firstVertexIndex;
-    const u32 end = firstVertexIndex + vertexCount;
-    if (vi->positionType == SVTL_POS_TYPE_VEC2_F32) {
-        for (; i < end; ++i)
+    u32 s;
+    for (s = lo; s < args->shardCount && shardStarts[s] < end && !args->failed; ++s)
+    {
+        if (shardStarts[s + 1] == shardStarts[s])
+            continue;
+        if (!args->table.map) {
+            if (vertexTableCreate(&args->table, stride, VERTEX_TABLE_CAPACITY(shardStarts[s + 1] - shardStarts[s]), false)) {
+                args->failed = true;
+                return NULL;
+            }
+        } else {
+            hashmap_clear(args->table.map, true);
+        }
+
+        u32 j;
+        for (j = shardStarts[s]; j < shardStarts[s + 1]; ++j)
         {
-            struct SVTL_F32Vec2* pos = (struct SVTL_F32Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x -= (f32)origin.x;
-            pos->y -= (f32)origin.y;
-            pos->x = pos->x + (f32)skewFactor.x * pos->y;
-            pos->y = pos->y + (f32)skewFactor.y * pos->x;
-            pos->x += (f32)origin.x;
-            pos->y += (f32)origin.y;
+            const u32 i = args->order[j];
+            const u8* vertex = vertices + (size_t)stride * i;
+            const u32 firstIndex = vertexTableInsert(&args->table, vertex, vertexHash(vertex, stride), i);
+            if (firstIndex == UINT32_MAX) {
+                args->failed = true;
+                return NULL;
+            }
+            args->firstOccurrences[i] = firstIndex;
         }
     }
-    else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64)
+    return NULL;
+}
+
+static void* SVTL_unindexedToIndexed2DCount_ThreadSegment(void* __args)
+{
+    struct SVTL_unindexedToIndexed2D_Args* args = __args;
+    const u32 end = args->first + args->count;
+    u32 b;
+    for (b = args->first; b < end; b += DEDUP_BLOCK_VERTEX_COUNT)
+    {
+        const u32 blockEnd = end - b < DEDUP_BLOCK_VERTEX_COUNT ? end : b + DEDUP_BLOCK_VERTEX_COUNT;
+        u32 firsts = 0;
+        u32 i;
+        for (i = b; i < blockEnd; ++i)
+            firsts += args->firstOccurrences[i] == i;
+        args->blockFirsts[b / DEDUP_BLOCK_VERTEX_COUNT] = firsts;
+    }
+    return NULL;
+}
+
+static void* SVTL_unindexedToIndexed2DRank_ThreadSegment(void* __args)
+{
+    struct SVTL_unindexedToIndexed2D_Args* args = __args;
+    const u8* vertices = args->vi->vertices;
+    const u32 stride = args->vi->stride;
+    const u32 end = args->first + args->count;
+    u32 b;
+    for (b = args->first; b < end; b += DEDUP_BLOCK_VERTEX_COUNT)
     {
-        for (; i < end; ++i)
+        const u32 blockEnd = end - b < DEDUP_BLOCK_VERTEX_COUNT ? end : b + DEDUP_BLOCK_VERTEX_COUNT;
+        u32 idx = args->blockFirsts[b / DEDUP_BLOCK_VERTEX_COUNT];
+        u32 i;
+        for (i = b; i < blockEnd; ++i)
         {
-            struct SVTL_F64Vec2* pos = (struct SVTL_F64Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x -= origin.x;
-            pos->y -= origin.y;
-            pos->x = pos->x + skewFactor.x * pos->y;
-            pos->y = pos->y + skewFactor.x * pos->x;
-            pos->x += origin.x;
-            pos->y += origin.y;
+            if (args->firstOccurrences[i] != i)
+                continue;
+            args->order[i] = idx;
+            if (args->verticesOut)
+                memcpy((u8*)args->verticesOut + (size_t)stride * idx, vertices + (size_t)stride * i, stride);
+            idx++;
         }
     }
     return NULL;
 }
 
-SVTL_API errno_t SVTL_skew2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin)
+static void* SVTL_unindexedToIndexed2DIndex_ThreadSegment(void* __args)
+{
+    struct SVTL_unindexedToIndexed2D_Args* args = __args;
+    const u32 end = args->first + args->count;
+    u32 i;
+    for (i = args->first; i < end; ++i)
+        args->indicesOut[i] = args->order[args->firstOccurrences[i]];
+    return NULL;
+}
+
+/*runs one pass over the vertices in segments of whole blocks, and waits for it to complete*/
+static errno_t runDedupPass(SVTL_Context ctx, void*(*func)(void*), const struct SVTL_unindexedToIndexed2D_Args* args)
 {
-    DBG_VALIDATE_INSTANCE_USAGE();
+    struct SVTL_Dispatch d;
+    if (beginDispatch(&d, ctx, args, sizeof(*args), NULL, args->vi->count, DEDUP_BLOCK_VERTEX_COUNT, 0))
+        return -1;
+    launchDispatch(&d, func);
+    errno_t err = joinDispatch(&d);
+    releaseDispatch(&d);
+    return err;
+}
 
-    struct SVTL_skew2D_Args* argList = malloc(sizeof(struct SVTL_skew2D_Args) * TASK_COUNT);
-    SVTL_TaskHandle* taskHandles = malloc(taskHandleSize * TASK_COUNT);
-    if (!argList || !taskHandles) {
+/*runs pass 3, with a hash map per task*/
+static errno_t runDedupShardPass(SVTL_Context ctx, const struct SVTL_unindexedToIndexed2D_Args* args)
+{
+    struct SVTL_Dispatch d;
+    if (beginDispatch(&d, ctx, args, sizeof(*args), NULL, args->vi->count, 1, 0))
         return -1;
+    launchDispatch(&d, SVTL_unindexedToIndexed2DShard_ThreadSegment);
+    errno_t err = joinDispatch(&d);
+
+    u32 i;
+    for (i = 0; i < d.taskCount; ++i) {
+        struct SVTL_unindexedToIndexed2D_Args* taskArgs = dispatchArgs(&d, i);
+        if (taskArgs->failed)
+            err = -1;
+        if (taskArgs->table.map)
+            vertexTableDestroy(&taskArgs->table);
     }
+    releaseDispatch(&d);
+    return err;
+}
 
-    u8 i;
-    for (i = 0; i < TASK_COUNT; ++i)
-    {
-        SVTL_Task task;
-        struct SVTL_skew2D_Args* fData = &argList[i];
-        fData->vi = vi;
-        fData->firstVertexIndex = i * (vi->count + 1) / TASK_COUNT;
-        fData->vertexCount = getSegmentSize(vi->count, TASK_COUNT, i);
-        fData->skewFactor = skewFactor;
-        fData->origin = origin;
-        task.args = fData;
-        task.func = SVTL_skew2D_ThreadSegment;
-        launchTask(task,(u8*)taskHandles+(i*taskHandleSize));
+static errno_t unindexedToIndexed2DParallel(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut)
+{
+    const u32 n = vi->count;
+    const u32 blockCount = (n + DEDUP_BLOCK_VERTEX_COUNT - 1) / DEDUP_BLOCK_VERTEX_COUNT;
+    u32 shardBits = 0;
+    while ((1u << shardBits) < ctx->workerCount * DEDUP_SHARDS_PER_WORKER && (1u << shardBits) < DEDUP_MAX_SHARD_COUNT)
+        shardBits++;
+    const u32 shardCount = 1u << shardBits;
+
+    struct SVTL_unindexedToIndexed2D_Args args;
+    memset(&args, 0, sizeof(args));
+    args.vi = vi;
+    args.verticesOut = verticesOut;
+    args.indicesOut = indicesOut;
+    args.shardShift = 64u - shardBits;
+    args.shardCount = shardCount;
+
+    /*u32 arrays first, then the u16 shard of each vertex*/
+    const size_t countsSize = (size_t)blockCount * shardCount;
+    const size_t wordCount = (size_t)n + (indicesOut ? 0u : n) + countsSize + shardCount + 1u + blockCount;
+    u32* words = malloc(sizeof(u32) * wordCount + sizeof(u16) * (size_t)n);
+    if (!words)
+        return -1;
+    args.order = words;
+    args.firstOccurrences = indicesOut ? indicesOut : args.order + n;
+    args.blockCounts = (indicesOut ? args.order + n : args.firstOccurrences + n);
+    args.shardStarts = args.blockCounts + countsSize;
+    args.blockFirsts = args.shardStarts + shardCount + 1;
+    args.shards = (u16*)(words + wordCount);
+    memset(args.blockCounts, 0, sizeof(u32) * countsSize);
+
+    errno_t err = runDedupPass(ctx, SVTL_unindexedToIndexed2DHash_ThreadSegment, &args);
+
+    /*offsets in order, shard by shard and within a shard block by block*/
+    u32 offset = 0;
+    u32 s, b;
+    for (s = 0; s < shardCount; ++s) {
+        args.shardStarts[s] = offset;
+        for (b = 0; b < blockCount; ++b) {
+            const u32 c = args.blockCounts[(size_t)b * shardCount + s];
+            args.blockCounts[(size_t)b * shardCount + s] = offset;
+            offset += c;
+        }
     }
+    args.shardStarts[shardCount] = offset;
 
-    for (i = 0; i < TASK_COUNT; ++i)
-    {
-        joinTask((u8*)taskHandles+(i*taskHandleSize));
+    if (!err)
+        err = runDedupPass(ctx, SVTL_unindexedToIndexed2DScatter_ThreadSegment, &args);
+    if (!err)
+        err = runDedupShardPass(ctx, &args);
+    if (!err)
+        err = runDedupPass(ctx, SVTL_unindexedToIndexed2DCount_ThreadSegment, &args);
+
+    u32 indexedVertexCount = 0;
+    for (b = 0; b < blockCount; ++b) {
+        const u32 c = args.blockFirsts[b];
+        args.blockFirsts[b] = indexedVertexCount;
+        indexedVertexCount += c;
     }
 
-    free(taskHandles);
-    free(argList);
+    if (!err)
+        err = runDedupPass(ctx, SVTL_unindexedToIndexed2DRank_ThreadSegment, &args);
+    if (!err && indicesOut)
+        err = runDedupPass(ctx, SVTL_unindexedToIndexed2DIndex_ThreadSegment, &args);
+    free(words);
+
+    if (err)
+        return -1;
+    if (vertexCountOut)
+        *vertexCountOut = indexedVertexCount;
     return 0;
 }
 
+SVTL_API errno_t SVTL_unindexedToIndexed2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
+{
+    if (vi->stride == 0)
+        return -1;
+    if (indexCountOut)
+        *indexCountOut = vi->count;
+
+    /*the serial conversion uses no tasks, so like the conversion before the parallel path it does not need SVTL_register.
+    The default context has no workers until it is registered, and always takes it*/
+    if (vi->count < ctx->parallelThreshold || ctx->workerCount < 2)
+        return unindexedToIndexed2DSerial(vi, verticesOut, vertexCountOut, indicesOut);
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
+    return unindexedToIndexed2DParallel(ctx, vi, verticesOut, vertexCountOut, indicesOut);
+}
+
+SVTL_API errno_t SVTL_unindexedToIndexed2D(const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
+{
+    return SVTL_unindexedToIndexed2DCtx(&defaultContext, vi, verticesOut, vertexCountOut, indicesOut, indexCountOut);
+}
 
-struct SVTL_mirror2D_Args
+/*a vertex table kept between conversions. It is recreated only when a mesh has a new stride or more vertices than it was sized for,
+and cleared otherwise, which keeps its buckets. Between SVTL_indexerBegin and SVTL_indexerEnd it holds the vertices of a stream*/
+struct SVTL_Indexer_T
 {
-    const struct SVTL_VertexInfo* vi; u32 firstVertexIndex; u32 vertexCount; struct SVTL_F64Line2 mirrorLine;
+    struct SVTL_VertexTable table;
+    u32 capacity; /*the vertex count the table was sized for*/
+    u32 vertexCount; /*of the stream*/
+    u32 indexCount; /*of the stream*/
+    bool streaming;
 };
-static void* SVTL_mirror2D_ThreadSegment(void*__args)
-{
-    struct SVTL_mirror2D_Args* args = __args;
-    const struct SVTL_VertexInfo* vi = args->vi;
-    const struct SVTL_F64Line2 mirrorLine = args->mirrorLine;
-    void* vertices = vi->vertices;
-    u32 firstVertexIndex = args->firstVertexIndex;
-    u32 vertexCount = args->vertexCount;
-
-
-    f64 c = cos(mirrorLine.dir);
-    f64 s = sin(mirrorLine.dir);
-    u32 i = firstVertexIndex;
-    const u32 end = firstVertexIndex + vertexCount;
-    if (vi->positionType == SVTL_POS_TYPE_VEC2_F32) {
-        for (; i < end; ++i)
-        {
-            struct SVTL_F32Vec2* pos = (struct SVTL_F32Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x -= (f32)mirrorLine.center.x;
-            pos->y -= (f32)mirrorLine.center.y;
 
-            f32 rx = (f32)(pos->x * c + pos->y * s);
-            f32 ry = (f32)(pos->x * -s - pos->y * -c);
+SVTL_API errno_t SVTL_createIndexer(SVTL_Indexer* indexerOut)
+{
+    struct SVTL_Indexer_T* indexer = malloc(sizeof(struct SVTL_Indexer_T));
+    if (!indexer)
+        return -1;
+    indexer->table.map = NULL;
+    indexer->capacity = 0;
+    indexer->vertexCount = 0;
+    indexer->indexCount = 0;
+    indexer->streaming = false;
+    *indexerOut = indexer;
+    return 0;
+}
+
+SVTL_API void SVTL_destroyIndexer(SVTL_Indexer indexer)
+{
+    if (!indexer)
+        return;
+    if (indexer->table.map)
+        vertexTableDestroy(&indexer->table);
+    free(indexer);
+}
 
-            pos->x = (f32)(c * rx - s * ry + mirrorLine.center.x);
-            pos->y = (f32)(s * rx + c * ry + mirrorLine.center.y);
-        }
+/*empties the table of the indexer, sized for vertexCount vertices of stride. With copies set, the table must copy every vertex it holds*/
+static errno_t resetIndexerTable(struct SVTL_Indexer_T* indexer, u32 stride, u32 vertexCount, bool copies)
+{
+    if (stride == 0)
+        return -1;
+    if (indexer->table.map && indexer->table.stride == stride && indexer->capacity >= vertexCount && (indexer->table.inlined || !copies)) {
+        hashmap_clear(indexer->table.map, true);
+        return 0;
     }
-    else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64)
-    {
-        for (; i < end; ++i)
-        {
-            struct SVTL_F64Vec2* pos = (struct SVTL_F64Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            pos->x -= mirrorLine.center.x;
-            pos->y-= mirrorLine.center.y;
 
-            f64 rx = pos->x * c + pos->y * s;
-            f64 ry = pos->x * -s - pos->y * -c;
+    if (indexer->table.map)
+        vertexTableDestroy(&indexer->table);
+    indexer->capacity = 0;
+    if (vertexTableCreate(&indexer->table, stride, VERTEX_TABLE_CAPACITY(vertexCount), copies))
+        return -1;
+    indexer->capacity = vertexCount;
+    return 0;
+}
 
-            pos->x = c * rx - s * ry + mirrorLine.center.x;
-            pos->y = s * rx + c * ry + mirrorLine.center.y;
-        }
-    }
-    return NULL;
+SVTL_API errno_t SVTL_reserveIndexer(SVTL_Indexer indexer, uint32_t stride, uint32_t vertexCount)
+{
+    if (indexer->streaming)
+        return -1;
+    return resetIndexerTable(indexer, stride, vertexCount, false);
 }
 
-SVTL_API errno_t SVTL_mirror2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Line2 mirrorLine)
+SVTL_API errno_t SVTL_indexerUnindexedToIndexed2D(SVTL_Indexer indexer, const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
 {
-    DBG_VALIDATE_INSTANCE_USAGE();
+    if (indexer->streaming || resetIndexerTable(indexer, vi->stride, vi->count, false))
+        return -1;
+    if (indexCountOut)
+        *indexCountOut = vi->count;
+    return unindexedToIndexed2DWithTable(&indexer->table, vi, verticesOut, vertexCountOut, indicesOut);
+}
 
-    struct SVTL_mirror2D_Args* argList = malloc(sizeof(struct SVTL_mirror2D_Args) * TASK_COUNT);
-    SVTL_TaskHandle* taskHandles = malloc(taskHandleSize * TASK_COUNT);
-    if (!argList || !taskHandles) {
+SVTL_API errno_t SVTL_indexerBegin(SVTL_Indexer indexer, uint32_t stride, uint32_t expectedVertexCount)
+{
+    indexer->streaming = false;
+    if (resetIndexerTable(indexer, stride, expectedVertexCount, true))
         return -1;
-    }
+    indexer->vertexCount = 0;
+    indexer->indexCount = 0;
+    indexer->streaming = true;
+    return 0;
+}
 
-    u8 i;
-    for (i = 0; i < TASK_COUNT; ++i)
-    {
-        SVTL_Task task;
-        struct SVTL_mirror2D_Args* fData = &argList[i];
-        fData->vi = vi;
-        fData->firstVertexIndex = i * (vi->count + 1) / TASK_COUNT;
-        fData->vertexCount = getSegmentSize(vi->count, TASK_COUNT, i);
-        fData->mirrorLine = mirrorLine;
-        task.args = fData;
-        task.func = SVTL_mirror2D_ThreadSegment;
-        launchTask(task,(u8*)taskHandles+(i*taskHandleSize));
-    }
+SVTL_API errno_t SVTL_indexerPush(SVTL_Indexer indexer, const struct SVTL_VertexInfoReadOnly* chunk, void* newVerticesOut, uint32_t* newVertexCountOut, uint32_t* indicesOut)
+{
+    if (!indexer->streaming || chunk->stride != indexer->table.stride || chunk->count > UINT32_MAX - indexer->indexCount)
+        return -1;
 
-    for (i = 0; i < TASK_COUNT; ++i) {
-        joinTask((u8*)taskHandles+(i*taskHandleSize));
+    const u32 stride = chunk->stride;
+    const u32 firstNewVertex = indexer->vertexCount;
+    u32 i;
+    for (i = 0; i < chunk->count; ++i)
+    {
+        const u8* vertex = (const u8*)chunk->vertices + (size_t)stride * i;
+        const u32 idx = vertexTableInsert(&indexer->table, vertex, vertexHash(vertex, stride), indexer->vertexCount);
+        if (idx == UINT32_MAX) {
+            /*the table holds part of the chunk, so the stream cannot continue*/
+            indexer->streaming = false;
+            return -1;
+        }
+        if (idx == indexer->vertexCount) {
+            if (newVerticesOut)
+                memcpy((u8*)newVerticesOut + (size_t)stride * (idx - firstNewVertex), vertex, stride);
+            indexer->vertexCount++;
+        }
+        if (indicesOut)
+            indicesOut[i] = idx;
     }
+    indexer->indexCount += chunk->count;
+    if (newVertexCountOut)
+        *newVertexCountOut = indexer->vertexCount - firstNewVertex;
+    return 0;
+}
 
-
-    free(taskHandles);
-    free(argList);
+SVTL_API errno_t SVTL_indexerEnd(SVTL_Indexer indexer, uint32_t* vertexCountOut, uint32_t* indexCountOut)
+{
+    if (!indexer->streaming)
+        return -1;
+    indexer->streaming = false;
+    /*the table has grown to hold every vertex of the stream*/
+    if (indexer->capacity < indexer->vertexCount)
+        indexer->capacity = indexer->vertexCount;
+    if (vertexCountOut)
+        *vertexCountOut = indexer->vertexCount;
+    if (indexCountOut)
+        *indexCountOut = indexer->indexCount;
     return 0;
 }
 
+/*
+Welding merges each vertex into the first earlier vertex kept whose position is within the tolerance, and keeps it otherwise.
+Kept vertices are listed in a uniform grid of cells one tolerance wide, so every vertex within the tolerance of a position
+lies in its cell or a neighbouring one, and each vertex is compared only against the kept vertices of those cells*/
+#define WELD_CELL_LIMIT 4611686018427387904.0 /*2^62, so neighbouring cell coordinates do not overflow*/
+#define WELD_CELL_MARGIN 1.000001 /*widens the cells slightly, so rounding cannot place vertices within the tolerance two cells apart*/
+
 typedef struct
 {
-    const void* vertex;
-    u32 vIndex;
-    u16 vertexSize;
-} vertexHashmapPair;
+    i64 cell[3];
+    u32 head; /*the most recently kept vertex in the cell*/
+} weldCellPair;
 
-
-uint64_t vpair_hash(const void *item, uint64_t seed0, uint64_t seed1) 
+static int weldCellCompare(const void *a, const void *b, void *udata)
 {
-    const vertexHashmapPair *pair = item;
-    return hashmap_sip(pair->vertex, pair->vertexSize, seed0, seed1);
+    (void)udata;
+    return memcmp(((const weldCellPair*)a)->cell, ((const weldCellPair*)b)->cell, sizeof(((const weldCellPair*)a)->cell));
 }
 
+static i64 weldCellCoordinate(f64 v, f64 invCellSize)
+{
+    f64 c = floor(v * invCellSize);
+    if (!(c > -WELD_CELL_LIMIT))
+        c = -WELD_CELL_LIMIT;
+    if (c > WELD_CELL_LIMIT)
+        c = WELD_CELL_LIMIT;
+    return (i64)c;
+}
 
-int vpair_compare(const void *a, const void *b, void *udata) {
-    const vertexHashmapPair *pairA = a;
-    const vertexHashmapPair *pairB = b;
-    
-    return memcmp(pairA->vertex, pairB->vertex, sizeof(pairA->vertexSize));
+/*whether the bytes of two vertices outside their positions are equal*/
+static bool weldAttributesEqual(const u8* a, const u8* b, u32 stride, u32 positionOffset, u32 positionSize)
+{
+    const u32 positionEnd = positionOffset + positionSize;
+    return memcmp(a, b, positionOffset) == 0 && memcmp(a + positionEnd, b + positionEnd, stride - positionEnd) == 0;
 }
 
-SVTL_API errno_t SVTL_unindexedToIndexed2D(const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
+SVTL_API errno_t SVTL_weldVertices2D(const struct SVTL_VertexInfoReadOnly* vi, double tolerance, bool compareAttributes,
+    void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
 {
-    struct hashmap* map = hashmap_new(sizeof(vertexHashmapPair), 0, 0, 0, vpair_hash, vpair_compare, NULL, NULL);
-    if (!map)
+    const struct SVTL_VertexView view = viewOfReadOnly(vi);
+    const u32 dims = view.z ? 3u : 2u;
+    const u32 positionSize = dims * positionComponentSize(vi->positionType);
+    if (vi->stride == 0 || !(tolerance >= 0.0) || vi->positionOffset + positionSize > vi->stride)
         return -1;
+    if (indexCountOut)
+        *indexCountOut = vi->count;
 
+    const u32 count = vi->count;
+    f64* keptPositions = malloc((sizeof(f64) * 3 + sizeof(u32) * 2) * (size_t)count + 1);
+    if (!keptPositions)
+        return -1;
+    u32* keptSources = (u32*)(keptPositions + (size_t)3 * count); /*the vertex each kept vertex was copied from*/
+    u32* keptNext = keptSources + count; /*the kept vertex before it in its cell, or UINT32_MAX*/
 
-    const u32 vertexCount = vi->count;
-    if (indexCountOut)
-        *indexCountOut = vertexCount;
+    struct hashmap* cells = hashmap_new(sizeof(weldCellPair), 0, 0, 0, NULL, weldCellCompare, NULL, NULL);
+    if (!cells) {
+        free(keptPositions);
+        return -1;
+    }
 
-    u32 indexedVertexCount = 0;
+    const f64 invCellSize = tolerance > 0.0 ? 1.0 / (tolerance * WELD_CELL_MARGIN) : 1.0;
+    const f64 toleranceSq = tolerance * tolerance;
+    const u8* vertices = vi->vertices;
+    u32 keptCount = 0;
+    errno_t err = 0;
     u32 i;
-    for (i = 0; i < vertexCount; ++i)
+    for (i = 0; i < count; ++i)
     {
-        const u8* vertex = (u8*)vi->vertices + vi->stride * i;
-        
-        u32 idx;
-        const vertexHashmapPair* pairPtr = hashmap_get(map, &(vertexHashmapPair){.vertex = vertex, .vertexSize = vi->stride});
-        if (pairPtr) {
-            const vertexHashmapPair pair = *pairPtr;
-            idx = pair.vIndex;
-        }
-        else {
-            idx = indexedVertexCount;
-           
-            if (verticesOut) {
-                memcpy((u8*)verticesOut + (vi->stride * idx), vertex, vi->stride); }
-            indexedVertexCount++;
-            hashmap_set(map, &(vertexHashmapPair){.vIndex = idx, .vertex = vertex, .vertexSize = vi->stride });
+        const struct SVTL_F64Vec2 p2 = loadPosition(&view, i);
+        const f64 p[3] = { p2.x, p2.y, view.z ? loadComponent(view.positionType, view.z + (size_t)view.stride * i) : 0.0 };
+        const u8* vertex = vertices + (size_t)vi->stride * i;
+        weldCellPair key;
+        u32 d;
+        for (d = 0; d < 3; ++d)
+            key.cell[d] = d < dims ? weldCellCoordinate(p[d], invCellSize) : 0;
+
+        /*the first kept vertex within the tolerance, over the neighbouring cells*/
+        u32 match = UINT32_MAX;
+        const i64 zRange = dims == 3 ? 1 : 0;
+        i64 dx, dy, dz;
+        for (dz = -zRange; dz <= zRange; ++dz)
+        for (dy = -1; dy <= 1; ++dy)
+        for (dx = -1; dx <= 1; ++dx)
+        {
+            weldCellPair neighbour;
+            neighbour.cell[0] = key.cell[0] + dx;
+            neighbour.cell[1] = key.cell[1] + dy;
+            neighbour.cell[2] = key.cell[2] + dz;
+            const weldCellPair* entry = hashmap_get_with_hash(cells, &neighbour, hashmap_xxhash3(neighbour.cell, sizeof(neighbour.cell), 0, 0));
+            u32 k;
+            for (k = entry ? entry->head : UINT32_MAX; k != UINT32_MAX; k = keptNext[k])
+            {
+                if (k >= match)
+                    continue;
+                const f64* q = keptPositions + (size_t)3 * k;
+                const f64 ex = p[0] - q[0], ey = p[1] - q[1], ez = p[2] - q[2];
+                if (ex * ex + ey * ey + ez * ez <= toleranceSq
+                    && (!compareAttributes || weldAttributesEqual(vertex, vertices + (size_t)vi->stride * keptSources[k], vi->stride, vi->positionOffset, positionSize)))
+                    match = k;
+            }
         }
 
-        if (indicesOut) {
-            indicesOut[i] = idx; }
+        if (match == UINT32_MAX)
+        {
+            match = keptCount++;
+            memcpy(keptPositions + (size_t)3 * match, p, sizeof(p));
+            keptSources[match] = i;
+
+            /*cells keep their vertices newest first, so the lists are in descending order*/
+            const u64 hash = hashmap_xxhash3(key.cell, sizeof(key.cell), 0, 0);
+            weldCellPair* entry = (weldCellPair*)hashmap_get_with_hash(cells, &key, hash);
+            if (entry) {
+                keptNext[match] = entry->head;
+                entry->head = match;
+            } else {
+                keptNext[match] = UINT32_MAX;
+                key.head = match;
+                hashmap_set_with_hash(cells, &key, hash);
+                if (hashmap_oom(cells)) {
+                    err = -1;
+                    break;
+                }
+            }
+            if (verticesOut)
+                memcpy((u8*)verticesOut + (size_t)vi->stride * match, vertex, vi->stride);
+        }
+        if (indicesOut)
+            indicesOut[i] = match;
     }
-    if (vertexCountOut)
-        *vertexCountOut = indexedVertexCount;
-   
 
-    hashmap_free(map);
+    hashmap_free(cells);
+    free(keptPositions);
+    if (err)
+        return -1;
+    if (vertexCountOut)
+        *vertexCountOut = keptCount;
     return 0;
 }
 
@@ -697,40 +3202,106 @@ SVTL_API errno_t SVTL_unindexedToIndexed2D(const struct SVTL_VertexInfoReadOnly*
 }
 */
 
+/*where a chunk of an indexed triangle list with primitive restart starts its first triangle. Each restart shifts the triangles after it by one index,
+so a chunk may start inside a triangle begun by the chunk before it, whose remaining indices it skips.
+exitSkip holds the indices the next chunk skips for each skip at this chunk's start, and is found for every chunk in parallel,
+then the skips are chained in chunk order*/
+struct SVTL_TriangleListPhase
+{
+    u8 exitSkip[3];
+    u8 entrySkip;
+};
+
+/*the chunk results of the area and centroid reductions start with their phase*/
+struct SVTL_SignedAreaSums
+{
+    struct SVTL_TriangleListPhase phase;
+    f64 area;
+};
+
+struct SVTL_triangleListPhase_Args
+{
+    const struct SVTL_VertexView* vi;
+    u32 first; u32 count;
+    const struct SVTL_Dispatch* dispatch;
+};
+DISPATCH_ARGS_FIT(SVTL_triangleListPhase_Args);
+
+static void* SVTL_triangleListPhase_ThreadSegment(void* __args)
+{
+    const struct SVTL_triangleListPhase_Args* args = __args;
+    const struct SVTL_VertexView* vi = args->vi;
+    const u32 end = args->first + args->count;
+    struct SVTL_TriangleListPhase* phase = dispatchChunkResult(args->dispatch, chunkOfSegment(args->first, args->dispatch->chunkSize));
+    u32 skip;
+    for (skip = 0; skip < 3; ++skip)
+    {
+        u32 i = args->first + skip;
+        if (vi->indexType == SVTL_INDEX_TYPE_U16) {
+            while (i < end)
+                i += *((const u16*)vi->indices + i) == 0xFFFF ? 1u : 3u;
+        } else {
+            while (i < end)
+                i += *((const u32*)vi->indices + i) == 0xFFFFFFFF ? 1u : 3u;
+        }
+        phase->exitSkip[skip] = (u8)(i - end);
+    }
+    return NULL;
+}
+
+/*sets the entry skip of every chunk of the dispatch, whose chunk results start with a SVTL_TriangleListPhase.
+Only indexed triangle lists with primitive restart need it; the chunks of other lists start on a triangle, with the zeroed skip.
+The task arguments are overwritten, so the caller sets its own after this*/
+static errno_t resolveTriangleListPhases(struct SVTL_Dispatch* d, const struct SVTL_VertexView* vi)
+{
+    if (vi->topologyType != SVTL_TOPOLOGY_TYPE_TRIANGLE_LIST || vi->indices == NULL || !vi->primitiveRestartEnabled || d->chunkCount == 1)
+        return 0;
+
+    struct SVTL_triangleListPhase_Args args;
+    args.vi = vi;
+    args.dispatch = d;
+    assert(sizeof(args) <= d->argSize);
+    u32 i;
+    for (i = 0; i < d->taskCount; ++i)
+        memcpy(dispatchArgs(d, i), &args, sizeof(args));
+    launchDispatch(d, SVTL_triangleListPhase_ThreadSegment);
+    errno_t err = joinDispatch(d);
+
+    u8 skip = 0;
+    for (i = 0; i < d->chunkCount; ++i) {
+        struct SVTL_TriangleListPhase* phase = dispatchChunkResult(d, i);
+        phase->entrySkip = skip;
+        skip = phase->exitSkip[skip];
+    }
+    rewindDispatch(d);
+    return err;
+}
+
 struct SVTL_findSignedArea_Args
 {
-    const struct SVTL_VertexInfoReadOnly* vi;
+    const struct SVTL_VertexView* vi;
     u32 firstIndex; u32 count;
-    f64* areaOut;
+    struct SVTL_SignedAreaSums* chunkSums; /*the sums of each chunk, added in chunk order*/
+    u32 chunkSize;
 };
+DISPATCH_ARGS_FIT(SVTL_findSignedArea_Args);
 
 SVTL_API void* SVTL_findSignedArea_ThreadSegment(void* __args)
 {
     struct SVTL_findSignedArea_Args* args = __args;
-    const struct SVTL_VertexInfoReadOnly* vi = args->vi;
+    const struct SVTL_VertexView* vi = args->vi;
     u32 firstIndex = args->firstIndex;
     u32 count = args->count;
     u32 i;
     const u32 end = firstIndex + count;
+    struct SVTL_SignedAreaSums* sumsOut = &args->chunkSums[chunkOfSegment(firstIndex, args->chunkSize)];
+    f64 area = 0.0; /*accumulated locally, so the chunk results of neighbouring tasks are not written per triangle*/
 
     if (vi->topologyType==SVTL_TOPOLOGY_TYPE_POINT_LIST)
     {
-        f64 area = 0.0;
-        for (i = firstIndex; i < end; ++i)
-        {
-            if (vi->positionType == SVTL_POS_TYPE_VEC2_F32)
-            {
-                struct SVTL_F32Vec2* posA = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * i) + vi->positionOffset);
-                struct SVTL_F32Vec2* posB = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * ((i+1)%vi->count) ) + vi->positionOffset);
-                area += (posA->x * posB->y - posB->x * posA->y);
-            }
-            else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64) {
-                struct SVTL_F64Vec2* posA = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * i) + vi->positionOffset);
-                struct SVTL_F64Vec2* posB = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * ((i+1)%vi->count) ) + vi->positionOffset);
-                area += (posA->x * posB->y - posB->x * posA->y);
-            }
-        }
-        *args->areaOut = area;
+        f64 sums[3] = {0.0, 0.0, 0.0};
+        shoelacePositions(vi, firstIndex, count, vi->count, 0, sums);
+        sumsOut->area = sums[0];
         return NULL;
     }
 
@@ -755,6 +3326,10 @@ SVTL_API void* SVTL_findSignedArea_ThreadSegment(void* __args)
         if (firstIndex < 2) {
             firstIndex = 2;
         }
+    } else if (vi->topologyType == SVTL_TOPOLOGY_TYPE_TRIANGLE_LIST)
+    {
+        /*skips the rest of a triangle begun by the chunk before, which that chunk runs*/
+        firstIndex += sumsOut->phase.entrySkip;
     }
 
     for (i = firstIndex; i < end;)
@@ -849,25 +3424,14 @@ SVTL_API void* SVTL_findSignedArea_ThreadSegment(void* __args)
             }
         }
 
-        if (vi->positionType == SVTL_POS_TYPE_VEC2_F32)
-        {
-            struct SVTL_F32Vec2* posA = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * idxA) + vi->positionOffset);
-            struct SVTL_F32Vec2* posB = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * idxB) + vi->positionOffset);
-            struct SVTL_F32Vec2* posC = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * idxC) + vi->positionOffset);
-
-            /*www.omnicalculator.com/math/area-triangle-coordinates*/
-            f64 a = 0.5 * (posA->x * (posB->y - posC->y) + posB->x * (posC->y - posA->y) + posC->x * (posA->y - posB->y));
-            *args->areaOut += a;
-        }
-        else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64)
         {
-            struct SVTL_F64Vec2* posA = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * idxA) + vi->positionOffset);
-            struct SVTL_F64Vec2* posB = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * idxB) + vi->positionOffset);
-            struct SVTL_F64Vec2* posC = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * idxC) + vi->positionOffset);
+            const struct SVTL_F64Vec2 posA = loadPosition(vi, idxA);
+            const struct SVTL_F64Vec2 posB = loadPosition(vi, idxB);
+            const struct SVTL_F64Vec2 posC = loadPosition(vi, idxC);
 
             /*www.omnicalculator.com/math/area-triangle-coordinates*/
-            f64 a = 0.5 * (posA->x * (posB->y - posC->y) + posB->x * (posC->y - posA->y) + posC->x * (posA->y - posB->y));
-            *args->areaOut +=a;
+            f64 a = 0.5 * (posA.x * (posB.y - posC.y) + posB.x * (posC.y - posA.y) + posC.x * (posA.y - posB.y));
+            area += a;
         }
 
         if (vi->topologyType == SVTL_TOPOLOGY_TYPE_TRIANGLE_LIST)
@@ -884,109 +3448,112 @@ SVTL_API void* SVTL_findSignedArea_ThreadSegment(void* __args)
         }
     }
 
+    sumsOut->area = area;
     return NULL;
 }
 
-SVTL_API f64 SVTL_findSignedArea(const struct SVTL_VertexInfoReadOnly* vi, errno_t* err)
+static f64 findSignedArea(SVTL_Context ctx, const struct SVTL_VertexView* vi, errno_t* err)
 {
-    DBG_VALIDATE_INSTANCE_USAGE();
-
-    struct SVTL_findSignedArea_Args* argList = malloc(sizeof(argList[0]) * TASK_COUNT);
-    SVTL_TaskHandle* taskHandles = malloc(taskHandleSize * TASK_COUNT);
-    f64* areaList = calloc(TASK_COUNT,sizeof(f64));
-
-    if (!taskHandles || !argList || !areaList) {
-        if (err)
-            *err = -1;
-        return 0.0;
-    }
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
 
     if (vi->count<3) {
         if (err)
             *err = -2;
         return 0;
     }
-    u8 i;
-    for (i = 0; i < TASK_COUNT; ++i)
-    {
-        SVTL_Task task;
-        struct SVTL_findSignedArea_Args* fData = &argList[i];
-        fData->vi = vi;
-        fData->firstIndex = i * (vi->count + 1) / TASK_COUNT;
-        fData->count = getSegmentSizeGrouped(vi->count, 3, TASK_COUNT, i);
-        fData->areaOut = areaList + i;
-        task.args = fData;
-        task.func = SVTL_findSignedArea_ThreadSegment;
-        launchTask(task,(u8*)taskHandles+(i*taskHandleSize));
-    }
 
-    for (i = 0; i < TASK_COUNT; ++i) {
-        u64 offset = (i*taskHandleSize);
-        joinTask((u8*)taskHandles+offset);
+    struct SVTL_Dispatch d;
+    struct SVTL_findSignedArea_Args args;
+    args.vi = vi;
+    if (beginDispatch(&d, ctx, &args, sizeof(args), NULL, vi->count, 3, sizeof(struct SVTL_SignedAreaSums))) {
+        if (err)
+            *err = -1;
+        return 0.0;
     }
+    errno_t joinErr = resolveTriangleListPhases(&d, vi);
 
-    free(taskHandles);
-    free(argList);
+    u32 i;
+    for (i = 0; i < d.taskCount; ++i) {
+        struct SVTL_findSignedArea_Args* fData = dispatchArgs(&d, i);
+        fData->vi = vi;
+        fData->chunkSums = dispatchChunkResult(&d, 0);
+        fData->chunkSize = d.chunkSize;
+    }
+    launchDispatch(&d, SVTL_findSignedArea_ThreadSegment);
+    if (joinDispatch(&d))
+        joinErr = -1;
 
     if (err)
-        *err=0;
+        *err=joinErr;
 
     f64 areaSum = 0.0;
-    for (i = 0; i < TASK_COUNT; ++i)
-    {
-        if (vi->topologyType==SVTL_TOPOLOGY_TYPE_POINT_LIST) {
-            areaSum += areaList[i]/6.0;
-        } else {
-            areaSum += areaList[i];
-        }
-    }
+    for (i = 0; i < d.chunkCount; ++i)
+        areaSum += ((const struct SVTL_SignedAreaSums*)dispatchChunkResult(&d, i))->area;
+    if (vi->topologyType==SVTL_TOPOLOGY_TYPE_POINT_LIST)
+        areaSum /= 2.0;
 
-    free(areaList);
+    releaseDispatch(&d);
 
     return areaSum;
 }
 
+SVTL_API f64 SVTL_findSignedAreaCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* vi, errno_t* err)
+{
+    const struct SVTL_VertexView view = viewOfReadOnly(vi);
+    return findSignedArea(ctx, &view, err);
+}
+
+SVTL_API f64 SVTL_findSignedArea(const struct SVTL_VertexInfoReadOnly* vi, errno_t* err)
+{
+    return SVTL_findSignedAreaCtx(&defaultContext, vi, err);
+}
+
+SVTL_API f64 SVTL_findSignedAreaSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoAReadOnly* vi, errno_t* err)
+{
+    const struct SVTL_VertexView view = viewOfSoAReadOnly(vi);
+    return findSignedArea(ctx, &view, err);
+}
+
+SVTL_API f64 SVTL_findSignedAreaSoA(const struct SVTL_VertexInfoSoAReadOnly* vi, errno_t* err)
+{
+    return SVTL_findSignedAreaSoACtx(&defaultContext, vi, err);
+}
+
+struct SVTL_Centroid2DSums
+{
+    struct SVTL_TriangleListPhase phase;
+    f64 area;
+    struct SVTL_F64Vec2 centroidSum;
+};
+
 struct SVTL_findCentroid2D_Args
 {
-    const struct SVTL_VertexInfoReadOnly* vi;
+    const struct SVTL_VertexView* vi;
     u32 firstIndex; u32 count;
-    f64* areaOut;
-    struct SVTL_F64Vec2* centroidSumOut;
+    struct SVTL_Centroid2DSums* chunkSums; /*the sums of each chunk, added in chunk order*/
+    u32 chunkSize;
 };
+DISPATCH_ARGS_FIT(SVTL_findCentroid2D_Args);
 
 SVTL_API void* SVTL_findCentroid2D_ThreadSegment(void* __args)
 {
     struct SVTL_findCentroid2D_Args* args = __args;
-    const struct SVTL_VertexInfoReadOnly* vi = args->vi;
+    const struct SVTL_VertexView* vi = args->vi;
     u32 firstIndex = args->firstIndex;
     u32 count = args->count;
     u32 i;
     const u32 end = firstIndex + count;
+    struct SVTL_Centroid2DSums* sumsOut = &args->chunkSums[chunkOfSegment(firstIndex, args->chunkSize)];
+    f64 area = 0.0; /*accumulated locally, so the chunk results of neighbouring tasks are not written per triangle*/
+    struct SVTL_F64Vec2 centroidSum = {0.0, 0.0};
 
     if (vi->topologyType==SVTL_TOPOLOGY_TYPE_POINT_LIST)
     {
-        f64 area = 0.0;
-        struct SVTL_F64Vec2 c = {0,0};
-        for (i = firstIndex; i < end; ++i)
-        {
-            if (vi->positionType == SVTL_POS_TYPE_VEC2_F32)
-            {
-                struct SVTL_F32Vec2* posA = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * i) + vi->positionOffset);
-                struct SVTL_F32Vec2* posB = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * ((i+1)%vi->count) ) + vi->positionOffset);
-                area += (posA->x * posB->y - posB->x * posA->y);
-                c.x += (posA->x + posB->x) * (posA->x * posB->y - posB->x * posA->y);
-                c.y += (posA->y + posB->y) * (posA->x * posB->y - posB->x * posA->y);
-            }
-            else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64) {
-                struct SVTL_F64Vec2* posA = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * i) + vi->positionOffset);
-                struct SVTL_F64Vec2* posB = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * ((i+1)%vi->count) ) + vi->positionOffset);
-                area += (posA->x * posB->y - posB->x * posA->y);
-                c.x += (posA->x + posB->x) * (posA->x * posB->y - posB->x * posA->y);
-                c.y += (posA->y + posB->y) * (posA->x * posB->y - posB->x * posA->y);
-            }
-        }
-        *args->areaOut = area * 0.5;
-        *args->centroidSumOut = c;
+        f64 sums[3] = {0.0, 0.0, 0.0};
+        shoelacePositions(vi, firstIndex, count, vi->count, 1, sums);
+        sumsOut->area = sums[0] * 0.5;
+        sumsOut->centroidSum.x = sums[1];
+        sumsOut->centroidSum.y = sums[2];
         return NULL;
     }
  
@@ -1010,6 +3577,10 @@ SVTL_API void* SVTL_findCentroid2D_ThreadSegment(void* __args)
         if (firstIndex < 2) {
             firstIndex = 2;
         }
+    } else if (vi->topologyType == SVTL_TOPOLOGY_TYPE_TRIANGLE_LIST)
+    {
+        /*skips the rest of a triangle begun by the chunk before, which that chunk runs*/
+        firstIndex += sumsOut->phase.entrySkip;
     }
 
     for (i = firstIndex; i < end;)
@@ -1104,37 +3675,20 @@ SVTL_API void* SVTL_findCentroid2D_ThreadSegment(void* __args)
             }
         }
 
-        if (vi->positionType == SVTL_POS_TYPE_VEC2_F32)
-        {
-            struct SVTL_F32Vec2* posA = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * idxA) + vi->positionOffset);
-            struct SVTL_F32Vec2* posB = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * idxB) + vi->positionOffset);
-            struct SVTL_F32Vec2* posC = (struct SVTL_F32Vec2*)((u8*)vi->vertices + (vi->stride * idxC) + vi->positionOffset);
-
-            /*www.omnicalculator.com/math/area-triangle-coordinates*/
-            f64 a = fabs(0.5 * (posA->x * (posB->y - posC->y) + posB->x * (posC->y - posA->y) + posC->x * (posA->y - posB->y)));
-            struct SVTL_F64Vec3 c={0,0};
-            c.x = a * (posA->x+posB->x+posC->x)/3.0;
-            c.y = a * (posA->y+posB->y+posC->y)/3.0;
-
-            *(args->areaOut) += a;
-            args->centroidSumOut->x += c.x;
-            args->centroidSumOut->y += c.y;
-        }
-        else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64)
         {
-            struct SVTL_F64Vec2* posA = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * idxA) + vi->positionOffset);
-            struct SVTL_F64Vec2* posB = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * idxB) + vi->positionOffset);
-            struct SVTL_F64Vec2* posC = (struct SVTL_F64Vec2*)((u8*)vi->vertices + (vi->stride * idxC) + vi->positionOffset);
+            const struct SVTL_F64Vec2 posA = loadPosition(vi, idxA);
+            const struct SVTL_F64Vec2 posB = loadPosition(vi, idxB);
+            const struct SVTL_F64Vec2 posC = loadPosition(vi, idxC);
 
             /*www.omnicalculator.com/math/area-triangle-coordinates*/
-            f64 a = fabs(0.5 * (posA->x * (posB->y - posC->y) + posB->x * (posC->y - posA->y) + posC->x * (posA->y - posB->y)));
+            f64 a = fabs(0.5 * (posA.x * (posB.y - posC.y) + posB.x * (posC.y - posA.y) + posC.x * (posA.y - posB.y)));
             struct SVTL_F64Vec3 c={0,0};
-            c.x = a * (posA->x+posB->x+posC->x)/3.0;
-            c.y = a * (posA->y+posB->y+posC->y)/3.0;
+            c.x = a * (posA.x+posB.x+posC.x)/3.0;
+            c.y = a * (posA.y+posB.y+posC.y)/3.0;
 
-            *(args->areaOut) += a;
-            args->centroidSumOut->x += c.x;
-            args->centroidSumOut->y += c.y;
+            area += a;
+            centroidSum.x += c.x;
+            centroidSum.y += c.y;
         }
 
         if (vi->topologyType == SVTL_TOPOLOGY_TYPE_TRIANGLE_LIST)
@@ -1151,55 +3705,50 @@ SVTL_API void* SVTL_findCentroid2D_ThreadSegment(void* __args)
         }
     }
 
+    sumsOut->area = area;
+    sumsOut->centroidSum = centroidSum;
     return NULL;
 }
 
-SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2D(const struct SVTL_VertexInfoReadOnly* vi, errno_t* err)
+static struct SVTL_F64Vec2 findCentroid2D(SVTL_Context ctx, const struct SVTL_VertexView* vi, errno_t* err)
 {
     struct SVTL_F64Vec2 retV = {0,0};
     
-    DBG_VALIDATE_INSTANCE_USAGE();
+    DBG_VALIDATE_INSTANCE_USAGE(ctx);
 
-    struct SVTL_findCentroid2D_Args* dataList = malloc(sizeof(dataList[0]) * TASK_COUNT);
-    SVTL_TaskHandle* taskHandles = malloc(taskHandleSize * TASK_COUNT);
-    f64* areaList = calloc(TASK_COUNT,sizeof(areaList[0]));
-    struct SVTL_F64Vec2* centroidSumList = calloc(TASK_COUNT,sizeof(centroidSumList[0]));
-
-    if (!dataList || !taskHandles) {
+    struct SVTL_Dispatch d;
+    struct SVTL_findCentroid2D_Args args;
+    args.vi = vi;
+    if (beginDispatch(&d, ctx, &args, sizeof(args), NULL, vi->count, 3, sizeof(struct SVTL_Centroid2DSums))) {
         if (err)
             *err = -1;
         return retV;
     }
+    errno_t joinErr = resolveTriangleListPhases(&d, vi);
 
-    u8 i;
-    for (i = 0; i < TASK_COUNT; ++i)
+    u32 i;
+    for (i = 0; i < d.taskCount; ++i)
     {
-        SVTL_Task task;
-        struct SVTL_findCentroid2D_Args* fData = &dataList[i];
+        struct SVTL_findCentroid2D_Args* fData = dispatchArgs(&d, i);
         fData->vi = vi;
-        fData->firstIndex =  getSegmentSizeGrouped(vi->count, 3, TASK_COUNT, 0)*i;
-        fData->count = getSegmentSizeGrouped(vi->count, 3, TASK_COUNT, i);
-        fData->areaOut = areaList + i;
-        fData->centroidSumOut = centroidSumList + i;
-        task.args = fData;
-        task.func = SVTL_findCentroid2D_ThreadSegment;
-        if (launchTask(task, taskHandles+i)) {
-            if (err) {
-                *err=-1;
-            }
-        }
+        fData->chunkSums = dispatchChunkResult(&d, 0);
+        fData->chunkSize = d.chunkSize;
     }
+    launchDispatch(&d, SVTL_findCentroid2D_ThreadSegment);
+    if (joinDispatch(&d))
+        joinErr = -1;
 
-    for (i = 0; i < TASK_COUNT; ++i) {
-       joinTask(taskHandles+i);
-    }
+    if (err)
+        *err=joinErr;
 
     f64 area=0;
-    for (i = 0; i < TASK_COUNT; ++i) {
-        retV.x+=centroidSumList[i].x;
-        retV.y+=centroidSumList[i].y;
-        area+=areaList[i];
+    for (i = 0; i < d.chunkCount; ++i) {
+        const struct SVTL_Centroid2DSums* sums = dispatchChunkResult(&d, i);
+        retV.x+=sums->centroidSum.x;
+        retV.y+=sums->centroidSum.y;
+        area+=sums->area;
     }
+    releaseDispatch(&d);
 
     if (area==0) {
         if (err) {
@@ -1215,51 +3764,84 @@ SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2D(const struct SVTL_VertexInfoRea
         }
     }
 
-    free(dataList);
-    free(taskHandles);
-    free(centroidSumList);
-    free(areaList);
+    return retV;
+}
+
+SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* vi, errno_t* err)
+{
+    const struct SVTL_VertexView view = viewOfReadOnly(vi);
+    return findCentroid2D(ctx, &view, err);
+}
 
-    if (err)
-        *err=0;
+SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2D(const struct SVTL_VertexInfoReadOnly* vi, errno_t* err)
+{
+    return SVTL_findCentroid2DCtx(&defaultContext, vi, err);
+}
 
-    return retV;
+SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoAReadOnly* vi, errno_t* err)
+{
+    const struct SVTL_VertexView view = viewOfSoAReadOnly(vi);
+    return findCentroid2D(ctx, &view, err);
 }
 
-SVTL_API errno_t SVTL_extractVertexPositions2D(const struct SVTL_VertexInfoReadOnly* vi, struct SVTL_F64Vec2* positionsOut)
+SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2DSoA(const struct SVTL_VertexInfoSoAReadOnly* vi, errno_t* err)
 {
-    DBG_VALIDATE_INSTANCE_USAGE();
+    return SVTL_findCentroid2DSoACtx(&defaultContext, vi, err);
+}
 
-    const void* vertices = vi->vertices;
+static void extractPositions(const struct SVTL_VertexView* vi, struct SVTL_F64Vec2* positionsOut)
+{
+    const u8* x = vi->x;
+    const u8* y = vi->y;
 
     u32 i = 0;
     if (vi->positionType == SVTL_POS_TYPE_VEC2_F32) 
     {
-        for (; i < vi->count; ++i)
+        for (; i < vi->count; ++i, x += vi->stride, y += vi->stride)
         {
-            struct SVTL_F32Vec2* pos = (struct SVTL_F32Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            positionsOut[i].x = pos->x;
-            positionsOut[i].y = pos->y;
+            positionsOut[i].x = *(const f32*)x;
+            positionsOut[i].y = *(const f32*)y;
         }
     }
     else if (vi->positionType == SVTL_POS_TYPE_VEC2_F64)
     {
-        for (; i < vi->count; ++i)
+        for (; i < vi->count; ++i, x += vi->stride, y += vi->stride)
         {
-            struct SVTL_F64Vec2* pos = (struct SVTL_F64Vec2*)((u8*)vertices + (vi->stride * i + vi->positionOffset));
-            positionsOut[i].x = pos->x;
-            positionsOut[i].y = pos->y;
+            positionsOut[i].x = *(const f64*)x;
+            positionsOut[i].y = *(const f64*)y;
         }
     }
+    else
+    {
+        for (; i < vi->count; ++i)
+            positionsOut[i] = loadPosition(vi, i);
+    }
+}
 
+SVTL_API errno_t SVTL_extractVertexPositions2D(const struct SVTL_VertexInfoReadOnly* vi, struct SVTL_F64Vec2* positionsOut)
+{
+    const struct SVTL_VertexView view = viewOfReadOnly(vi);
+    extractPositions(&view, positionsOut);
     return 0;
 }
 
 SVTL_API errno_t SVTL_extractVertexPositions2D_s(const struct SVTL_VertexInfoReadOnly* vi, struct SVTL_F64Vec2* positionsOut, uint64_t posBuffSize)
 {
-    DBG_VALIDATE_INSTANCE_USAGE();
-
     if (posBuffSize < vi->count*sizeof(struct SVTL_F64Vec2))
         return -1;
     return SVTL_extractVertexPositions2D(vi, positionsOut);
-}
\ No newline at end of file
+}
+
+SVTL_API errno_t SVTL_extractVertexPositions2DSoA(const struct SVTL_VertexInfoSoAReadOnly* vi, struct SVTL_F64Vec2* positionsOut)
+{
+    const struct SVTL_VertexView view = viewOfSoAReadOnly(vi);
+    extractPositions(&view, positionsOut);
+    return 0;
+}
+
+SVTL_API errno_t SVTL_extractVertexPositions2DSoA_s(const struct SVTL_VertexInfoSoAReadOnly* vi, struct SVTL_F64Vec2* positionsOut, uint64_t posBuffSize)
+{
+    if (posBuffSize < vi->count*sizeof(struct SVTL_F64Vec2))
+        return -1;
+    return SVTL_extractVertexPositions2DSoA(vi, positionsOut);
+}
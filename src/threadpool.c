@@ -0,0 +1,289 @@
+/*
+Copyright (C) 2025 Tripp Robins
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this
+software and associated documentation files (the "Software"), to deal in the Software
+without restriction, including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "threadpool.h"
+#include "cthreads.h"
+#include "atomics.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+/*the pool id is stored in the low bits of a task handle, so it can be joined without a reference to its pool*/
+#define THREAD_POOL_MAX_POOLS 128u
+#define TASK_HANDLE_POOL_ID_MASK 0x7Fu
+#define TASK_HANDLE_DONE_BIT 0x80u
+#define TASK_QUEUE_INITIAL_CAPACITY 16u
+
+struct ThreadPool;
+
+struct ThreadPoolWorker
+{
+    struct ThreadPool* pool;
+    struct cthreads_thread thread;
+    struct cthreads_args threadArgs;
+    bool alive;
+};
+
+struct ThreadPool
+{
+    struct cthreads_mutex mutex;
+    struct cthreads_cond workCond; /*signalled when a task is queued or the pool shuts down*/
+    struct cthreads_cond doneCond; /*broadcast when a task completes or a worker exits*/
+
+    ThreadPoolTask* queue;
+    uint32_t queueHead;
+    uint32_t queueCount;
+    uint32_t queueCapacity;
+
+    struct ThreadPoolWorker* workers;
+    uint16_t threadCount;
+    uint16_t liveCount;
+    uint16_t idleCount;
+
+    uint32_t timeoutMS;
+    bool shutdown;
+
+    volatile uint32_t joinSpinCount;
+    uint32_t joinWaiterCount; /*threads parked on doneCond in ThreadPool_JoinTask*/
+};
+
+static struct ThreadPool* pools[THREAD_POOL_MAX_POOLS] = {0};
+static volatile uint32_t poolsLock = 0u; /*guards claiming and releasing slots in pools*/
+
+static void* ThreadPool_WorkerMain(void* data)
+{
+    struct ThreadPoolWorker* worker = data;
+    struct ThreadPool* pool = worker->pool;
+
+    cthreads_mutex_lock(&pool->mutex);
+    for (;;)
+    {
+        while (pool->queueCount == 0 && !pool->shutdown)
+        {
+            int timedOut;
+            pool->idleCount++;
+            if (pool->timeoutMS)
+                timedOut = cthreads_cond_timedwait(&pool->workCond, &pool->mutex, pool->timeoutMS);
+            else
+                timedOut = cthreads_cond_wait(&pool->workCond, &pool->mutex);
+            pool->idleCount--;
+
+            /*an inactive worker closes, it is restarted by ThreadPool_LaunchTask when needed*/
+            if (timedOut && pool->queueCount == 0 && !pool->shutdown)
+                goto exit;
+        }
+        if (pool->queueCount == 0)
+            break; /*shutdown*/
+
+        ThreadPoolTask task = pool->queue[pool->queueHead];
+        pool->queueHead = (pool->queueHead + 1) % pool->queueCapacity;
+        pool->queueCount--;
+        cthreads_mutex_unlock(&pool->mutex);
+
+        task.func(task.args);
+
+        cthreads_mutex_lock(&pool->mutex);
+        /*the pool id bits of the handle are read without the mutex by ThreadPool_JoinTask,
+        which also polls the done bit before parking. Joiners park with the mutex held, so a joiner that has not parked yet sees the bit*/
+        ATOMIC_FETCH_OR_U8(&task.hdl->__, TASK_HANDLE_DONE_BIT);
+        if (pool->joinWaiterCount > 0)
+            cthreads_cond_broadcast(&pool->doneCond);
+    }
+
+exit:
+    worker->alive = false;
+    pool->liveCount--;
+    cthreads_cond_broadcast(&pool->doneCond);
+    cthreads_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+/*must be called with the pool mutex held*/
+static errno_t ThreadPool_SpawnWorker(struct ThreadPool* pool)
+{
+    uint16_t i;
+    for (i = 0; i < pool->threadCount; ++i)
+    {
+        struct ThreadPoolWorker* worker = &pool->workers[i];
+        if (worker->alive)
+            continue;
+        worker->pool = pool;
+        if (cthreads_thread_create(&worker->thread, NULL, ThreadPool_WorkerMain, worker, &worker->threadArgs))
+            return -1;
+        cthreads_thread_detach(worker->thread);
+        worker->alive = true;
+        pool->liveCount++;
+        return 0;
+    }
+    return -1;
+}
+
+THREAD_POOL_API errno_t ThreadPool_New(ThreadPoolHandle* hdl, uint32_t timeoutMS)
+{
+    if (hdl->threadCount == 0)
+        return -1;
+
+    struct ThreadPool* pool = calloc(1, sizeof(struct ThreadPool));
+    if (!pool)
+        return -1;
+    pool->workers = calloc(hdl->threadCount, sizeof(struct ThreadPoolWorker));
+    pool->queue = malloc(sizeof(ThreadPoolTask) * TASK_QUEUE_INITIAL_CAPACITY);
+    if (!pool->workers || !pool->queue) {
+        free(pool->workers);
+        free(pool->queue);
+        free(pool);
+        return -1;
+    }
+    pool->queueCapacity = TASK_QUEUE_INITIAL_CAPACITY;
+    pool->threadCount = hdl->threadCount;
+    pool->timeoutMS = timeoutMS;
+
+    cthreads_mutex_init(&pool->mutex, NULL);
+    cthreads_cond_init(&pool->workCond, NULL);
+    cthreads_cond_init(&pool->doneCond, NULL);
+
+    uint16_t id;
+    SPIN_LOCK(&poolsLock);
+    for (id = 0; id < THREAD_POOL_MAX_POOLS; ++id) {
+        if (pools[id] == NULL) {
+            pools[id] = pool;
+            break;
+        }
+    }
+    SPIN_UNLOCK(&poolsLock);
+    if (id == THREAD_POOL_MAX_POOLS) {
+        cthreads_cond_destroy(&pool->doneCond);
+        cthreads_cond_destroy(&pool->workCond);
+        cthreads_mutex_destroy(&pool->mutex);
+        free(pool->queue);
+        free(pool->workers);
+        free(pool);
+        return -1;
+    }
+    hdl->id = id;
+
+    /*workers are started up front and park until work arrives*/
+    cthreads_mutex_lock(&pool->mutex);
+    uint16_t i;
+    for (i = 0; i < pool->threadCount; ++i) {
+        if (ThreadPool_SpawnWorker(pool))
+            break;
+    }
+    cthreads_mutex_unlock(&pool->mutex);
+
+    if (pool->liveCount == 0) {
+        ThreadPool_Destroy(hdl);
+        return -1;
+    }
+    return 0;
+}
+
+THREAD_POOL_API errno_t ThreadPool_Destroy(ThreadPoolHandle* hdl)
+{
+    if (hdl->id >= THREAD_POOL_MAX_POOLS || pools[hdl->id] == NULL)
+        return -1;
+    struct ThreadPool* pool = pools[hdl->id];
+
+    /*queued tasks are drained before the workers exit*/
+    cthreads_mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    cthreads_cond_broadcast(&pool->workCond);
+    while (pool->liveCount > 0)
+        cthreads_cond_wait(&pool->doneCond, &pool->mutex);
+    cthreads_mutex_unlock(&pool->mutex);
+
+    cthreads_cond_destroy(&pool->doneCond);
+    cthreads_cond_destroy(&pool->workCond);
+    cthreads_mutex_destroy(&pool->mutex);
+
+    SPIN_LOCK(&poolsLock);
+    pools[hdl->id] = NULL;
+    SPIN_UNLOCK(&poolsLock);
+    free(pool->queue);
+    free(pool->workers);
+    free(pool);
+    return 0;
+}
+
+THREAD_POOL_API errno_t ThreadPool_LaunchTask(ThreadPoolHandle tpHdl, ThreadPoolTask task, ThreadPoolTaskHandle* taskHdl)
+{
+    if (tpHdl.id >= THREAD_POOL_MAX_POOLS || pools[tpHdl.id] == NULL)
+        return -1;
+    struct ThreadPool* pool = pools[tpHdl.id];
+
+    task.hdl = taskHdl;
+    taskHdl->__ = (uint8_t)tpHdl.id;
+
+    cthreads_mutex_lock(&pool->mutex);
+    if (pool->queueCount == pool->queueCapacity)
+    {
+        ThreadPoolTask* queue = malloc(sizeof(ThreadPoolTask) * pool->queueCapacity * 2);
+        if (!queue) {
+            cthreads_mutex_unlock(&pool->mutex);
+            return -1;
+        }
+        uint32_t i;
+        for (i = 0; i < pool->queueCount; ++i)
+            queue[i] = pool->queue[(pool->queueHead + i) % pool->queueCapacity];
+        free(pool->queue);
+        pool->queue = queue;
+        pool->queueHead = 0;
+        pool->queueCapacity *= 2;
+    }
+    pool->queue[(pool->queueHead + pool->queueCount) % pool->queueCapacity] = task;
+    pool->queueCount++;
+
+    if (pool->queueCount > pool->idleCount && pool->liveCount < pool->threadCount) {
+        if (ThreadPool_SpawnWorker(pool) && pool->liveCount == 0) {
+            /*nothing would ever run the task*/
+            pool->queueCount--;
+            cthreads_mutex_unlock(&pool->mutex);
+            return -1;
+        }
+    }
+    if (pool->idleCount > 0)
+        cthreads_cond_signal(&pool->workCond);
+    cthreads_mutex_unlock(&pool->mutex);
+    return 0;
+}
+
+THREAD_POOL_API void ThreadPool_SetJoinSpinCount(ThreadPoolHandle tpHdl, uint32_t spinCount)
+{
+    if (tpHdl.id >= THREAD_POOL_MAX_POOLS || pools[tpHdl.id] == NULL)
+        return;
+    ATOMIC_STORE_U32(&pools[tpHdl.id]->joinSpinCount, spinCount);
+}
+
+THREAD_POOL_API void ThreadPool_JoinTask(ThreadPoolTaskHandle* taskHdl)
+{
+    struct ThreadPool* pool = pools[ATOMIC_LOAD_U8(&taskHdl->__) & TASK_HANDLE_POOL_ID_MASK];
+
+    /*short tasks usually finish within the spin budget, which avoids a sleep and wake-up in the kernel*/
+    uint32_t spins = ATOMIC_LOAD_U32(&pool->joinSpinCount);
+    for (; spins > 0; --spins) {
+        if (ATOMIC_LOAD_U8(&taskHdl->__) & TASK_HANDLE_DONE_BIT)
+            return;
+        CPU_PAUSE();
+    }
+
+    cthreads_mutex_lock(&pool->mutex);
+    while (!(taskHdl->__ & TASK_HANDLE_DONE_BIT)) {
+        pool->joinWaiterCount++;
+        cthreads_cond_wait(&pool->doneCond, &pool->mutex);
+        pool->joinWaiterCount--;
+    }
+    cthreads_mutex_unlock(&pool->mutex);
+}
@@ -24,11 +24,17 @@ TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR TH
 #include <stdint.h>
 #include <errno.h>
 
+#if !defined(_ERRNO_T_DEFINED) && !defined(__STDC_LIB_EXT1__)
+    #define _ERRNO_T_DEFINED
+    typedef int errno_t;
+#endif
+
 typedef struct 
 {
     uint16_t id;
     uint16_t threadCount;
 } ThreadPoolHandle;
+/*stores the id of the pool the task was launched on, and whether it has completed*/
 typedef struct 
 {
     uint8_t __;
@@ -63,6 +69,12 @@ Launches a task.
 @return errno_t - 0 upon success, non-zero value upon failure.*/
 THREAD_POOL_API errno_t ThreadPool_LaunchTask(ThreadPoolHandle tpHdl, ThreadPoolTask task, ThreadPoolTaskHandle* taskHdl);
 
+/*
+Sets how many times ThreadPool_JoinTask polls a task, with a pause instruction between polls, before it sleeps until the task completes.
+@param ThreadPoolHandle* - a handle to the thread pool.
+@param uint32_t spinCount - the number of polls, 0 to sleep straight away. New pools do not spin.*/
+THREAD_POOL_API void ThreadPool_SetJoinSpinCount(ThreadPoolHandle tpHdl, uint32_t spinCount);
+
 /*
 Waits for a task to complete 
 @param ThreadPoolTaskHandle* - the handle to wait for.*/
@@ -22,7 +22,9 @@ TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR TH
 #if !defined(SVTL_API)
     #if defined(SVTL_DYNAMIC)
 
-        #if defined(SVTL_SHARED_EXPORTS)
+        #if !defined(_WIN32)
+            #define SVTL_API __attribute__((visibility("default")))
+        #elif defined(SVTL_SHARED_EXPORTS)
             #define SVTL_API __declspec(dllexport)
         #else
             #define SVTL_API __declspec(dllimport)
@@ -49,6 +51,11 @@ TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR TH
 #include <stdint.h>
 #include <stdbool.h>
 
+#if !defined(_ERRNO_T_DEFINED) && !defined(__STDC_LIB_EXT1__)
+    #define _ERRNO_T_DEFINED
+    typedef int errno_t;
+#endif
+
 struct SVTL_F32Vec2
 {
     float x;
@@ -81,16 +88,59 @@ struct SVTL_F64Line2
     struct SVTL_F64Vec2 center;
 };
 
+/*row-major 2x3 affine matrix: x' = m[0][0]*x + m[0][1]*y + m[0][2], y' = m[1][0]*x + m[1][1]*y + m[1][2]*/
+struct SVTL_F64Mat2x3
+{
+    double m[2][3];
+};
+
+/*row-major 3x3 projective matrix (homography) applied to (x, y, 1): x' = (m[0][0]*x + m[0][1]*y + m[0][2]) / w, y' = (m[1][0]*x + m[1][1]*y + m[1][2]) / w,
+where w = m[2][0]*x + m[2][1]*y + m[2][2]*/
+struct SVTL_F64Mat3x3
+{
+    double m[3][3];
+};
+
+/*row-major 4x4 matrix applied to column vectors: x' = m[0][0]*x + m[0][1]*y + m[0][2]*z + m[0][3], and so on for y' and z'.
+The 3D transforms are affine, so the bottom row must be (0, 0, 0, 1)*/
+struct SVTL_F64Mat4x4
+{
+    double m[4][4];
+};
+
+/*a rotation quaternion, w + xi + yj + zk. It is normalized before use*/
+struct SVTL_F64Quat
+{
+    double x;
+    double y;
+    double z;
+    double w;
+};
+
 enum SVTL_PositionType
 {
     SVTL_POS_TYPE_VEC2_F32,
     SVTL_POS_TYPE_VEC2_F64,
+    SVTL_POS_TYPE_VEC2_F16, /*IEEE half precision*/
+    SVTL_POS_TYPE_VEC2_I16_NORM, /*signed normalized: i / 32767, clamped to [-1, 1]*/
+    SVTL_POS_TYPE_VEC2_I32_FIXED, /*16.16 fixed point: i / 65536*/
+    SVTL_POS_TYPE_VEC3_F32, /*2D operations apply to x and y, and leave z unchanged*/
+    SVTL_POS_TYPE_VEC3_F64
+};
+
+/*the instruction set used by the vertex kernels, selected from cpuid*/
+enum SVTL_SimdLevel
+{
+    SVTL_SIMD_LEVEL_SCALAR,
+    SVTL_SIMD_LEVEL_SSE2,
+    SVTL_SIMD_LEVEL_AVX2,
+    SVTL_SIMD_LEVEL_AVX512
 };
 
 enum SVTL_IndexType
 {
     SVTL_INDEX_TYPE_U16,
-    SVTL_INDEX_TYPE_U32,
+    SVTL_INDEX_TYPE_U32
 };
 
 enum SVTL_TopologyType
@@ -127,6 +177,48 @@ struct SVTL_VertexInfoReadOnly
     bool primitiveRestartEnabled;
 };
 
+/*vertices whose positions are held as structure-of-arrays: x and y each point to count packed components of the position type.
+The in-place transforms, the batch transform, command buffer submits, area, centroid and position extraction have a variant with an SoA suffix
+that takes this instead. The out-of-place transforms have none*/
+struct SVTL_VertexInfoSoA
+{
+    uint32_t count;
+    void* x;
+    void* y;
+    void* indices;
+    enum SVTL_PositionType positionType;
+    enum SVTL_IndexType indexType;
+    enum SVTL_TopologyType topologyType;
+    bool primitiveRestartEnabled;
+    void* z; /*VEC3 position types only*/
+};
+
+struct SVTL_VertexInfoSoAReadOnly
+{
+    uint32_t count;
+    const void* x;
+    const void* y;
+    const void* indices;
+    enum SVTL_PositionType positionType;
+    enum SVTL_IndexType indexType;
+    enum SVTL_TopologyType topologyType;
+    bool primitiveRestartEnabled;
+    const void* z; /*VEC3 position types only*/
+};
+
+/*a mesh of SVTL_applyAffine2DBatch and the transform applied to it*/
+struct SVTL_Affine2DBatchItem
+{
+    struct SVTL_VertexInfo vi;
+    struct SVTL_F64Mat2x3 transform;
+};
+
+struct SVTL_Affine2DBatchItemSoA
+{
+    struct SVTL_VertexInfoSoA vi;
+    struct SVTL_F64Mat2x3 transform;
+};
+
 
 typedef struct 
 {
@@ -134,12 +226,30 @@ typedef struct
     void*(*func)(void*);
 } SVTL_Task;
 
+/*a recorded list of transforms that is executed in a single sweep by SVTL_submitCommandBuffer*/
+typedef struct SVTL_CommandBuffer_T* SVTL_CommandBuffer;
+
+/*a vertex table kept between calls to SVTL_indexerUnindexedToIndexed2D, so converting many similar meshes does not allocate or rehash,
+or between the chunks of a stream of vertices indexed with SVTL_indexerPush*/
+typedef struct SVTL_Indexer_T* SVTL_Indexer;
+
+/*owns a task backend (by default, its own thread pool), settings and scratch memory.
+Operations on different contexts share no state*/
+typedef struct SVTL_Context_T* SVTL_Context;
+
+/*an operation started by one of the ...Async functions. It must be passed to SVTL_waitFence exactly once*/
+typedef struct SVTL_Fence_T* SVTL_Fence;
+
 typedef void* SVTL_TaskHandle;
 
 typedef errno_t (*SVTL_LaunchTask_T)(SVTL_Task, SVTL_TaskHandle);
 
 typedef errno_t (*SVTL_JoinTask_T)(SVTL_TaskHandle);
 
+typedef errno_t (*SVTL_LaunchTaskBatch_T)(const SVTL_Task* tasks, uint32_t taskCount, SVTL_TaskHandle);
+
+typedef errno_t (*SVTL_JoinTaskBatch_T)(SVTL_TaskHandle);
+
 /*
 /// sets the callback to launch a task/thread.*/
 SVTL_API void SVTL_setTaskLaunchCallback(SVTL_LaunchTask_T cb);
@@ -148,8 +258,119 @@ SVTL_API void SVTL_setTaskLaunchCallback(SVTL_LaunchTask_T cb);
 /// sets the callback to join a task/thread. The argument of the function pointer should be a task handle.*/
 SVTL_API void SVTL_setTaskJoinCallback(SVTL_JoinTask_T cb);
 
+/*
+/// sets the size in bytes of the task handle that the launch callback writes to and the join callback reads from.
+/// SVTL reserves this many bytes per task, and reuses the reservation between operations.*/
 SVTL_API void setTaskHandleSize(uint16_t bytes);
 
+/*
+/// sets the callback to launch all the tasks of an operation at once, so a job system can enqueue them together and wake its workers once.
+/// It takes precedence over the per-task launch callback. The task list is only valid during the call, the tasks themselves until they are joined.
+/// If it fails, SVTL runs the tasks on the calling thread. NULL restores the per-task launch callback, or the default thread pool.*/
+SVTL_API void SVTL_setTaskBatchLaunchCallback(SVTL_LaunchTaskBatch_T cb);
+
+/*
+/// sets the callback to wait for all the tasks launched by one call of the batch launch callback.
+/// The argument is the single task handle that was passed to the batch launch callback, setTaskHandleSize bytes in size.*/
+SVTL_API void SVTL_setTaskBatchJoinCallback(SVTL_JoinTaskBatch_T cb);
+
+/*
+/// Sets the number of tasks each operation is split into, and the number of threads in the default thread pool.
+/// Each task is given a queue of small chunks of the operation, and a task that empties its queue steals chunks from the others,
+/// so uneven work such as index buffers with many primitive restarts does not wait on one slow task.
+/// Defaults to the number of online CPUs. Must not be called while an operation is in progress.
+/// @param uint32_t count - the number of workers, or 0 to use the number of online CPUs */
+SVTL_API void SVTL_setWorkerCount(uint32_t count);
+
+/*
+/// Returns the number of tasks each operation is split into.*/
+SVTL_API uint32_t SVTL_getWorkerCount(void);
+
+/*
+/// Sets the element count below which an operation runs on the calling thread instead of being split across the workers.
+/// The default is 8192. bench/crossover.c measures where parallel execution starts to pay off on a given machine.
+/// @param uint32_t count - the threshold, 0 to always split operations across the workers */
+SVTL_API void SVTL_setParallelThreshold(uint32_t count);
+
+/*
+/// Returns the element count below which an operation runs on the calling thread.*/
+SVTL_API uint32_t SVTL_getParallelThreshold(void);
+
+/*
+/// Sets how many times a join polls a task of the default thread pool, with a pause instruction between polls, before it sleeps until the task completes.
+/// Short operations usually complete while spinning, which saves a sleep and wake-up in the kernel. Custom task callbacks are not affected.
+/// The default is 4096. Machines with a single CPU never spin, as it would only delay the worker being waited for.
+/// @param uint32_t count - the number of polls, 0 to sleep straight away */
+SVTL_API void SVTL_setJoinSpinCount(uint32_t count);
+
+/*
+/// Returns how many times a join polls a task before it sleeps.*/
+SVTL_API uint32_t SVTL_getJoinSpinCount(void);
+
+/*
+/// Returns the instruction set the vertex kernels use. It is selected from cpuid by the first SVTL_register or SVTL_createContext.*/
+SVTL_API enum SVTL_SimdLevel SVTL_getSimdLevel(void);
+
+/*
+/// Creates a context with its own thread pool, one worker per online CPU.
+/// Every operation has a variant with a Ctx suffix that runs on a given context. The variants without the suffix use the default context.
+/// @param SVTL_Context* ctxOut - the new context
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_createContext(SVTL_Context* ctxOut);
+
+/*
+/// Destroys a context and its thread pool. No operation may be in progress on the context.
+/// @param SVTL_Context ctx - the context to destroy */
+SVTL_API void SVTL_destroyContext(SVTL_Context ctx);
+
+/*
+/// Returns the context used by the functions that do not take a context. It is valid between SVTL_register and the last SVTL_unregister.*/
+SVTL_API SVTL_Context SVTL_getDefaultContext(void);
+
+/*
+/// sets the callback used by the context to launch a task/thread. NULL restores the context's own thread pool.*/
+SVTL_API void SVTL_setTaskLaunchCallbackCtx(SVTL_Context ctx, SVTL_LaunchTask_T cb);
+
+/*
+/// sets the callback used by the context to join a task/thread.*/
+SVTL_API void SVTL_setTaskJoinCallbackCtx(SVTL_Context ctx, SVTL_JoinTask_T cb);
+
+/*
+/// sets the size in bytes of the task handles of the context's launch and join callbacks.*/
+SVTL_API void SVTL_setTaskHandleSizeCtx(SVTL_Context ctx, uint16_t bytes);
+
+/*
+/// Identical to SVTL_setTaskBatchLaunchCallback, for the given context.*/
+SVTL_API void SVTL_setTaskBatchLaunchCallbackCtx(SVTL_Context ctx, SVTL_LaunchTaskBatch_T cb);
+
+/*
+/// Identical to SVTL_setTaskBatchJoinCallback, for the given context.*/
+SVTL_API void SVTL_setTaskBatchJoinCallbackCtx(SVTL_Context ctx, SVTL_JoinTaskBatch_T cb);
+
+/*
+/// Identical to SVTL_setWorkerCount, for the given context.*/
+SVTL_API void SVTL_setWorkerCountCtx(SVTL_Context ctx, uint32_t count);
+
+/*
+/// Identical to SVTL_getWorkerCount, for the given context.*/
+SVTL_API uint32_t SVTL_getWorkerCountCtx(SVTL_Context ctx);
+
+/*
+/// Identical to SVTL_setParallelThreshold, for the given context.*/
+SVTL_API void SVTL_setParallelThresholdCtx(SVTL_Context ctx, uint32_t count);
+
+/*
+/// Identical to SVTL_getParallelThreshold, for the given context.*/
+SVTL_API uint32_t SVTL_getParallelThresholdCtx(SVTL_Context ctx);
+
+/*
+/// Identical to SVTL_setJoinSpinCount, for the given context.*/
+SVTL_API void SVTL_setJoinSpinCountCtx(SVTL_Context ctx, uint32_t count);
+
+/*
+/// Identical to SVTL_getJoinSpinCount, for the given context.*/
+SVTL_API uint32_t SVTL_getJoinSpinCountCtx(SVTL_Context ctx);
+
 /*
 /// Registers a usage of the Simple Vertex Transformation Library.
 /// @return errno_t - error code: 0 on success, -1 upon failure */
@@ -166,6 +387,20 @@ SVTL_API void SVTL_unregister(void);
 /// @return errno_t - error code: 0 on success, -1 upon failure */
 SVTL_API errno_t SVTL_translate2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 displacement);
 
+/*
+/// Identical to SVTL_translate2D, but runs on the given context.*/
+SVTL_API errno_t SVTL_translate2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 displacement);
+
+/*
+/// Starts SVTL_translate2D and returns without waiting for it to complete. The vertices must not be accessed until the fence is waited on.
+/// @param SVTL_Fence* fenceOut - signalled when the operation completes
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_translate2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 displacement, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_translate2DAsync, but runs on the given context.*/
+SVTL_API errno_t SVTL_translate2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 displacement, SVTL_Fence* fenceOut);
+
 /*
 /// Rotates the positions of the given vertices around the origin by radians.
 /// @param SVTL_VertexInfo* vi - vertex info
@@ -174,8 +409,23 @@ SVTL_API errno_t SVTL_translate2D(const struct SVTL_VertexInfo* vi, struct SVTL_
 /// @return errno_t - error code: 0 on success, -1 upon failure */
 SVTL_API errno_t SVTL_rotate2D(const struct SVTL_VertexInfo* vi, double radians, struct SVTL_F64Vec2 origin);
 
+/*
+/// Identical to SVTL_rotate2D, but runs on the given context.*/
+SVTL_API errno_t SVTL_rotate2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, double radians, struct SVTL_F64Vec2 origin);
+
+/*
+/// Starts SVTL_rotate2D and returns without waiting for it to complete. The vertices must not be accessed until the fence is waited on.
+/// @param SVTL_Fence* fenceOut - signalled when the operation completes
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_rotate2DAsync(const struct SVTL_VertexInfo* vi, double radians, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_rotate2DAsync, but runs on the given context.*/
+SVTL_API errno_t SVTL_rotate2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, double radians, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+
 /*
 /// Dilates the positions of the given vertices around the origin by the scaleFactor.
+/// Versions before the affine-matrix transforms added origin.x back to y rather than origin.y, so results differ from them unless origin.x == origin.y.
 /// @param SVTL_VertexInfo* vi - vertex info
 /// @param SVTL_F64Vec2 scaleFactor - scale factor.
 /// @param SVTL_F64Vec2 origin - the origin of the dilation.
@@ -183,42 +433,562 @@ SVTL_API errno_t SVTL_rotate2D(const struct SVTL_VertexInfo* vi, double radians,
 SVTL_API errno_t SVTL_scale2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin);
 
 /*
-/// Skews the positions of the given vertices around the origin by the skewFactor.
+/// Identical to SVTL_scale2D, but runs on the given context.*/
+SVTL_API errno_t SVTL_scale2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin);
+
+/*
+/// Starts SVTL_scale2D and returns without waiting for it to complete. The vertices must not be accessed until the fence is waited on.
+/// @param SVTL_Fence* fenceOut - signalled when the operation completes
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_scale2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_scale2DAsync, but runs on the given context.*/
+SVTL_API errno_t SVTL_scale2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Skews the positions of the given vertices around the origin by the skewFactor. Relative to the origin, x is sheared first, x' = x + skewFactor.x*y,
+/// then y by the sheared x, y' = y + skewFactor.y*x'. The skew is applied as the matrix of SVTL_mat2x3Skew, so F32 positions
+/// are rounded as by SVTL_applyAffine2D, which can differ by rounding from shearing each component in turn in single precision.
 /// @param SVTL_VertexInfo* vi - vertex info
 /// @param SVTL_F64Vec2 skewFactor - skew factor.
 /// @param SVTL_F64Vec2 origin - the origin of the skew.
 /// @return errno_t - error code: 0 on success, -1 upon failure */
 SVTL_API errno_t SVTL_skew2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin);
 
+/*
+/// Identical to SVTL_skew2D, but runs on the given context.*/
+SVTL_API errno_t SVTL_skew2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin);
+
+/*
+/// Starts SVTL_skew2D and returns without waiting for it to complete. The vertices must not be accessed until the fence is waited on.
+/// @param SVTL_Fence* fenceOut - signalled when the operation completes
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_skew2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_skew2DAsync, but runs on the given context.*/
+SVTL_API errno_t SVTL_skew2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+
 /*
 /// Mirrors the positions of the given vertices around the mirror line.
+/// Versions before the affine-matrix transforms rotated onto the line and back without reflecting, leaving the vertices unchanged.
 /// @param SVTL_VertexInfo* vi - vertex info
 /// @param SVTL_F64Line2 mirrorLine - the line around which the mirror is performed
 /// @return errno_t - error code: 0 on success, -1 upon failure */
 SVTL_API errno_t SVTL_mirror2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Line2 mirrorLine);
 
+/*
+/// Identical to SVTL_mirror2D, but runs on the given context.*/
+SVTL_API errno_t SVTL_mirror2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Line2 mirrorLine);
+
+/*
+/// Starts SVTL_mirror2D and returns without waiting for it to complete. The vertices must not be accessed until the fence is waited on.
+/// @param SVTL_Fence* fenceOut - signalled when the operation completes
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_mirror2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Line2 mirrorLine, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_mirror2DAsync, but runs on the given context.*/
+SVTL_API errno_t SVTL_mirror2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Line2 mirrorLine, SVTL_Fence* fenceOut);
+
+/*
+/// Returns the identity affine matrix. */
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Identity(void);
+
+/*
+/// Composes two affine matrices. Applying the result is equivalent to applying rhs, then lhs.
+/// @param SVTL_F64Mat2x3 lhs - the transform applied second
+/// @param SVTL_F64Mat2x3 rhs - the transform applied first
+/// @return SVTL_F64Mat2x3 - lhs * rhs */
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Multiply(struct SVTL_F64Mat2x3 lhs, struct SVTL_F64Mat2x3 rhs);
+
+/*
+/// Returns an affine matrix that translates by displacement units.
+/// @param SVTL_F64Vec2 displacement - 2D displacement */
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Translate(struct SVTL_F64Vec2 displacement);
+
+/*
+/// Returns an affine matrix that rotates around the origin by radians.
+/// @param double radians - rotation in radians
+/// @param SVTL_F64Vec2 origin - the origin of the rotation */
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Rotate(double radians, struct SVTL_F64Vec2 origin);
+
+/*
+/// Returns an affine matrix that dilates around the origin by the scaleFactor.
+/// @param SVTL_F64Vec2 scaleFactor - scale factor.
+/// @param SVTL_F64Vec2 origin - the origin of the dilation. */
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Scale(struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin);
+
+/*
+/// Returns an affine matrix that skews around the origin by the skewFactor, shearing x first and then y by the sheared x
+/// (x' = x + skewFactor.x*y, y' = y + skewFactor.y*x'), as SVTL_skew2D does.
+/// @param SVTL_F64Vec2 skewFactor - skew factor.
+/// @param SVTL_F64Vec2 origin - the origin of the skew. */
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Skew(struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin);
+
+/*
+/// Returns an affine matrix that mirrors around the mirror line.
+/// @param SVTL_F64Line2 mirrorLine - the line around which the mirror is performed */
+SVTL_API struct SVTL_F64Mat2x3 SVTL_mat2x3Mirror(struct SVTL_F64Line2 mirrorLine);
+
+/*
+/// Applies an affine transform to the positions of the given vertices in a single pass.
+/// Chained transforms should be composed with SVTL_mat2x3Multiply and applied once, rather than calling each transform separately.
+/// @param SVTL_VertexInfo* vi - vertex info
+/// @param SVTL_F64Mat2x3 transform - the affine transform to apply
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_applyAffine2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat2x3 transform);
+
+/*
+/// Identical to SVTL_applyAffine2D, but runs on the given context.*/
+SVTL_API errno_t SVTL_applyAffine2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat2x3 transform);
+
+/*
+/// Starts SVTL_applyAffine2D and returns without waiting for it to complete. The vertices must not be accessed until the fence is waited on.
+/// @param SVTL_Fence* fenceOut - signalled when the operation completes
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_applyAffine2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat2x3 transform, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_applyAffine2DAsync, but runs on the given context.*/
+SVTL_API errno_t SVTL_applyAffine2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat2x3 transform, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_translate2D, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_translate2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 displacement);
+SVTL_API errno_t SVTL_translate2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 displacement);
+SVTL_API errno_t SVTL_translate2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 displacement, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_translate2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 displacement, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_rotate2D, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_rotate2DSoA(const struct SVTL_VertexInfoSoA* vi, double radians, struct SVTL_F64Vec2 origin);
+SVTL_API errno_t SVTL_rotate2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, double radians, struct SVTL_F64Vec2 origin);
+SVTL_API errno_t SVTL_rotate2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, double radians, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_rotate2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, double radians, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_scale2D, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_scale2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin);
+SVTL_API errno_t SVTL_scale2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin);
+SVTL_API errno_t SVTL_scale2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_scale2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_skew2D, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_skew2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin);
+SVTL_API errno_t SVTL_skew2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin);
+SVTL_API errno_t SVTL_skew2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_skew2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_mirror2D, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_mirror2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Line2 mirrorLine);
+SVTL_API errno_t SVTL_mirror2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Line2 mirrorLine);
+SVTL_API errno_t SVTL_mirror2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Line2 mirrorLine, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_mirror2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Line2 mirrorLine, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_applyAffine2D, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_applyAffine2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat2x3 transform);
+SVTL_API errno_t SVTL_applyAffine2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat2x3 transform);
+SVTL_API errno_t SVTL_applyAffine2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat2x3 transform, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_applyAffine2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat2x3 transform, SVTL_Fence* fenceOut);
+
+/*
+/// Returns the identity 3x3 matrix. */
+SVTL_API struct SVTL_F64Mat3x3 SVTL_mat3x3Identity(void);
+
+/*
+/// Composes two projective matrices. Applying the result is equivalent to applying rhs, then lhs.
+/// @param SVTL_F64Mat3x3 lhs - the transform applied second
+/// @param SVTL_F64Mat3x3 rhs - the transform applied first
+/// @return SVTL_F64Mat3x3 - lhs * rhs */
+SVTL_API struct SVTL_F64Mat3x3 SVTL_mat3x3Multiply(struct SVTL_F64Mat3x3 lhs, struct SVTL_F64Mat3x3 rhs);
+
+/*
+/// Returns the projective matrix of an affine transform, so that it can be composed with a homography.
+/// @param SVTL_F64Mat2x3 transform - the affine transform */
+SVTL_API struct SVTL_F64Mat3x3 SVTL_mat3x3FromAffine(struct SVTL_F64Mat2x3 transform);
+
+/*
+/// Applies a projective transform (homography) to the positions of the given vertices in a single pass, dividing each position by its w.
+/// Positions where w is 0 become non-finite. A transform with a bottom row of (0, 0, 1) runs as SVTL_applyAffine2D.
+/// @param SVTL_VertexInfo* vi - vertex info
+/// @param SVTL_F64Mat3x3 transform - the projective transform to apply
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_applyHomography2D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat3x3 transform);
+
+/*
+/// Identical to SVTL_applyHomography2D, but runs on the given context.*/
+SVTL_API errno_t SVTL_applyHomography2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat3x3 transform);
+
+/*
+/// Starts SVTL_applyHomography2D and returns without waiting for it to complete. The vertices must not be accessed until the fence is waited on.
+/// @param SVTL_Fence* fenceOut - signalled when the operation completes
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_applyHomography2DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat3x3 transform, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_applyHomography2DAsync, but runs on the given context.*/
+SVTL_API errno_t SVTL_applyHomography2DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat3x3 transform, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_applyHomography2D, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_applyHomography2DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat3x3 transform);
+SVTL_API errno_t SVTL_applyHomography2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat3x3 transform);
+SVTL_API errno_t SVTL_applyHomography2DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat3x3 transform, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_applyHomography2DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat3x3 transform, SVTL_Fence* fenceOut);
+
+/*
+/// Returns the identity 4x4 matrix. */
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Identity(void);
+
+/*
+/// Composes two 4x4 matrices. Applying the result is equivalent to applying rhs, then lhs.
+/// @param SVTL_F64Mat4x4 lhs - the transform applied second
+/// @param SVTL_F64Mat4x4 rhs - the transform applied first
+/// @return SVTL_F64Mat4x4 - lhs * rhs */
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Multiply(struct SVTL_F64Mat4x4 lhs, struct SVTL_F64Mat4x4 rhs);
+
+/*
+/// Returns a matrix that translates by displacement units.
+/// @param SVTL_F64Vec3 displacement - 3D displacement */
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Translate(struct SVTL_F64Vec3 displacement);
+
+/*
+/// Returns a matrix that rotates by radians around an axis through the origin, counterclockwise when the axis points towards the viewer.
+/// @param SVTL_F64Vec3 axis - the axis of the rotation. It is normalized, and a zero axis gives the identity
+/// @param double radians - rotation in radians
+/// @param SVTL_F64Vec3 origin - a point on the axis */
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Rotate(struct SVTL_F64Vec3 axis, double radians, struct SVTL_F64Vec3 origin);
+
+/*
+/// Returns a matrix that rotates by a quaternion around the origin.
+/// @param SVTL_F64Quat rotation - the rotation. It is normalized, and a zero quaternion gives the identity
+/// @param SVTL_F64Vec3 origin - the origin of the rotation */
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4RotateQuat(struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin);
+
+/*
+/// Returns a matrix that dilates around the origin by the scaleFactor.
+/// @param SVTL_F64Vec3 scaleFactor - scale factor.
+/// @param SVTL_F64Vec3 origin - the origin of the dilation. */
+SVTL_API struct SVTL_F64Mat4x4 SVTL_mat4x4Scale(struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin);
+
+/*
+/// Applies an affine 4x4 transform to the positions of the given vertices in a single pass.
+/// Chained transforms should be composed with SVTL_mat4x4Multiply and applied once.
+/// @param SVTL_VertexInfo* vi - vertex info. The position type must be SVTL_POS_TYPE_VEC3_F32 or SVTL_POS_TYPE_VEC3_F64
+/// @param SVTL_F64Mat4x4 transform - the transform to apply. Its bottom row must be (0, 0, 0, 1)
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_applyAffine3D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat4x4 transform);
+SVTL_API errno_t SVTL_applyAffine3DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat4x4 transform);
+SVTL_API errno_t SVTL_applyAffine3DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat4x4 transform, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_applyAffine3DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Mat4x4 transform, SVTL_Fence* fenceOut);
+
+/*
+/// Translates the 3D positions of the given vertices by displacement units. See SVTL_applyAffine3D.*/
+SVTL_API errno_t SVTL_translate3D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 displacement);
+SVTL_API errno_t SVTL_translate3DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 displacement);
+SVTL_API errno_t SVTL_translate3DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 displacement, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_translate3DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 displacement, SVTL_Fence* fenceOut);
+
+/*
+/// Rotates the 3D positions of the given vertices by radians around an axis. See SVTL_mat4x4Rotate.*/
+SVTL_API errno_t SVTL_rotate3D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 axis, double radians, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_rotate3DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 axis, double radians, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_rotate3DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 axis, double radians, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_rotate3DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 axis, double radians, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Rotates the 3D positions of the given vertices by a quaternion. See SVTL_mat4x4RotateQuat.*/
+SVTL_API errno_t SVTL_rotate3DQuat(const struct SVTL_VertexInfo* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_rotate3DQuatCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_rotate3DQuatAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_rotate3DQuatAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Dilates the 3D positions of the given vertices around the origin by the scaleFactor. See SVTL_mat4x4Scale.*/
+SVTL_API errno_t SVTL_scale3D(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_scale3DCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_scale3DAsync(const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_scale3DAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfo* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to the 3D transforms above, but for vertices with separate x, y and z arrays.*/
+SVTL_API errno_t SVTL_applyAffine3DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat4x4 transform);
+SVTL_API errno_t SVTL_applyAffine3DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat4x4 transform);
+SVTL_API errno_t SVTL_applyAffine3DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat4x4 transform, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_applyAffine3DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Mat4x4 transform, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_translate3DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 displacement);
+SVTL_API errno_t SVTL_translate3DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 displacement);
+SVTL_API errno_t SVTL_translate3DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 displacement, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_translate3DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 displacement, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_rotate3DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 axis, double radians, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_rotate3DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 axis, double radians, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_rotate3DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 axis, double radians, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_rotate3DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 axis, double radians, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_rotate3DQuatSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_rotate3DQuatSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_rotate3DQuatSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_rotate3DQuatSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Quat rotation, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_scale3DSoA(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_scale3DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin);
+SVTL_API errno_t SVTL_scale3DSoAAsync(const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_scale3DSoAAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoA* vi, struct SVTL_F64Vec3 scaleFactor, struct SVTL_F64Vec3 origin, SVTL_Fence* fenceOut);
+
+/*
+/// Applies an affine transform to the positions of src and writes the result to dst, leaving src unchanged.
+/// Outputs of 1 MiB or more are written with non-temporal stores when dst is written contiguously (copyVertices, or packed positions), so they do not evict the caller's cache.
+/// Any named transform can be applied out of place through its SVTL_mat2x3* matrix.
+/// @param SVTL_VertexInfoReadOnly* src - the vertices to read
+/// @param SVTL_VertexInfo* dst - the vertices to write, at least src->count of them. Its position type may differ from src's unless copyVertices is set
+/// @param SVTL_F64Mat2x3 transform - the affine transform to apply
+/// @param bool copyVertices - also copy the remaining bytes of each vertex. src and dst must then have the same stride, position offset and position type.
+/// It must be set for VEC3 positions, whose z is copied unchanged
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_applyAffine2DTo(const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, struct SVTL_F64Mat2x3 transform, bool copyVertices);
+
+/*
+/// Identical to SVTL_applyAffine2DTo, but runs on the given context.*/
+SVTL_API errno_t SVTL_applyAffine2DToCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, struct SVTL_F64Mat2x3 transform, bool copyVertices);
+
+/*
+/// Starts SVTL_applyAffine2DTo and returns without waiting for it to complete. src must not be modified, nor dst accessed, until the fence is waited on.
+/// @param SVTL_Fence* fenceOut - signalled when the operation completes
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_applyAffine2DToAsync(const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, struct SVTL_F64Mat2x3 transform, bool copyVertices, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_applyAffine2DToAsync, but runs on the given context.*/
+SVTL_API errno_t SVTL_applyAffine2DToAsyncCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, struct SVTL_F64Mat2x3 transform, bool copyVertices, SVTL_Fence* fenceOut);
+
+/*
+/// Applies each item's transform to the item's vertices, with a single fork and join for the whole batch.
+/// The work is split across the workers by vertex count rather than by item, so many small meshes and a few large ones are balanced alike.
+/// The items must not share vertices.
+/// @param SVTL_Affine2DBatchItem* items - the meshes and their transforms
+/// @param uint32_t itemCount - the number of items. Their total vertex count must be below 2^32
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_applyAffine2DBatch(const struct SVTL_Affine2DBatchItem* items, uint32_t itemCount);
+
+/*
+/// Identical to SVTL_applyAffine2DBatch, but runs on the given context.*/
+SVTL_API errno_t SVTL_applyAffine2DBatchCtx(SVTL_Context ctx, const struct SVTL_Affine2DBatchItem* items, uint32_t itemCount);
+
+/*
+/// Identical to SVTL_applyAffine2DBatch, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_applyAffine2DBatchSoA(const struct SVTL_Affine2DBatchItemSoA* items, uint32_t itemCount);
+SVTL_API errno_t SVTL_applyAffine2DBatchSoACtx(SVTL_Context ctx, const struct SVTL_Affine2DBatchItemSoA* items, uint32_t itemCount);
+
+
+/*
+/// Creates an empty command buffer.
+/// @param SVTL_CommandBuffer* cmdOut - the new command buffer
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_createCommandBuffer(SVTL_CommandBuffer* cmdOut);
+
+/*
+/// Destroys a command buffer.
+/// @param SVTL_CommandBuffer cmd - the command buffer to destroy */
+SVTL_API void SVTL_destroyCommandBuffer(SVTL_CommandBuffer cmd);
+
+/*
+/// Clears all recorded commands. The memory of the command buffer is kept for reuse.
+/// @param SVTL_CommandBuffer cmd - the command buffer to reset */
+SVTL_API void SVTL_resetCommandBuffer(SVTL_CommandBuffer cmd);
+
+/*
+/// Records a translation. See SVTL_translate2D.
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_cmdTranslate2D(SVTL_CommandBuffer cmd, struct SVTL_F64Vec2 displacement);
+
+/*
+/// Records a rotation. See SVTL_rotate2D.
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_cmdRotate2D(SVTL_CommandBuffer cmd, double radians, struct SVTL_F64Vec2 origin);
+
+/*
+/// Records a dilation. See SVTL_scale2D.
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_cmdScale2D(SVTL_CommandBuffer cmd, struct SVTL_F64Vec2 scaleFactor, struct SVTL_F64Vec2 origin);
+
+/*
+/// Records a skew. See SVTL_mat2x3Skew.
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_cmdSkew2D(SVTL_CommandBuffer cmd, struct SVTL_F64Vec2 skewFactor, struct SVTL_F64Vec2 origin);
+
+/*
+/// Records a mirror. See SVTL_mat2x3Mirror.
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_cmdMirror2D(SVTL_CommandBuffer cmd, struct SVTL_F64Line2 mirrorLine);
+
+/*
+/// Records an arbitrary affine transform.
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_cmdAffine2D(SVTL_CommandBuffer cmd, struct SVTL_F64Mat2x3 transform);
+
+/*
+/// Executes the recorded commands, in order, on the given vertices.
+/// The recorded matrices are multiplied into one on each submit, which is applied in a single parallel sweep.
+/// A command buffer may be submitted any number of times, and to different vertices.
+/// @param SVTL_CommandBuffer cmd - the command buffer to execute
+/// @param SVTL_VertexInfo* vi - vertex info
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_submitCommandBuffer(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfo* vi);
+
+/*
+/// Identical to SVTL_submitCommandBuffer, but runs on the given context.*/
+SVTL_API errno_t SVTL_submitCommandBufferCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfo* vi);
+
+/*
+/// Starts SVTL_submitCommandBuffer and returns without waiting for it to complete. The vertices must not be accessed until the fence is waited on. The command buffer may be modified or destroyed as soon as this returns.
+/// @param SVTL_Fence* fenceOut - signalled when the operation completes
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_submitCommandBufferAsync(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfo* vi, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_submitCommandBufferAsync, but runs on the given context.*/
+SVTL_API errno_t SVTL_submitCommandBufferAsyncCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfo* vi, SVTL_Fence* fenceOut);
+
+/*
+/// Identical to SVTL_submitCommandBuffer, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_submitCommandBufferSoA(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoSoA* vi);
+SVTL_API errno_t SVTL_submitCommandBufferSoACtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoSoA* vi);
+SVTL_API errno_t SVTL_submitCommandBufferSoAAsync(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoSoA* vi, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_submitCommandBufferSoAAsyncCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoSoA* vi, SVTL_Fence* fenceOut);
 
 /*
-/// Converts a list of unindexed vertices to indexed vertices
+/// Executes the recorded commands on the positions of src and writes the result to dst, leaving src unchanged. See SVTL_applyAffine2DTo.
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_submitCommandBufferTo(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, bool copyVertices);
+SVTL_API errno_t SVTL_submitCommandBufferToCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, bool copyVertices);
+SVTL_API errno_t SVTL_submitCommandBufferToAsync(SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, bool copyVertices, SVTL_Fence* fenceOut);
+SVTL_API errno_t SVTL_submitCommandBufferToAsyncCtx(SVTL_Context ctx, SVTL_CommandBuffer cmd, const struct SVTL_VertexInfoReadOnly* src, const struct SVTL_VertexInfo* dst, bool copyVertices, SVTL_Fence* fenceOut);
+
+/*
+/// Returns true once the operation of the fence has completed. The fence must still be passed to SVTL_waitFence.
+/// @param SVTL_Fence fence - the fence of an asynchronous operation*/
+SVTL_API bool SVTL_pollFence(SVTL_Fence fence);
+
+/*
+/// Waits for the operation of the fence to complete and releases the fence.
+/// Operations below the parallel threshold run on the calling thread, so their fences are already signalled.
+/// The settings of the context must not be changed, nor the context destroyed, while it has fences that have not been waited on.
+/// @param SVTL_Fence fence - the fence of an asynchronous operation
+/// @return errno_t - error code: 0 on success, -1 if a task failed to join */
+SVTL_API errno_t SVTL_waitFence(SVTL_Fence fence);
+
+/*
+/// Converts a list of unindexed vertices to indexed vertices. Vertices are equal when all vi.stride bytes of them match.
+/// The new vertices are the first occurrences of each vertex, in the order they occur.
+/// At or above the parallel threshold the vertices are split into shards by hash, which are deduplicated concurrently.
+/// The result is the same for any worker count. SVTL_unindexedToIndexed2D does not need SVTL_register, but runs serially without it.
 /// @param SVTL_VertexInfo* vi - vertex info
 /// @param void* verticesOut - a buffer to hold the new list of vertices. It must have a size of vertexCountOut * vi.stride
 /// @param void* indicesOut - a buffer to hold the list of indices. It must have a size of indexCountOut * sizeof(u32)
 /// @param uint32_t* vertexCountOut - the count of the new list of vertices
 /// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_unindexedToIndexed2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut);
 SVTL_API errno_t SVTL_unindexedToIndexed2D(const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut);
 
+/*
+/// Converts a list of unindexed vertices to indexed vertices, merging vertices whose positions are within a tolerance of each other.
+/// Each vertex is merged into the first earlier vertex kept within the tolerance, and is kept otherwise. Kept vertices are copied unchanged.
+/// Positions are compared by their euclidean distance, including z for VEC3 position types. Runs on the calling thread.
+/// @param SVTL_VertexInfo* vi - vertex info
+/// @param double tolerance - the largest distance between merged positions. 0 merges equal positions only
+/// @param bool compareAttributes - whether the bytes of the vertices outside their positions must also be equal to merge them
+/// @param void* verticesOut - a buffer to hold the new list of vertices. It must have a size of vertexCountOut * vi.stride
+/// @param void* indicesOut - a buffer to hold the list of indices. It must have a size of indexCountOut * sizeof(u32)
+/// @param uint32_t* vertexCountOut - the count of the new list of vertices
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_weldVertices2D(const struct SVTL_VertexInfoReadOnly* vi, double tolerance, bool compareAttributes,
+    void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut);
+
+/*
+/// Creates an indexer with no table. The table is sized by the first conversion or by SVTL_reserveIndexer.
+/// @param SVTL_Indexer* indexerOut - the new indexer
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_createIndexer(SVTL_Indexer* indexerOut);
+
+/*
+/// Destroys an indexer and its table.
+/// @param SVTL_Indexer indexer - the indexer to destroy */
+SVTL_API void SVTL_destroyIndexer(SVTL_Indexer indexer);
+
+/*
+/// Sizes the table of an indexer for meshes of up to vertexCount vertices of the given stride, so converting them does not grow it.
+/// The table is only reallocated if the stride differs or it was sized for fewer vertices.
+/// @return errno_t - error code: 0 on success, -1 upon failure or during a stream */
+SVTL_API errno_t SVTL_reserveIndexer(SVTL_Indexer indexer, uint32_t stride, uint32_t vertexCount);
+
+/*
+/// Converts a list of unindexed vertices to indexed vertices like SVTL_unindexedToIndexed2D, through the table of the indexer.
+/// The table is sized from vi.count and cleared between calls, so a mesh no larger than the ones before it, with the same stride,
+/// is converted without allocating. Runs on the calling thread. An indexer must not be used by several threads at once.
+/// @param SVTL_Indexer indexer - the indexer
+/// @return errno_t - error code: 0 on success, -1 upon failure or during a stream */
+SVTL_API errno_t SVTL_indexerUnindexedToIndexed2D(SVTL_Indexer indexer, const struct SVTL_VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut);
+
+/*
+/// Starts a stream of vertices, which are indexed in chunks by SVTL_indexerPush as they arrive, so the whole unindexed list is never needed at once.
+/// Any stream in progress is discarded. The table copies the vertices, so each chunk may be freed once pushed.
+/// The indexer cannot convert meshes or be reserved until SVTL_indexerEnd.
+/// @param SVTL_Indexer indexer - the indexer
+/// @param uint32_t stride - the stride of every chunk
+/// @param uint32_t expectedVertexCount - the number of distinct vertices the table is sized for. More may be pushed, at the cost of growing it
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_indexerBegin(SVTL_Indexer indexer, uint32_t stride, uint32_t expectedVertexCount);
+
+/*
+/// Indexes the next chunk of a stream. Vertices equal to a vertex of an earlier chunk get its index, and the others are appended to the new vertices.
+/// Indices count the vertices of the whole stream, in the order they were first pushed. Only chunk.vertices, chunk.stride and chunk.count are read.
+/// If the chunk cannot be indexed, the stream ends and must be started again.
+/// @param SVTL_Indexer indexer - the indexer
+/// @param SVTL_VertexInfoReadOnly* chunk - the vertices of the chunk. The stride must be the one given to SVTL_indexerBegin
+/// @param void* newVerticesOut - a buffer to hold the vertices first seen in this chunk. It must have a size of newVertexCountOut * chunk.stride, at most chunk.count * chunk.stride
+/// @param uint32_t* newVertexCountOut - the count of the vertices first seen in this chunk
+/// @param uint32_t* indicesOut - a buffer to hold an index for each vertex of the chunk. It must have a size of chunk.count * sizeof(u32)
+/// @return errno_t - error code: 0 on success, -1 upon failure */
+SVTL_API errno_t SVTL_indexerPush(SVTL_Indexer indexer, const struct SVTL_VertexInfoReadOnly* chunk, void* newVerticesOut, uint32_t* newVertexCountOut, uint32_t* indicesOut);
+
+/*
+/// Ends a stream. The table is kept, sized for the stream, for the next stream or conversion.
+/// @param SVTL_Indexer indexer - the indexer
+/// @param uint32_t* vertexCountOut - the count of distinct vertices of the stream
+/// @param uint32_t* indexCountOut - the count of vertices pushed
+/// @return errno_t - error code: 0 on success, -1 if no stream was in progress */
+SVTL_API errno_t SVTL_indexerEnd(SVTL_Indexer indexer, uint32_t* vertexCountOut, uint32_t* indexCountOut);
+
 /*
 /// Returns the signed area of a simple closed polygon.
 /// @param SVTL_VertexInfo* vi - vertex info
 /// @return double - the signed area of the polygon */
 SVTL_API double SVTL_findSignedArea(const struct SVTL_VertexInfoReadOnly* vi, errno_t* err);
 
+/*
+/// Identical to SVTL_findSignedArea, but runs on the given context.*/
+SVTL_API double SVTL_findSignedAreaCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* vi, errno_t* err);
+
 /*
 /// Returns the centroid of a simple closed polygon.
 /// @param SVTL_VertexInfo* vi - vertex info
 /// @return SVTL_F64Vec2 - the centroid of the polygon */
 SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2D(const struct SVTL_VertexInfoReadOnly* vi, errno_t* err);
 
+/*
+/// Identical to SVTL_findCentroid2D, but runs on the given context.*/
+SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2DCtx(SVTL_Context ctx, const struct SVTL_VertexInfoReadOnly* vi, errno_t* err);
+
+/*
+/// Identical to SVTL_findSignedArea and SVTL_findCentroid2D, but for vertices with separate x and y arrays.*/
+SVTL_API double SVTL_findSignedAreaSoA(const struct SVTL_VertexInfoSoAReadOnly* vi, errno_t* err);
+SVTL_API double SVTL_findSignedAreaSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoAReadOnly* vi, errno_t* err);
+SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2DSoA(const struct SVTL_VertexInfoSoAReadOnly* vi, errno_t* err);
+SVTL_API struct SVTL_F64Vec2 SVTL_findCentroid2DSoACtx(SVTL_Context ctx, const struct SVTL_VertexInfoSoAReadOnly* vi, errno_t* err);
+
 /*
 /// Extracts the positions of the given vertices and stores them in an array with a size of (vi.count * sizeof(SVTL_F64Vec2))
 /// @param SVTL_VertexInfo* vi - vertex info
@@ -235,4 +1005,9 @@ SVTL_API errno_t SVTL_extractVertexPositions2D(const struct SVTL_VertexInfoReadO
 /// @return errno_t - error code: 0 on success, -1 upon failure */
 SVTL_API errno_t SVTL_extractVertexPositions2D_s(const struct SVTL_VertexInfoReadOnly* vi, struct SVTL_F64Vec2* positionsOut, uint64_t posBuffSize);
 
+/*
+/// Identical to SVTL_extractVertexPositions2D and SVTL_extractVertexPositions2D_s, but for vertices with separate x and y arrays.*/
+SVTL_API errno_t SVTL_extractVertexPositions2DSoA(const struct SVTL_VertexInfoSoAReadOnly* vi, struct SVTL_F64Vec2* positionsOut);
+SVTL_API errno_t SVTL_extractVertexPositions2DSoA_s(const struct SVTL_VertexInfoSoAReadOnly* vi, struct SVTL_F64Vec2* positionsOut, uint64_t posBuffSize);
+
 #endif /*!SVTL_H*/
\ No newline at end of file
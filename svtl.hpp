@@ -52,10 +52,40 @@ namespace svtl
         struct SVTL_F64Vec2 center;
     };
 
+    struct F64Mat2x3
+    {
+        double m[2][3];
+    };
+
+    /*row-major 3x3 projective matrix applied to (x, y, 1), followed by the division by w*/
+    struct F64Mat3x3
+    {
+        double m[3][3];
+    };
+
+    /*row-major, applied to column vectors. The 3D transforms require a bottom row of (0, 0, 0, 1)*/
+    struct F64Mat4x4
+    {
+        double m[4][4];
+    };
+
+    struct F64Quat
+    {
+        double x;
+        double y;
+        double z;
+        double w;
+    };
+
     enum class POSITION_TYPE
     {
         Vec2F32,
         Vec2F64,
+        Vec2F16,
+        Vec2I16Norm,
+        Vec2I32Fixed,
+        Vec3F32,
+        Vec3F64,
     };
 
     
@@ -72,6 +102,14 @@ namespace svtl
         TriangleFan
     };
 
+    enum class SIMD_LEVEL
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512,
+    };
+
     struct VertexInfo
     {
         uint32_t stride;
@@ -98,6 +136,46 @@ namespace svtl
         bool primitiveRestartEnabled;
     };
 
+    /*positions held as separate packed x and y arrays. The in-place transforms, batch transform, command buffer submits, area, centroid
+    and position extraction have an overload that takes it in place of VertexInfo; the out-of-place transforms do not*/
+    struct VertexInfoSoA
+    {
+        uint32_t count;
+        void* x;
+        void* y;
+        void* indices;
+        enum POSITION_TYPE positionType;
+        enum INDEX_TYPE indexType;
+        enum TOPOLOGY_TYPE topologyType;
+        bool primitiveRestartEnabled;
+        void* z; /*Vec3 position types only*/
+    };
+
+    struct VertexInfoSoAReadOnly
+    {
+        uint32_t count;
+        const void* x;
+        const void* y;
+        const void* indices;
+        enum POSITION_TYPE positionType;
+        enum INDEX_TYPE indexType;
+        enum TOPOLOGY_TYPE topologyType;
+        bool primitiveRestartEnabled;
+        const void* z; /*Vec3 position types only*/
+    };
+
+    struct Affine2DBatchItem
+    {
+        struct VertexInfo vi;
+        struct F64Mat2x3 transform;
+    };
+
+    struct Affine2DBatchItemSoA
+    {
+        struct VertexInfoSoA vi;
+        struct F64Mat2x3 transform;
+    };
+
     /*
     /// Registers a usage of the Simple Vertex Transformation Library.
     /// @return errno_t - error code: 0 on success, -1 upon failure */
@@ -112,6 +190,110 @@ namespace svtl
         SVTL_unregister();
     }
 
+    /*
+    /// Sets the number of tasks each operation is split into, and the number of threads in the default thread pool.
+    /// @param uint32_t count - the number of workers, or 0 to use the number of online CPUs */
+    inline void setWorkerCount(uint32_t count) {
+        SVTL_setWorkerCount(count);
+    }
+
+    /*
+    /// Returns the number of tasks each operation is split into.*/
+    inline uint32_t getWorkerCount(void) {
+        return SVTL_getWorkerCount();
+    }
+
+    /*
+    /// Sets the element count below which an operation runs on the calling thread.
+    /// @param uint32_t count - the threshold, 0 to always split operations across the workers */
+    inline void setParallelThreshold(uint32_t count) {
+        SVTL_setParallelThreshold(count);
+    }
+
+    /*
+    /// Returns the element count below which an operation runs on the calling thread.*/
+    inline uint32_t getParallelThreshold(void) {
+        return SVTL_getParallelThreshold();
+    }
+
+    /*
+    /// Sets how many times a join polls a task of the default thread pool before it sleeps.
+    /// @param uint32_t count - the number of polls, 0 to sleep straight away */
+    inline void setJoinSpinCount(uint32_t count) {
+        SVTL_setJoinSpinCount(count);
+    }
+
+    /*
+    /// Returns how many times a join polls a task before it sleeps.*/
+    inline uint32_t getJoinSpinCount(void) {
+        return SVTL_getJoinSpinCount();
+    }
+
+    /*
+    /// Returns the instruction set the vertex kernels use.*/
+    inline SIMD_LEVEL getSimdLevel(void) {
+        return (SIMD_LEVEL)SVTL_getSimdLevel();
+    }
+
+    typedef SVTL_Context Context;
+    typedef SVTL_Fence Fence;
+
+    /*
+    /// Returns true once the operation of the fence has completed.*/
+    inline bool pollFence(Fence fence) {
+        return SVTL_pollFence(fence);
+    }
+
+    /*
+    /// Waits for the operation of the fence to complete and releases the fence.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t waitFence(Fence fence) {
+        return SVTL_waitFence(fence);
+    }
+
+    /*
+    /// Creates a context with its own thread pool. Every operation has an overload that takes the context as its first argument.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t createContext(Context* ctxOut) {
+        return SVTL_createContext(ctxOut);
+    }
+
+    /*
+    /// Destroys a context and its thread pool.*/
+    inline void destroyContext(Context ctx) {
+        SVTL_destroyContext(ctx);
+    }
+
+    /*
+    /// Returns the context used by the overloads that do not take a context.*/
+    inline Context getDefaultContext(void) {
+        return SVTL_getDefaultContext();
+    }
+
+    inline void setWorkerCount(Context ctx, uint32_t count) {
+        SVTL_setWorkerCountCtx(ctx, count);
+    }
+
+    inline uint32_t getWorkerCount(Context ctx) {
+        return SVTL_getWorkerCountCtx(ctx);
+    }
+
+    inline void setParallelThreshold(Context ctx, uint32_t count) {
+        SVTL_setParallelThresholdCtx(ctx, count);
+    }
+
+    inline uint32_t getParallelThreshold(Context ctx) {
+        return SVTL_getParallelThresholdCtx(ctx);
+    }
+
+    inline void setJoinSpinCount(Context ctx, uint32_t count) {
+        SVTL_setJoinSpinCountCtx(ctx, count);
+    }
+
+    inline uint32_t getJoinSpinCount(Context ctx) {
+        return SVTL_getJoinSpinCountCtx(ctx);
+    }
+
     /*
     /// Translates the positions of the given vertices by displacement units.
     /// @param SVTL_VertexInfo* vi - vertex info
@@ -122,6 +304,23 @@ namespace svtl
         return SVTL_translate2D((SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&displacement);
     }
 
+    inline errno_t translate2D(Context ctx, const struct VertexInfo* vi, struct F64Vec2 displacement)
+    {
+        return SVTL_translate2DCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&displacement);
+    }
+
+    /*
+    /// Starts translate2D and returns without waiting for it. The fence must be passed to waitFence.*/
+    inline errno_t translate2DAsync(const struct VertexInfo* vi, struct F64Vec2 displacement, Fence* fenceOut)
+    {
+        return SVTL_translate2DAsync((SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&displacement, fenceOut);
+    }
+
+    inline errno_t translate2DAsync(Context ctx, const struct VertexInfo* vi, struct F64Vec2 displacement, Fence* fenceOut)
+    {
+        return SVTL_translate2DAsyncCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&displacement, fenceOut);
+    }
+
     /*
     /// Rotates the positions of the given vertices around the origin by radians.
     /// @param SVTL_VertexInfo* vi - vertex info
@@ -133,8 +332,26 @@ namespace svtl
         return SVTL_rotate2D((SVTL_VertexInfo*)vi, radians, *(SVTL_F64Vec2*)&origin);
     }
 
+    inline errno_t rotate2D(Context ctx, const struct VertexInfo* vi, double radians, struct F64Vec2 origin)
+    {
+        return SVTL_rotate2DCtx(ctx, (SVTL_VertexInfo*)vi, radians, *(SVTL_F64Vec2*)&origin);
+    }
+
+    /*
+    /// Starts rotate2D and returns without waiting for it. The fence must be passed to waitFence.*/
+    inline errno_t rotate2DAsync(const struct VertexInfo* vi, double radians, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate2DAsync((SVTL_VertexInfo*)vi, radians, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
+    inline errno_t rotate2DAsync(Context ctx, const struct VertexInfo* vi, double radians, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate2DAsyncCtx(ctx, (SVTL_VertexInfo*)vi, radians, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
     /*
     /// Dilates the positions of the given vertices around the origin by the scaleFactor.
+    /// Versions before the affine-matrix transforms added origin.x back to y rather than origin.y, so results differ from them unless origin.x == origin.y.
     /// @param SVTL_VertexInfo* vi - vertex info
     /// @param SVTL_F64Vec2 scaleFactor - scale factor.
     /// @param SVTL_F64Vec2 origin - the origin of the dilation.
@@ -144,8 +361,26 @@ namespace svtl
         return SVTL_scale2D((SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin);
     }
 
+    inline errno_t scale2D(Context ctx, const struct VertexInfo* vi, struct F64Vec2 scaleFactor, struct F64Vec2 origin)
+    {
+        return SVTL_scale2DCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin);
+    }
+
+    /*
+    /// Starts scale2D and returns without waiting for it. The fence must be passed to waitFence.*/
+    inline errno_t scale2DAsync(const struct VertexInfo* vi, struct F64Vec2 scaleFactor, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_scale2DAsync((SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
+    inline errno_t scale2DAsync(Context ctx, const struct VertexInfo* vi, struct F64Vec2 scaleFactor, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_scale2DAsyncCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
     /*
-    /// Skews the positions of the given vertices around the origin by the skewFactor.
+    /// Skews the positions of the given vertices around the origin by the skewFactor. Relative to the origin, x is sheared first, x' = x + skewFactor.x*y,
+    /// then y by the sheared x, y' = y + skewFactor.y*x'.
     /// @param SVTL_VertexInfo* vi - vertex info
     /// @param SVTL_F64Vec2 skewFactor - skew factor.
     /// @param SVTL_F64Vec2 origin - the origin of the skew.
@@ -155,8 +390,26 @@ namespace svtl
         return SVTL_skew2D((SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin);
     }
 
+    inline errno_t skew2D(Context ctx, const struct VertexInfo* vi, struct F64Vec2 skewFactor, struct F64Vec2 origin)
+    {
+        return SVTL_skew2DCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin);
+    }
+
+    /*
+    /// Starts skew2D and returns without waiting for it. The fence must be passed to waitFence.*/
+    inline errno_t skew2DAsync(const struct VertexInfo* vi, struct F64Vec2 skewFactor, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_skew2DAsync((SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
+    inline errno_t skew2DAsync(Context ctx, const struct VertexInfo* vi, struct F64Vec2 skewFactor, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_skew2DAsyncCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
     /*
     /// Mirrors the positions of the given vertices around the mirror line.
+    /// Versions before the affine-matrix transforms rotated onto the line and back without reflecting, leaving the vertices unchanged.
     /// @param SVTL_VertexInfo* vi - vertex info
     /// @param SVTL_F64Line2 mirrorLine - the line around which the mirror is performed
     /// @return errno_t - error code: 0 on success, -1 upon failure */
@@ -165,53 +418,894 @@ namespace svtl
         return SVTL_mirror2D((SVTL_VertexInfo*)vi, *(SVTL_F64Line2*)&mirrorLine);
     }
 
+    inline errno_t mirror2D(Context ctx, const struct VertexInfo* vi, struct F64Line2 mirrorLine)
+    {
+        return SVTL_mirror2DCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Line2*)&mirrorLine);
+    }
+
     /*
-    /// Converts a list of unindexed vertices to indexed vertices
-    /// @param SVTL_VertexInfo* vi - vertex info
-    /// @param void* verticesOut - a buffer to hold the new list of vertices. It must have a size of vertexCountOut * vi.stride
-    /// @param void* indicesOut - a buffer to hold the list of indices. It must have a size of indexCountOut * sizeof(u32)
-    /// @param uint32_t* vertexCountOut - the count of the new list of vertices
+    /// Starts mirror2D and returns without waiting for it. The fence must be passed to waitFence.*/
+    inline errno_t mirror2DAsync(const struct VertexInfo* vi, struct F64Line2 mirrorLine, Fence* fenceOut)
+    {
+        return SVTL_mirror2DAsync((SVTL_VertexInfo*)vi, *(SVTL_F64Line2*)&mirrorLine, fenceOut);
+    }
+
+    inline errno_t mirror2DAsync(Context ctx, const struct VertexInfo* vi, struct F64Line2 mirrorLine, Fence* fenceOut)
+    {
+        return SVTL_mirror2DAsyncCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Line2*)&mirrorLine, fenceOut);
+    }
+
+    /*
+    /// Returns the identity affine matrix. */
+    inline F64Mat2x3 mat2x3Identity(void)
+    {
+        const SVTL_F64Mat2x3 m = SVTL_mat2x3Identity();
+        return *(const F64Mat2x3*)&m;
+    }
+
+    /*
+    /// Composes two affine matrices. Applying the result is equivalent to applying rhs, then lhs.
+    /// @param F64Mat2x3 lhs - the transform applied second
+    /// @param F64Mat2x3 rhs - the transform applied first
+    /// @return F64Mat2x3 - lhs * rhs */
+    inline F64Mat2x3 mat2x3Multiply(F64Mat2x3 lhs, F64Mat2x3 rhs)
+    {
+        const SVTL_F64Mat2x3 m = SVTL_mat2x3Multiply(*(SVTL_F64Mat2x3*)&lhs, *(SVTL_F64Mat2x3*)&rhs);
+        return *(const F64Mat2x3*)&m;
+    }
+
+    /*
+    /// Returns an affine matrix that translates by displacement units. */
+    inline F64Mat2x3 mat2x3Translate(F64Vec2 displacement)
+    {
+        const SVTL_F64Mat2x3 m = SVTL_mat2x3Translate(*(SVTL_F64Vec2*)&displacement);
+        return *(const F64Mat2x3*)&m;
+    }
+
+    /*
+    /// Returns an affine matrix that rotates around the origin by radians. */
+    inline F64Mat2x3 mat2x3Rotate(double radians, F64Vec2 origin)
+    {
+        const SVTL_F64Mat2x3 m = SVTL_mat2x3Rotate(radians, *(SVTL_F64Vec2*)&origin);
+        return *(const F64Mat2x3*)&m;
+    }
+
+    /*
+    /// Returns an affine matrix that dilates around the origin by the scaleFactor. */
+    inline F64Mat2x3 mat2x3Scale(F64Vec2 scaleFactor, F64Vec2 origin)
+    {
+        const SVTL_F64Mat2x3 m = SVTL_mat2x3Scale(*(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin);
+        return *(const F64Mat2x3*)&m;
+    }
+
+    /*
+    /// Returns an affine matrix that skews around the origin by the skewFactor, shearing x first and then y by the sheared x. */
+    inline F64Mat2x3 mat2x3Skew(F64Vec2 skewFactor, F64Vec2 origin)
+    {
+        const SVTL_F64Mat2x3 m = SVTL_mat2x3Skew(*(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin);
+        return *(const F64Mat2x3*)&m;
+    }
+
+    /*
+    /// Returns an affine matrix that mirrors around the mirror line. */
+    inline F64Mat2x3 mat2x3Mirror(F64Line2 mirrorLine)
+    {
+        const SVTL_F64Mat2x3 m = SVTL_mat2x3Mirror(*(SVTL_F64Line2*)&mirrorLine);
+        return *(const F64Mat2x3*)&m;
+    }
+
+    /*
+    /// Applies an affine transform to the positions of the given vertices in a single pass.
+    /// @param VertexInfo* vi - vertex info
+    /// @param F64Mat2x3 transform - the affine transform to apply
     /// @return errno_t - error code: 0 on success, -1 upon failure */
-    inline errno_t unindexedToIndexed2D(const struct VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
+    inline errno_t applyAffine2D(const struct VertexInfo* vi, F64Mat2x3 transform)
     {
-       return SVTL_unindexedToIndexed2D((const SVTL_VertexInfoReadOnly*)vi, verticesOut, vertexCountOut, indicesOut, indexCountOut);
+        return SVTL_applyAffine2D((SVTL_VertexInfo*)vi, *(SVTL_F64Mat2x3*)&transform);
+    }
+
+    inline errno_t applyAffine2D(Context ctx, const struct VertexInfo* vi, F64Mat2x3 transform)
+    {
+        return SVTL_applyAffine2DCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Mat2x3*)&transform);
     }
 
     /*
-    /// Returns the signed area of a simple closed polygon.
-    /// @param SVTL_VertexInfo* vi - vertex info
-    /// @return double - the signed area of the polygon. */
-    inline double findSignedArea(const struct VertexInfoReadOnly* vi, errno_t* err)
+    /// Starts applyAffine2D and returns without waiting for it. The fence must be passed to waitFence.*/
+    inline errno_t applyAffine2DAsync(const struct VertexInfo* vi, F64Mat2x3 transform, Fence* fenceOut)
     {
-        return SVTL_findSignedArea((const SVTL_VertexInfoReadOnly*)vi, err);
+        return SVTL_applyAffine2DAsync((SVTL_VertexInfo*)vi, *(SVTL_F64Mat2x3*)&transform, fenceOut);
     }
 
-   /*
-    /// Returns the centroid of a simple closed polygon.
-    /// @param SVTL_VertexInfo* vi - vertex info
-    /// @return SVTL_F64Vec2 - the centroid of the polygon */
-    inline F64Vec2 findCentroid2D(const struct VertexInfoReadOnly* vi, errno_t* err)
+    inline errno_t applyAffine2DAsync(Context ctx, const struct VertexInfo* vi, F64Mat2x3 transform, Fence* fenceOut)
     {
-        const SVTL_F64Vec2 v2 = SVTL_findCentroid2D((const SVTL_VertexInfoReadOnly*)vi, err);
-        return {v2.x, v2.y};
+        return SVTL_applyAffine2DAsyncCtx(ctx, (SVTL_VertexInfo*)vi, *(SVTL_F64Mat2x3*)&transform, fenceOut);
     }
-    
+
     /*
-    /// Extracts the positions of the given vertices and stores them in an array with a size of (vi.count * sizeof(SVTL_F64Vec2))
-    /// @param SVTL_VertexInfo* vi - vertex info
-    /// @param SVTL_F64Vec2* positionsOut - the buffer to store the positions*/
-    inline errno_t extractVertexPositions2D(const struct VertexInfo* vi, F64Vec2* positionsOut)
+    /// Applies an affine transform to the positions of src and writes the result to dst, leaving src unchanged.
+    /// @param bool copyVertices - also copy the remaining bytes of each vertex
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t applyAffine2DTo(const struct VertexInfoReadOnly* src, const struct VertexInfo* dst, F64Mat2x3 transform, bool copyVertices)
     {
-        return SVTL_extractVertexPositions2D((const SVTL_VertexInfoReadOnly*)vi, (SVTL_F64Vec2*)positionsOut);
+        return SVTL_applyAffine2DTo((const SVTL_VertexInfoReadOnly*)src, (const SVTL_VertexInfo*)dst, *(SVTL_F64Mat2x3*)&transform, copyVertices);
+    }
+
+    inline errno_t applyAffine2DTo(Context ctx, const struct VertexInfoReadOnly* src, const struct VertexInfo* dst, F64Mat2x3 transform, bool copyVertices)
+    {
+        return SVTL_applyAffine2DToCtx(ctx, (const SVTL_VertexInfoReadOnly*)src, (const SVTL_VertexInfo*)dst, *(SVTL_F64Mat2x3*)&transform, copyVertices);
+    }
+
+    inline errno_t applyAffine2DToAsync(const struct VertexInfoReadOnly* src, const struct VertexInfo* dst, F64Mat2x3 transform, bool copyVertices, Fence* fenceOut)
+    {
+        return SVTL_applyAffine2DToAsync((const SVTL_VertexInfoReadOnly*)src, (const SVTL_VertexInfo*)dst, *(SVTL_F64Mat2x3*)&transform, copyVertices, fenceOut);
+    }
+
+    inline errno_t applyAffine2DToAsync(Context ctx, const struct VertexInfoReadOnly* src, const struct VertexInfo* dst, F64Mat2x3 transform, bool copyVertices, Fence* fenceOut)
+    {
+        return SVTL_applyAffine2DToAsyncCtx(ctx, (const SVTL_VertexInfoReadOnly*)src, (const SVTL_VertexInfo*)dst, *(SVTL_F64Mat2x3*)&transform, copyVertices, fenceOut);
     }
 
     /*
-    /// Extracts the positions of the given vertices and stores them in an array with a size of (vi.count * sizeof(SVTL_F64Vec2))
-    /// Identical to SVTL_ExtractVertexPositions2D, except it checks to ensure that the buffer length is of the correct size.
-    /// @param SVTL_VertexInfo* vi - vertex info
-    /// @param SVTL_F64Vec2* positionsOut - the buffer to store the positions*/
-    inline errno_t extractVertexPositions2D_s(const struct VertexInfo* vi, F64Vec2* positionsOut, uint64_t buffSize)
+    /// Applies each item's transform to the item's vertices, with a single fork and join for the whole batch.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t applyAffine2DBatch(const Affine2DBatchItem* items, uint32_t itemCount)
     {
-        return SVTL_extractVertexPositions2D_s((const SVTL_VertexInfoReadOnly*)vi, (SVTL_F64Vec2*)positionsOut, buffSize);
+        return SVTL_applyAffine2DBatch((const SVTL_Affine2DBatchItem*)items, itemCount);
+    }
+
+    inline errno_t applyAffine2DBatch(Context ctx, const Affine2DBatchItem* items, uint32_t itemCount)
+    {
+        return SVTL_applyAffine2DBatchCtx(ctx, (const SVTL_Affine2DBatchItem*)items, itemCount);
+    }
+
+    inline errno_t applyAffine2DBatch(const Affine2DBatchItemSoA* items, uint32_t itemCount)
+    {
+        return SVTL_applyAffine2DBatchSoA((const SVTL_Affine2DBatchItemSoA*)items, itemCount);
+    }
+
+    inline errno_t applyAffine2DBatch(Context ctx, const Affine2DBatchItemSoA* items, uint32_t itemCount)
+    {
+        return SVTL_applyAffine2DBatchSoACtx(ctx, (const SVTL_Affine2DBatchItemSoA*)items, itemCount);
+    }
+
+    typedef SVTL_CommandBuffer CommandBuffer;
+
+    /*
+    /// Creates an empty command buffer.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t createCommandBuffer(CommandBuffer* cmdOut)
+    {
+        return SVTL_createCommandBuffer(cmdOut);
+    }
+
+    /*
+    /// Destroys a command buffer. */
+    inline void destroyCommandBuffer(CommandBuffer cmd)
+    {
+        SVTL_destroyCommandBuffer(cmd);
+    }
+
+    /*
+    /// Clears all recorded commands. */
+    inline void resetCommandBuffer(CommandBuffer cmd)
+    {
+        SVTL_resetCommandBuffer(cmd);
+    }
+
+    inline errno_t cmdTranslate2D(CommandBuffer cmd, F64Vec2 displacement)
+    {
+        return SVTL_cmdTranslate2D(cmd, *(SVTL_F64Vec2*)&displacement);
+    }
+
+    inline errno_t cmdRotate2D(CommandBuffer cmd, double radians, F64Vec2 origin)
+    {
+        return SVTL_cmdRotate2D(cmd, radians, *(SVTL_F64Vec2*)&origin);
+    }
+
+    inline errno_t cmdScale2D(CommandBuffer cmd, F64Vec2 scaleFactor, F64Vec2 origin)
+    {
+        return SVTL_cmdScale2D(cmd, *(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin);
+    }
+
+    inline errno_t cmdSkew2D(CommandBuffer cmd, F64Vec2 skewFactor, F64Vec2 origin)
+    {
+        return SVTL_cmdSkew2D(cmd, *(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin);
+    }
+
+    inline errno_t cmdMirror2D(CommandBuffer cmd, F64Line2 mirrorLine)
+    {
+        return SVTL_cmdMirror2D(cmd, *(SVTL_F64Line2*)&mirrorLine);
+    }
+
+    inline errno_t cmdAffine2D(CommandBuffer cmd, F64Mat2x3 transform)
+    {
+        return SVTL_cmdAffine2D(cmd, *(SVTL_F64Mat2x3*)&transform);
+    }
+
+    /*
+    /// Executes the recorded commands, in order, on the given vertices in a single sweep.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t submitCommandBuffer(CommandBuffer cmd, const struct VertexInfo* vi)
+    {
+        return SVTL_submitCommandBuffer(cmd, (SVTL_VertexInfo*)vi);
+    }
+
+    inline errno_t submitCommandBuffer(Context ctx, CommandBuffer cmd, const struct VertexInfo* vi)
+    {
+        return SVTL_submitCommandBufferCtx(ctx, cmd, (SVTL_VertexInfo*)vi);
+    }
+
+    /*
+    /// Starts submitCommandBuffer and returns without waiting for it. The fence must be passed to waitFence.*/
+    inline errno_t submitCommandBufferAsync(CommandBuffer cmd, const struct VertexInfo* vi, Fence* fenceOut)
+    {
+        return SVTL_submitCommandBufferAsync(cmd, (SVTL_VertexInfo*)vi, fenceOut);
+    }
+
+    inline errno_t submitCommandBufferAsync(Context ctx, CommandBuffer cmd, const struct VertexInfo* vi, Fence* fenceOut)
+    {
+        return SVTL_submitCommandBufferAsyncCtx(ctx, cmd, (SVTL_VertexInfo*)vi, fenceOut);
+    }
+
+    /*
+    /// Executes the recorded commands on the positions of src and writes the result to dst, leaving src unchanged.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t submitCommandBufferTo(CommandBuffer cmd, const struct VertexInfoReadOnly* src, const struct VertexInfo* dst, bool copyVertices)
+    {
+        return SVTL_submitCommandBufferTo(cmd, (const SVTL_VertexInfoReadOnly*)src, (const SVTL_VertexInfo*)dst, copyVertices);
+    }
+
+    inline errno_t submitCommandBufferTo(Context ctx, CommandBuffer cmd, const struct VertexInfoReadOnly* src, const struct VertexInfo* dst, bool copyVertices)
+    {
+        return SVTL_submitCommandBufferToCtx(ctx, cmd, (const SVTL_VertexInfoReadOnly*)src, (const SVTL_VertexInfo*)dst, copyVertices);
+    }
+
+    inline errno_t submitCommandBufferToAsync(CommandBuffer cmd, const struct VertexInfoReadOnly* src, const struct VertexInfo* dst, bool copyVertices, Fence* fenceOut)
+    {
+        return SVTL_submitCommandBufferToAsync(cmd, (const SVTL_VertexInfoReadOnly*)src, (const SVTL_VertexInfo*)dst, copyVertices, fenceOut);
+    }
+
+    inline errno_t submitCommandBufferToAsync(Context ctx, CommandBuffer cmd, const struct VertexInfoReadOnly* src, const struct VertexInfo* dst, bool copyVertices, Fence* fenceOut)
+    {
+        return SVTL_submitCommandBufferToAsyncCtx(ctx, cmd, (const SVTL_VertexInfoReadOnly*)src, (const SVTL_VertexInfo*)dst, copyVertices, fenceOut);
+    }
+
+    /*
+    /// Converts a list of unindexed vertices to indexed vertices
+    /// @param SVTL_VertexInfo* vi - vertex info
+    /// @param void* verticesOut - a buffer to hold the new list of vertices. It must have a size of vertexCountOut * vi.stride
+    /// @param void* indicesOut - a buffer to hold the list of indices. It must have a size of indexCountOut * sizeof(u32)
+    /// @param uint32_t* vertexCountOut - the count of the new list of vertices
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t unindexedToIndexed2D(const struct VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
+    {
+       return SVTL_unindexedToIndexed2D((const SVTL_VertexInfoReadOnly*)vi, verticesOut, vertexCountOut, indicesOut, indexCountOut);
+    }
+    inline errno_t unindexedToIndexed2D(Context ctx, const struct VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
+    {
+       return SVTL_unindexedToIndexed2DCtx(ctx, (const SVTL_VertexInfoReadOnly*)vi, verticesOut, vertexCountOut, indicesOut, indexCountOut);
+    }
+
+    /*
+    /// Converts a list of unindexed vertices to indexed vertices, merging vertices whose positions are within a tolerance of each other.
+    /// Each vertex is merged into the first earlier vertex kept within the tolerance, and is kept otherwise
+    /// @param double tolerance - the largest distance between merged positions. 0 merges equal positions only
+    /// @param bool compareAttributes - whether the bytes of the vertices outside their positions must also be equal to merge them
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t weldVertices2D(const struct VertexInfoReadOnly* vi, double tolerance, bool compareAttributes, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
+    {
+       return SVTL_weldVertices2D((const SVTL_VertexInfoReadOnly*)vi, tolerance, compareAttributes, verticesOut, vertexCountOut, indicesOut, indexCountOut);
+    }
+
+    typedef SVTL_Indexer Indexer;
+
+    /*
+    /// Creates an indexer with no table. The table is sized by the first conversion or by reserveIndexer.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t createIndexer(Indexer* indexerOut)
+    {
+        return SVTL_createIndexer(indexerOut);
+    }
+
+    /*
+    /// Destroys an indexer and its table. */
+    inline void destroyIndexer(Indexer indexer)
+    {
+        SVTL_destroyIndexer(indexer);
+    }
+
+    /*
+    /// Sizes the table of an indexer for meshes of up to vertexCount vertices of the given stride.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t reserveIndexer(Indexer indexer, uint32_t stride, uint32_t vertexCount)
+    {
+        return SVTL_reserveIndexer(indexer, stride, vertexCount);
+    }
+
+    /*
+    /// Converts a list of unindexed vertices to indexed vertices through the table of the indexer, which is kept between calls.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t unindexedToIndexed2D(Indexer indexer, const struct VertexInfoReadOnly* vi, void* verticesOut, uint32_t* vertexCountOut, uint32_t* indicesOut, uint32_t* indexCountOut)
+    {
+       return SVTL_indexerUnindexedToIndexed2D(indexer, (const SVTL_VertexInfoReadOnly*)vi, verticesOut, vertexCountOut, indicesOut, indexCountOut);
+    }
+
+    /*
+    /// Starts a stream of vertices, indexed in chunks by indexerPush as they arrive. Any stream in progress is discarded.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t indexerBegin(Indexer indexer, uint32_t stride, uint32_t expectedVertexCount)
+    {
+        return SVTL_indexerBegin(indexer, stride, expectedVertexCount);
+    }
+
+    /*
+    /// Indexes the next chunk of a stream, appending the vertices first seen in it to newVerticesOut.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t indexerPush(Indexer indexer, const struct VertexInfoReadOnly* chunk, void* newVerticesOut, uint32_t* newVertexCountOut, uint32_t* indicesOut)
+    {
+        return SVTL_indexerPush(indexer, (const SVTL_VertexInfoReadOnly*)chunk, newVerticesOut, newVertexCountOut, indicesOut);
+    }
+
+    /*
+    /// Ends a stream, returning its counts of distinct and pushed vertices.
+    /// @return errno_t - error code: 0 on success, -1 if no stream was in progress */
+    inline errno_t indexerEnd(Indexer indexer, uint32_t* vertexCountOut, uint32_t* indexCountOut)
+    {
+        return SVTL_indexerEnd(indexer, vertexCountOut, indexCountOut);
+    }
+
+    /*
+    /// Returns the signed area of a simple closed polygon.
+    /// @param SVTL_VertexInfo* vi - vertex info
+    /// @return double - the signed area of the polygon. */
+    inline double findSignedArea(const struct VertexInfoReadOnly* vi, errno_t* err)
+    {
+        return SVTL_findSignedArea((const SVTL_VertexInfoReadOnly*)vi, err);
+    }
+
+    inline double findSignedArea(Context ctx, const struct VertexInfoReadOnly* vi, errno_t* err)
+    {
+        return SVTL_findSignedAreaCtx(ctx, (const SVTL_VertexInfoReadOnly*)vi, err);
+    }
+
+   /*
+    /// Returns the centroid of a simple closed polygon.
+    /// @param SVTL_VertexInfo* vi - vertex info
+    /// @return SVTL_F64Vec2 - the centroid of the polygon */
+    inline F64Vec2 findCentroid2D(const struct VertexInfoReadOnly* vi, errno_t* err)
+    {
+        const SVTL_F64Vec2 v2 = SVTL_findCentroid2D((const SVTL_VertexInfoReadOnly*)vi, err);
+        return {v2.x, v2.y};
+    }
+
+    inline F64Vec2 findCentroid2D(Context ctx, const struct VertexInfoReadOnly* vi, errno_t* err)
+    {
+        const SVTL_F64Vec2 v2 = SVTL_findCentroid2DCtx(ctx, (const SVTL_VertexInfoReadOnly*)vi, err);
+        return {v2.x, v2.y};
+    }
+    
+    /*
+    /// Extracts the positions of the given vertices and stores them in an array with a size of (vi.count * sizeof(SVTL_F64Vec2))
+    /// @param SVTL_VertexInfo* vi - vertex info
+    /// @param SVTL_F64Vec2* positionsOut - the buffer to store the positions*/
+    inline errno_t extractVertexPositions2D(const struct VertexInfo* vi, F64Vec2* positionsOut)
+    {
+        return SVTL_extractVertexPositions2D((const SVTL_VertexInfoReadOnly*)vi, (SVTL_F64Vec2*)positionsOut);
+    }
+
+    /*
+    /// Extracts the positions of the given vertices and stores them in an array with a size of (vi.count * sizeof(SVTL_F64Vec2))
+    /// Identical to SVTL_ExtractVertexPositions2D, except it checks to ensure that the buffer length is of the correct size.
+    /// @param SVTL_VertexInfo* vi - vertex info
+    /// @param SVTL_F64Vec2* positionsOut - the buffer to store the positions*/
+    inline errno_t extractVertexPositions2D_s(const struct VertexInfo* vi, F64Vec2* positionsOut, uint64_t buffSize)
+    {
+        return SVTL_extractVertexPositions2D_s((const SVTL_VertexInfoReadOnly*)vi, (SVTL_F64Vec2*)positionsOut, buffSize);
+    }
+
+    /*
+    /// Overloads of the operations above for vertices with separate x and y arrays.*/
+    inline errno_t translate2D(const struct VertexInfoSoA* vi, struct F64Vec2 displacement)
+    {
+        return SVTL_translate2DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&displacement);
+    }
+
+    inline errno_t translate2D(Context ctx, const struct VertexInfoSoA* vi, struct F64Vec2 displacement)
+    {
+        return SVTL_translate2DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&displacement);
+    }
+
+    inline errno_t translate2DAsync(const struct VertexInfoSoA* vi, struct F64Vec2 displacement, Fence* fenceOut)
+    {
+        return SVTL_translate2DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&displacement, fenceOut);
+    }
+
+    inline errno_t translate2DAsync(Context ctx, const struct VertexInfoSoA* vi, struct F64Vec2 displacement, Fence* fenceOut)
+    {
+        return SVTL_translate2DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&displacement, fenceOut);
+    }
+
+    inline errno_t rotate2D(const struct VertexInfoSoA* vi, double radians, struct F64Vec2 origin)
+    {
+        return SVTL_rotate2DSoA((const SVTL_VertexInfoSoA*)vi, radians, *(SVTL_F64Vec2*)&origin);
+    }
+
+    inline errno_t rotate2D(Context ctx, const struct VertexInfoSoA* vi, double radians, struct F64Vec2 origin)
+    {
+        return SVTL_rotate2DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, radians, *(SVTL_F64Vec2*)&origin);
+    }
+
+    inline errno_t rotate2DAsync(const struct VertexInfoSoA* vi, double radians, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate2DSoAAsync((const SVTL_VertexInfoSoA*)vi, radians, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
+    inline errno_t rotate2DAsync(Context ctx, const struct VertexInfoSoA* vi, double radians, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate2DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, radians, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
+    inline errno_t scale2D(const struct VertexInfoSoA* vi, struct F64Vec2 scaleFactor, struct F64Vec2 origin)
+    {
+        return SVTL_scale2DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin);
+    }
+
+    inline errno_t scale2D(Context ctx, const struct VertexInfoSoA* vi, struct F64Vec2 scaleFactor, struct F64Vec2 origin)
+    {
+        return SVTL_scale2DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin);
+    }
+
+    inline errno_t scale2DAsync(const struct VertexInfoSoA* vi, struct F64Vec2 scaleFactor, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_scale2DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
+    inline errno_t scale2DAsync(Context ctx, const struct VertexInfoSoA* vi, struct F64Vec2 scaleFactor, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_scale2DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&scaleFactor, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
+    inline errno_t skew2D(const struct VertexInfoSoA* vi, struct F64Vec2 skewFactor, struct F64Vec2 origin)
+    {
+        return SVTL_skew2DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin);
+    }
+
+    inline errno_t skew2D(Context ctx, const struct VertexInfoSoA* vi, struct F64Vec2 skewFactor, struct F64Vec2 origin)
+    {
+        return SVTL_skew2DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin);
+    }
+
+    inline errno_t skew2DAsync(const struct VertexInfoSoA* vi, struct F64Vec2 skewFactor, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_skew2DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
+    inline errno_t skew2DAsync(Context ctx, const struct VertexInfoSoA* vi, struct F64Vec2 skewFactor, struct F64Vec2 origin, Fence* fenceOut)
+    {
+        return SVTL_skew2DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec2*)&skewFactor, *(SVTL_F64Vec2*)&origin, fenceOut);
+    }
+
+    inline errno_t mirror2D(const struct VertexInfoSoA* vi, struct F64Line2 mirrorLine)
+    {
+        return SVTL_mirror2DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Line2*)&mirrorLine);
+    }
+
+    inline errno_t mirror2D(Context ctx, const struct VertexInfoSoA* vi, struct F64Line2 mirrorLine)
+    {
+        return SVTL_mirror2DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Line2*)&mirrorLine);
+    }
+
+    inline errno_t mirror2DAsync(const struct VertexInfoSoA* vi, struct F64Line2 mirrorLine, Fence* fenceOut)
+    {
+        return SVTL_mirror2DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Line2*)&mirrorLine, fenceOut);
+    }
+
+    inline errno_t mirror2DAsync(Context ctx, const struct VertexInfoSoA* vi, struct F64Line2 mirrorLine, Fence* fenceOut)
+    {
+        return SVTL_mirror2DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Line2*)&mirrorLine, fenceOut);
+    }
+
+    inline errno_t applyAffine2D(const struct VertexInfoSoA* vi, F64Mat2x3 transform)
+    {
+        return SVTL_applyAffine2DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat2x3*)&transform);
+    }
+
+    inline errno_t applyAffine2D(Context ctx, const struct VertexInfoSoA* vi, F64Mat2x3 transform)
+    {
+        return SVTL_applyAffine2DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat2x3*)&transform);
+    }
+
+    inline errno_t applyAffine2DAsync(const struct VertexInfoSoA* vi, F64Mat2x3 transform, Fence* fenceOut)
+    {
+        return SVTL_applyAffine2DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat2x3*)&transform, fenceOut);
+    }
+
+    inline errno_t applyAffine2DAsync(Context ctx, const struct VertexInfoSoA* vi, F64Mat2x3 transform, Fence* fenceOut)
+    {
+        return SVTL_applyAffine2DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat2x3*)&transform, fenceOut);
+    }
+
+    /*
+    /// Returns the identity 3x3 matrix. */
+    inline F64Mat3x3 mat3x3Identity(void)
+    {
+        const SVTL_F64Mat3x3 m = SVTL_mat3x3Identity();
+        return *(const F64Mat3x3*)&m;
+    }
+
+    /*
+    /// Composes two projective matrices. Applying the result is equivalent to applying rhs, then lhs.
+    /// @return F64Mat3x3 - lhs * rhs */
+    inline F64Mat3x3 mat3x3Multiply(F64Mat3x3 lhs, F64Mat3x3 rhs)
+    {
+        const SVTL_F64Mat3x3 m = SVTL_mat3x3Multiply(*(SVTL_F64Mat3x3*)&lhs, *(SVTL_F64Mat3x3*)&rhs);
+        return *(const F64Mat3x3*)&m;
+    }
+
+    /*
+    /// Returns the projective matrix of an affine transform. */
+    inline F64Mat3x3 mat3x3FromAffine(F64Mat2x3 transform)
+    {
+        const SVTL_F64Mat3x3 m = SVTL_mat3x3FromAffine(*(SVTL_F64Mat2x3*)&transform);
+        return *(const F64Mat3x3*)&m;
+    }
+
+    /*
+    /// Applies a projective transform (homography) to the positions of the given vertices in a single pass.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t applyHomography2D(const struct VertexInfo* vi, F64Mat3x3 transform)
+    {
+        return SVTL_applyHomography2D((const SVTL_VertexInfo*)vi, *(SVTL_F64Mat3x3*)&transform);
+    }
+
+    inline errno_t applyHomography2D(Context ctx, const struct VertexInfo* vi, F64Mat3x3 transform)
+    {
+        return SVTL_applyHomography2DCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Mat3x3*)&transform);
+    }
+
+    inline errno_t applyHomography2DAsync(const struct VertexInfo* vi, F64Mat3x3 transform, Fence* fenceOut)
+    {
+        return SVTL_applyHomography2DAsync((const SVTL_VertexInfo*)vi, *(SVTL_F64Mat3x3*)&transform, fenceOut);
+    }
+
+    inline errno_t applyHomography2DAsync(Context ctx, const struct VertexInfo* vi, F64Mat3x3 transform, Fence* fenceOut)
+    {
+        return SVTL_applyHomography2DAsyncCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Mat3x3*)&transform, fenceOut);
+    }
+
+    inline errno_t applyHomography2D(const struct VertexInfoSoA* vi, F64Mat3x3 transform)
+    {
+        return SVTL_applyHomography2DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat3x3*)&transform);
+    }
+
+    inline errno_t applyHomography2D(Context ctx, const struct VertexInfoSoA* vi, F64Mat3x3 transform)
+    {
+        return SVTL_applyHomography2DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat3x3*)&transform);
+    }
+
+    inline errno_t applyHomography2DAsync(const struct VertexInfoSoA* vi, F64Mat3x3 transform, Fence* fenceOut)
+    {
+        return SVTL_applyHomography2DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat3x3*)&transform, fenceOut);
+    }
+
+    inline errno_t applyHomography2DAsync(Context ctx, const struct VertexInfoSoA* vi, F64Mat3x3 transform, Fence* fenceOut)
+    {
+        return SVTL_applyHomography2DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat3x3*)&transform, fenceOut);
+    }
+
+    /*
+    /// Returns the identity 4x4 matrix. */
+    inline F64Mat4x4 mat4x4Identity(void)
+    {
+        const SVTL_F64Mat4x4 m = SVTL_mat4x4Identity();
+        return *(const F64Mat4x4*)&m;
+    }
+
+    /*
+    /// Composes two 4x4 matrices. Applying the result is equivalent to applying rhs, then lhs.
+    /// @return F64Mat4x4 - lhs * rhs */
+    inline F64Mat4x4 mat4x4Multiply(F64Mat4x4 lhs, F64Mat4x4 rhs)
+    {
+        const SVTL_F64Mat4x4 m = SVTL_mat4x4Multiply(*(SVTL_F64Mat4x4*)&lhs, *(SVTL_F64Mat4x4*)&rhs);
+        return *(const F64Mat4x4*)&m;
+    }
+
+    /*
+    /// Returns a matrix that translates by displacement units. */
+    inline F64Mat4x4 mat4x4Translate(F64Vec3 displacement)
+    {
+        const SVTL_F64Mat4x4 m = SVTL_mat4x4Translate(*(SVTL_F64Vec3*)&displacement);
+        return *(const F64Mat4x4*)&m;
+    }
+
+    /*
+    /// Returns a matrix that rotates by radians around an axis through the origin. */
+    inline F64Mat4x4 mat4x4Rotate(F64Vec3 axis, double radians, F64Vec3 origin)
+    {
+        const SVTL_F64Mat4x4 m = SVTL_mat4x4Rotate(*(SVTL_F64Vec3*)&axis, radians, *(SVTL_F64Vec3*)&origin);
+        return *(const F64Mat4x4*)&m;
+    }
+
+    /*
+    /// Returns a matrix that rotates by a quaternion around the origin. */
+    inline F64Mat4x4 mat4x4Rotate(F64Quat rotation, F64Vec3 origin)
+    {
+        const SVTL_F64Mat4x4 m = SVTL_mat4x4RotateQuat(*(SVTL_F64Quat*)&rotation, *(SVTL_F64Vec3*)&origin);
+        return *(const F64Mat4x4*)&m;
+    }
+
+    /*
+    /// Returns a matrix that dilates around the origin by the scaleFactor. */
+    inline F64Mat4x4 mat4x4Scale(F64Vec3 scaleFactor, F64Vec3 origin)
+    {
+        const SVTL_F64Mat4x4 m = SVTL_mat4x4Scale(*(SVTL_F64Vec3*)&scaleFactor, *(SVTL_F64Vec3*)&origin);
+        return *(const F64Mat4x4*)&m;
+    }
+
+    /*
+    /// Applies an affine 4x4 transform to the 3D positions of the given vertices in a single pass.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t applyAffine3D(const struct VertexInfo* vi, F64Mat4x4 transform)
+    {
+        return SVTL_applyAffine3D((const SVTL_VertexInfo*)vi, *(SVTL_F64Mat4x4*)&transform);
+    }
+
+    inline errno_t applyAffine3D(Context ctx, const struct VertexInfo* vi, F64Mat4x4 transform)
+    {
+        return SVTL_applyAffine3DCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Mat4x4*)&transform);
+    }
+
+    inline errno_t applyAffine3DAsync(const struct VertexInfo* vi, F64Mat4x4 transform, Fence* fenceOut)
+    {
+        return SVTL_applyAffine3DAsync((const SVTL_VertexInfo*)vi, *(SVTL_F64Mat4x4*)&transform, fenceOut);
+    }
+
+    inline errno_t applyAffine3DAsync(Context ctx, const struct VertexInfo* vi, F64Mat4x4 transform, Fence* fenceOut)
+    {
+        return SVTL_applyAffine3DAsyncCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Mat4x4*)&transform, fenceOut);
+    }
+
+    inline errno_t applyAffine3D(const struct VertexInfoSoA* vi, F64Mat4x4 transform)
+    {
+        return SVTL_applyAffine3DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat4x4*)&transform);
+    }
+
+    inline errno_t applyAffine3D(Context ctx, const struct VertexInfoSoA* vi, F64Mat4x4 transform)
+    {
+        return SVTL_applyAffine3DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat4x4*)&transform);
+    }
+
+    inline errno_t applyAffine3DAsync(const struct VertexInfoSoA* vi, F64Mat4x4 transform, Fence* fenceOut)
+    {
+        return SVTL_applyAffine3DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat4x4*)&transform, fenceOut);
+    }
+
+    inline errno_t applyAffine3DAsync(Context ctx, const struct VertexInfoSoA* vi, F64Mat4x4 transform, Fence* fenceOut)
+    {
+        return SVTL_applyAffine3DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Mat4x4*)&transform, fenceOut);
+    }
+
+    /*
+    /// Translates the 3D positions of the given vertices by displacement units.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t translate3D(const struct VertexInfo* vi, F64Vec3 displacement)
+    {
+        return SVTL_translate3D((const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&displacement);
+    }
+
+    inline errno_t translate3D(Context ctx, const struct VertexInfo* vi, F64Vec3 displacement)
+    {
+        return SVTL_translate3DCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&displacement);
+    }
+
+    inline errno_t translate3DAsync(const struct VertexInfo* vi, F64Vec3 displacement, Fence* fenceOut)
+    {
+        return SVTL_translate3DAsync((const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&displacement, fenceOut);
+    }
+
+    inline errno_t translate3DAsync(Context ctx, const struct VertexInfo* vi, F64Vec3 displacement, Fence* fenceOut)
+    {
+        return SVTL_translate3DAsyncCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&displacement, fenceOut);
+    }
+
+    inline errno_t translate3D(const struct VertexInfoSoA* vi, F64Vec3 displacement)
+    {
+        return SVTL_translate3DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&displacement);
+    }
+
+    inline errno_t translate3D(Context ctx, const struct VertexInfoSoA* vi, F64Vec3 displacement)
+    {
+        return SVTL_translate3DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&displacement);
+    }
+
+    inline errno_t translate3DAsync(const struct VertexInfoSoA* vi, F64Vec3 displacement, Fence* fenceOut)
+    {
+        return SVTL_translate3DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&displacement, fenceOut);
+    }
+
+    inline errno_t translate3DAsync(Context ctx, const struct VertexInfoSoA* vi, F64Vec3 displacement, Fence* fenceOut)
+    {
+        return SVTL_translate3DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&displacement, fenceOut);
+    }
+
+    /*
+    /// Rotates the 3D positions of the given vertices by radians around an axis.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t rotate3D(const struct VertexInfo* vi, F64Vec3 axis, double radians, F64Vec3 origin)
+    {
+        return SVTL_rotate3D((const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&axis, radians, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t rotate3D(Context ctx, const struct VertexInfo* vi, F64Vec3 axis, double radians, F64Vec3 origin)
+    {
+        return SVTL_rotate3DCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&axis, radians, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t rotate3DAsync(const struct VertexInfo* vi, F64Vec3 axis, double radians, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate3DAsync((const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&axis, radians, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t rotate3DAsync(Context ctx, const struct VertexInfo* vi, F64Vec3 axis, double radians, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate3DAsyncCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&axis, radians, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t rotate3D(const struct VertexInfoSoA* vi, F64Vec3 axis, double radians, F64Vec3 origin)
+    {
+        return SVTL_rotate3DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&axis, radians, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t rotate3D(Context ctx, const struct VertexInfoSoA* vi, F64Vec3 axis, double radians, F64Vec3 origin)
+    {
+        return SVTL_rotate3DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&axis, radians, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t rotate3DAsync(const struct VertexInfoSoA* vi, F64Vec3 axis, double radians, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate3DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&axis, radians, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t rotate3DAsync(Context ctx, const struct VertexInfoSoA* vi, F64Vec3 axis, double radians, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate3DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&axis, radians, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    /*
+    /// Rotates the 3D positions of the given vertices by a quaternion.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t rotate3D(const struct VertexInfo* vi, F64Quat rotation, F64Vec3 origin)
+    {
+        return SVTL_rotate3DQuat((const SVTL_VertexInfo*)vi, *(SVTL_F64Quat*)&rotation, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t rotate3D(Context ctx, const struct VertexInfo* vi, F64Quat rotation, F64Vec3 origin)
+    {
+        return SVTL_rotate3DQuatCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Quat*)&rotation, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t rotate3DAsync(const struct VertexInfo* vi, F64Quat rotation, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate3DQuatAsync((const SVTL_VertexInfo*)vi, *(SVTL_F64Quat*)&rotation, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t rotate3DAsync(Context ctx, const struct VertexInfo* vi, F64Quat rotation, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate3DQuatAsyncCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Quat*)&rotation, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t rotate3D(const struct VertexInfoSoA* vi, F64Quat rotation, F64Vec3 origin)
+    {
+        return SVTL_rotate3DQuatSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Quat*)&rotation, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t rotate3D(Context ctx, const struct VertexInfoSoA* vi, F64Quat rotation, F64Vec3 origin)
+    {
+        return SVTL_rotate3DQuatSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Quat*)&rotation, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t rotate3DAsync(const struct VertexInfoSoA* vi, F64Quat rotation, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate3DQuatSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Quat*)&rotation, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t rotate3DAsync(Context ctx, const struct VertexInfoSoA* vi, F64Quat rotation, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_rotate3DQuatSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Quat*)&rotation, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    /*
+    /// Dilates the 3D positions of the given vertices around the origin by the scaleFactor.
+    /// @return errno_t - error code: 0 on success, -1 upon failure */
+    inline errno_t scale3D(const struct VertexInfo* vi, F64Vec3 scaleFactor, F64Vec3 origin)
+    {
+        return SVTL_scale3D((const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&scaleFactor, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t scale3D(Context ctx, const struct VertexInfo* vi, F64Vec3 scaleFactor, F64Vec3 origin)
+    {
+        return SVTL_scale3DCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&scaleFactor, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t scale3DAsync(const struct VertexInfo* vi, F64Vec3 scaleFactor, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_scale3DAsync((const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&scaleFactor, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t scale3DAsync(Context ctx, const struct VertexInfo* vi, F64Vec3 scaleFactor, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_scale3DAsyncCtx(ctx, (const SVTL_VertexInfo*)vi, *(SVTL_F64Vec3*)&scaleFactor, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t scale3D(const struct VertexInfoSoA* vi, F64Vec3 scaleFactor, F64Vec3 origin)
+    {
+        return SVTL_scale3DSoA((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&scaleFactor, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t scale3D(Context ctx, const struct VertexInfoSoA* vi, F64Vec3 scaleFactor, F64Vec3 origin)
+    {
+        return SVTL_scale3DSoACtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&scaleFactor, *(SVTL_F64Vec3*)&origin);
+    }
+
+    inline errno_t scale3DAsync(const struct VertexInfoSoA* vi, F64Vec3 scaleFactor, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_scale3DSoAAsync((const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&scaleFactor, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t scale3DAsync(Context ctx, const struct VertexInfoSoA* vi, F64Vec3 scaleFactor, F64Vec3 origin, Fence* fenceOut)
+    {
+        return SVTL_scale3DSoAAsyncCtx(ctx, (const SVTL_VertexInfoSoA*)vi, *(SVTL_F64Vec3*)&scaleFactor, *(SVTL_F64Vec3*)&origin, fenceOut);
+    }
+
+    inline errno_t submitCommandBuffer(CommandBuffer cmd, const struct VertexInfoSoA* vi)
+    {
+        return SVTL_submitCommandBufferSoA(cmd, (const SVTL_VertexInfoSoA*)vi);
+    }
+
+    inline errno_t submitCommandBuffer(Context ctx, CommandBuffer cmd, const struct VertexInfoSoA* vi)
+    {
+        return SVTL_submitCommandBufferSoACtx(ctx, cmd, (const SVTL_VertexInfoSoA*)vi);
+    }
+
+    inline errno_t submitCommandBufferAsync(CommandBuffer cmd, const struct VertexInfoSoA* vi, Fence* fenceOut)
+    {
+        return SVTL_submitCommandBufferSoAAsync(cmd, (const SVTL_VertexInfoSoA*)vi, fenceOut);
+    }
+
+    inline errno_t submitCommandBufferAsync(Context ctx, CommandBuffer cmd, const struct VertexInfoSoA* vi, Fence* fenceOut)
+    {
+        return SVTL_submitCommandBufferSoAAsyncCtx(ctx, cmd, (const SVTL_VertexInfoSoA*)vi, fenceOut);
+    }
+
+    inline double findSignedArea(const struct VertexInfoSoAReadOnly* vi, errno_t* err)
+    {
+        return SVTL_findSignedAreaSoA((const SVTL_VertexInfoSoAReadOnly*)vi, err);
+    }
+
+    inline double findSignedArea(Context ctx, const struct VertexInfoSoAReadOnly* vi, errno_t* err)
+    {
+        return SVTL_findSignedAreaSoACtx(ctx, (const SVTL_VertexInfoSoAReadOnly*)vi, err);
+    }
+
+    inline F64Vec2 findCentroid2D(const struct VertexInfoSoAReadOnly* vi, errno_t* err)
+    {
+        const SVTL_F64Vec2 v2 = SVTL_findCentroid2DSoA((const SVTL_VertexInfoSoAReadOnly*)vi, err);
+        return {v2.x, v2.y};
+    }
+
+    inline F64Vec2 findCentroid2D(Context ctx, const struct VertexInfoSoAReadOnly* vi, errno_t* err)
+    {
+        const SVTL_F64Vec2 v2 = SVTL_findCentroid2DSoACtx(ctx, (const SVTL_VertexInfoSoAReadOnly*)vi, err);
+        return {v2.x, v2.y};
+    }
+
+    inline errno_t extractVertexPositions2D(const struct VertexInfoSoAReadOnly* vi, F64Vec2* positionsOut)
+    {
+        return SVTL_extractVertexPositions2DSoA((const SVTL_VertexInfoSoAReadOnly*)vi, (SVTL_F64Vec2*)positionsOut);
+    }
+
+    inline errno_t extractVertexPositions2D_s(const struct VertexInfoSoAReadOnly* vi, F64Vec2* positionsOut, uint64_t buffSize)
+    {
+        return SVTL_extractVertexPositions2DSoA_s((const SVTL_VertexInfoSoAReadOnly*)vi, (SVTL_F64Vec2*)positionsOut, buffSize);
     }
 }
\ No newline at end of file
@@ -0,0 +1,1572 @@
+/*
+Copyright (C) 2025 Tripp Robins
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this
+software and associated documentation files (the "Software"), to deal in the Software
+without restriction, including without limitation the rights to use, copy, modify, merge,
+publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+Checks each operation against a reference result, computed by a simpler path through the library or by the test itself.
+The test to run is named by the first argument, which is one of the names in the tests table.*/
+
+#include <svtl.h>
+#include "../src/kernels.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define CHECK(cond, name) do { if (!(cond)) { printf("failed: %s (line %d)\n", name, __LINE__); ++failures; } } while (0)
+
+static int failures = 0;
+static uint32_t randomState = 12345u;
+
+static uint32_t nextRandom(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+static double randomUnit(void)
+{
+    return (nextRandom() & 0xFFFFFFu) / (double)0x1000000;
+}
+
+/*count random 2D positions*/
+static void fillPositions(double* positions, uint32_t count)
+{
+    uint32_t i;
+    for (i = 0; i < 2 * count; ++i)
+        positions[i] = randomUnit() * 200.0 - 100.0;
+}
+
+/*count vertices of the given stride, each a copy of one of distinctCount random vertices*/
+static unsigned char* makeRepeatedVertices(uint32_t stride, uint32_t count, uint32_t distinctCount)
+{
+    unsigned char* pool = malloc((size_t)stride * distinctCount);
+    unsigned char* vertices = malloc((size_t)stride * count);
+    size_t i;
+    for (i = 0; i < (size_t)stride * distinctCount; ++i)
+        pool[i] = (unsigned char)nextRandom();
+    for (i = 0; i < count; ++i)
+        memcpy(vertices + stride * i, pool + (size_t)stride * (nextRandom() % distinctCount), stride);
+    free(pool);
+    return vertices;
+}
+
+static struct SVTL_VertexInfoReadOnly bytesInfo(const void* vertices, uint32_t stride, uint32_t count)
+{
+    struct SVTL_VertexInfoReadOnly vi;
+    memset(&vi, 0, sizeof(vi));
+    vi.vertices = vertices;
+    vi.stride = stride;
+    vi.count = count;
+    return vi;
+}
+
+/*relative error allowed between the areas and centroids of two SIMD levels, which sum the shoelace terms in different orders*/
+#define SHOELACE_TOLERANCE 1e-10
+
+/*fills the buffers with the same values for every level, runs each transform kernel on them, and returns them as one block*/
+#define SIMD_TRANSFORM_BYTES(n) ((size_t)(n) * (20 + 16 + 8 + 16 + 12))
+static void runTransforms(unsigned char* out, uint32_t n)
+{
+    const struct SVTL_F64Vec2 rotateOrigin = { 1.0, 2.0 }, skewFactor = { 0.3, -0.2 }, skewOrigin = { 0.0, 1.0 };
+    const struct SVTL_F64Mat2x3 affine = SVTL_mat2x3Multiply(SVTL_mat2x3Rotate(0.7, rotateOrigin), SVTL_mat2x3Skew(skewFactor, skewOrigin));
+    struct SVTL_F64Mat3x3 homography = SVTL_mat3x3Identity();
+    struct SVTL_F64Mat4x4 affine3D = SVTL_mat4x4Identity();
+    unsigned char* interleaved = out;
+    double* packed = (double*)(interleaved + (size_t)20 * n);
+    float* soaX = (float*)(packed + (size_t)2 * n);
+    float* soaY = soaX + n;
+    double* projected = (double*)(soaY + n);
+    float* positions3D = (float*)(projected + (size_t)2 * n);
+    struct SVTL_VertexInfo vi;
+    struct SVTL_VertexInfoSoA soa;
+    size_t i;
+
+    randomState = 777u;
+    for (i = 0; i < SIMD_TRANSFORM_BYTES(n) / sizeof(float); ++i)
+        ((float*)out)[i] = (float)(randomUnit() * 200.0 - 100.0);
+    for (i = 0; i < (size_t)2 * n; ++i) {
+        packed[i] = randomUnit() * 200.0 - 100.0;
+        projected[i] = randomUnit() * 200.0 - 100.0;
+    }
+    homography.m[0][1] = 0.25;
+    homography.m[1][2] = -3.0;
+    homography.m[2][0] = 0.001;
+    homography.m[2][1] = -0.002;
+    homography.m[2][2] = 1.5;
+    affine3D.m[0][1] = 0.5;
+    affine3D.m[1][2] = -0.75;
+    affine3D.m[2][0] = 1.25;
+    affine3D.m[0][3] = 4.0;
+
+    memset(&vi, 0, sizeof(vi));
+    vi.count = n;
+    vi.vertices = interleaved;
+    vi.stride = 20;
+    vi.positionOffset = 4;
+    vi.positionType = SVTL_POS_TYPE_VEC2_F32;
+    CHECK(!SVTL_applyAffine2D(&vi, affine), "affine F32");
+    vi.vertices = packed;
+    vi.stride = 16;
+    vi.positionOffset = 0;
+    vi.positionType = SVTL_POS_TYPE_VEC2_F64;
+    CHECK(!SVTL_applyAffine2D(&vi, affine), "affine F64");
+    vi.vertices = projected;
+    CHECK(!SVTL_applyHomography2D(&vi, homography), "homography F64");
+    vi.vertices = positions3D;
+    vi.stride = 12;
+    vi.positionType = SVTL_POS_TYPE_VEC3_F32;
+    CHECK(!SVTL_applyAffine3D(&vi, affine3D), "affine 3D F32");
+
+    memset(&soa, 0, sizeof(soa));
+    soa.count = n;
+    soa.x = soaX;
+    soa.y = soaY;
+    soa.positionType = SVTL_POS_TYPE_VEC2_F32;
+    CHECK(!SVTL_applyAffine2DSoA(&soa, affine), "affine SoA F32");
+}
+
+/*a star around (3, -2), so the shoelace sums do not cancel*/
+static void makeStar(double* positions, uint32_t n)
+{
+    uint32_t i;
+    for (i = 0; i < n; ++i) {
+        const double t = 6.283185307179586 * i / n, r = 1.0 + 0.3 * sin(5.0 * t);
+        positions[2 * i] = 3.0 + r * cos(t);
+        positions[2 * i + 1] = -2.0 + r * sin(t);
+    }
+}
+
+static int withinTolerance(double a, double b)
+{
+    return fabs(a - b) <= SHOELACE_TOLERANCE * fabs(b);
+}
+
+/*error allowed between a composed matrix and the same transforms applied one at a time, relative to the magnitude of the positions*/
+#define COMPOSE_TOLERANCE 1e-12
+
+static int positionsClose(const double* a, const double* b, uint32_t count, double magnitude)
+{
+    uint32_t i;
+    for (i = 0; i < 2 * count; ++i)
+        if (!(fabs(a[i] - b[i]) <= COMPOSE_TOLERANCE * magnitude))
+            return 0;
+    return 1;
+}
+
+/*translate, rotate, scale and mirror recorded in a command buffer give the result of the same calls made one at a time,
+through the in-place, out-of-place and Async submits*/
+static void testCommandBuffer(void)
+{
+    static const uint32_t counts[] = { 5, 40001 };
+    const struct SVTL_F64Vec2 displacement = { 3.0, -7.0 }, origin = { 1.0, 2.0 }, scaleFactor = { 1.5, -0.5 };
+    struct SVTL_F64Line2 mirrorLine;
+    SVTL_Context ctx;
+    SVTL_CommandBuffer cmd;
+    uint32_t c;
+
+    mirrorLine.dir = 0.4;
+    mirrorLine.center = origin;
+    if (SVTL_createContext(&ctx) || SVTL_createCommandBuffer(&cmd)) {
+        CHECK(0, "create context and command buffer");
+        return;
+    }
+    SVTL_setWorkerCountCtx(ctx, 4);
+    SVTL_setParallelThresholdCtx(ctx, 1000);
+
+    for (c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+    {
+        const uint32_t n = counts[c];
+        double* original = malloc(sizeof(double) * 2 * n);
+        double* expected = malloc(sizeof(double) * 2 * n);
+        double* positions = malloc(sizeof(double) * 2 * n);
+        struct SVTL_VertexInfo vi;
+        SVTL_Fence fence;
+
+        fillPositions(original, n);
+        memset(&vi, 0, sizeof(vi));
+        vi.count = n;
+        vi.stride = 16;
+        vi.positionType = SVTL_POS_TYPE_VEC2_F64;
+
+        memcpy(expected, original, sizeof(double) * 2 * n);
+        vi.vertices = expected;
+        CHECK(!SVTL_translate2DCtx(ctx, &vi, displacement), "translate");
+        CHECK(!SVTL_rotate2DCtx(ctx, &vi, 0.9, origin), "rotate");
+        CHECK(!SVTL_scale2DCtx(ctx, &vi, scaleFactor, origin), "scale");
+        CHECK(!SVTL_mirror2DCtx(ctx, &vi, mirrorLine), "mirror");
+
+        SVTL_resetCommandBuffer(cmd);
+        CHECK(!SVTL_cmdTranslate2D(cmd, displacement), "record translate");
+        CHECK(!SVTL_cmdRotate2D(cmd, 0.9, origin), "record rotate");
+        CHECK(!SVTL_cmdScale2D(cmd, scaleFactor, origin), "record scale");
+        CHECK(!SVTL_cmdMirror2D(cmd, mirrorLine), "record mirror");
+
+        memcpy(positions, original, sizeof(double) * 2 * n);
+        vi.vertices = positions;
+        CHECK(!SVTL_submitCommandBufferCtx(ctx, cmd, &vi), "submit");
+        CHECK(positionsClose(positions, expected, n, 200.0), "submit matches one at a time");
+
+        memset(positions, 0, sizeof(double) * 2 * n);
+        vi.vertices = original;
+        {
+            struct SVTL_VertexInfo dst = vi;
+            dst.vertices = positions;
+            CHECK(!SVTL_submitCommandBufferToCtx(ctx, cmd, (const struct SVTL_VertexInfoReadOnly*)&vi, &dst, false), "submit to");
+        }
+        CHECK(positionsClose(positions, expected, n, 200.0), "submit to matches one at a time");
+
+        memcpy(positions, original, sizeof(double) * 2 * n);
+        vi.vertices = positions;
+        CHECK(!SVTL_submitCommandBufferAsyncCtx(ctx, cmd, &vi, &fence), "submit async");
+        /*the buffer may be changed once the submit returns*/
+        SVTL_resetCommandBuffer(cmd);
+        CHECK(!SVTL_cmdTranslate2D(cmd, displacement), "record after submit async");
+        CHECK(!SVTL_waitFence(fence), "wait submit async");
+        CHECK(positionsClose(positions, expected, n, 200.0), "submit async matches one at a time");
+
+        /*an empty buffer leaves the vertices as they are, and still gives a fence*/
+        SVTL_resetCommandBuffer(cmd);
+        memcpy(positions, original, sizeof(double) * 2 * n);
+        CHECK(!SVTL_submitCommandBufferAsyncCtx(ctx, cmd, &vi, &fence), "submit empty async");
+        CHECK(!SVTL_waitFence(fence), "wait submit empty async");
+        CHECK(!memcmp(positions, original, sizeof(double) * 2 * n), "empty submit async");
+        memset(positions, 0, sizeof(double) * 2 * n);
+        vi.vertices = original;
+        {
+            struct SVTL_VertexInfo dst = vi;
+            dst.vertices = positions;
+            CHECK(!SVTL_submitCommandBufferToCtx(ctx, cmd, (const struct SVTL_VertexInfoReadOnly*)&vi, &dst, false), "submit empty to");
+        }
+        CHECK(!memcmp(positions, original, sizeof(double) * 2 * n), "empty submit to copies");
+
+        free(original);
+        free(expected);
+        free(positions);
+    }
+    SVTL_destroyCommandBuffer(cmd);
+    SVTL_destroyContext(ctx);
+}
+
+/*several fences in flight on one context, a fence polled until it signals, and fences of operations small enough to run inline,
+each giving the result of the synchronous call*/
+static void testFences(void)
+{
+    enum { IN_FLIGHT = 4 };
+    static const uint32_t counts[] = { 100, 50001 };
+    const struct SVTL_F64Vec2 origin = { 1.0, -2.0 }, scaleFactor = { 1.5, 0.25 };
+    SVTL_Context ctx;
+    uint32_t c, f;
+
+    if (SVTL_createContext(&ctx)) {
+        CHECK(0, "create context");
+        return;
+    }
+    SVTL_setWorkerCountCtx(ctx, 4);
+    /*the smaller count runs inline, under the threshold*/
+    SVTL_setParallelThresholdCtx(ctx, 1000);
+
+    for (c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+    {
+        const uint32_t n = counts[c];
+        double* asyncPositions[IN_FLIGHT];
+        double* syncPositions[IN_FLIGHT];
+        struct SVTL_VertexInfo asyncInfo[IN_FLIGHT], syncInfo;
+        SVTL_Fence fences[IN_FLIGHT];
+        uint32_t polls;
+
+        memset(&syncInfo, 0, sizeof(syncInfo));
+        syncInfo.count = n;
+        syncInfo.stride = 16;
+        syncInfo.positionType = SVTL_POS_TYPE_VEC2_F64;
+        for (f = 0; f < IN_FLIGHT; ++f) {
+            asyncPositions[f] = malloc(sizeof(double) * 2 * n);
+            syncPositions[f] = malloc(sizeof(double) * 2 * n);
+            fillPositions(asyncPositions[f], n);
+            memcpy(syncPositions[f], asyncPositions[f], sizeof(double) * 2 * n);
+            asyncInfo[f] = syncInfo;
+            asyncInfo[f].vertices = asyncPositions[f];
+        }
+
+        CHECK(!SVTL_translate2DAsyncCtx(ctx, &asyncInfo[0], origin, &fences[0]), "translate async");
+        CHECK(!SVTL_rotate2DAsyncCtx(ctx, &asyncInfo[1], 0.3, origin, &fences[1]), "rotate async");
+        CHECK(!SVTL_scale2DAsyncCtx(ctx, &asyncInfo[2], scaleFactor, origin, &fences[2]), "scale async");
+        CHECK(!SVTL_skew2DAsyncCtx(ctx, &asyncInfo[3], scaleFactor, origin, &fences[3]), "skew async");
+
+        /*the last fence is polled until it signals before every fence is waited on*/
+        for (polls = 0; !SVTL_pollFence(fences[IN_FLIGHT - 1]) && polls < 100000000u; ++polls)
+            ;
+        CHECK(SVTL_pollFence(fences[IN_FLIGHT - 1]), "poll fence");
+        for (f = 0; f < IN_FLIGHT; ++f)
+            CHECK(!SVTL_waitFence(fences[f]), "wait fence");
+
+        syncInfo.vertices = syncPositions[0];
+        CHECK(!SVTL_translate2DCtx(ctx, &syncInfo, origin), "translate");
+        syncInfo.vertices = syncPositions[1];
+        CHECK(!SVTL_rotate2DCtx(ctx, &syncInfo, 0.3, origin), "rotate");
+        syncInfo.vertices = syncPositions[2];
+        CHECK(!SVTL_scale2DCtx(ctx, &syncInfo, scaleFactor, origin), "scale");
+        syncInfo.vertices = syncPositions[3];
+        CHECK(!SVTL_skew2DCtx(ctx, &syncInfo, scaleFactor, origin), "skew");
+        for (f = 0; f < IN_FLIGHT; ++f) {
+            CHECK(!memcmp(asyncPositions[f], syncPositions[f], sizeof(double) * 2 * n), "async matches sync");
+            free(asyncPositions[f]);
+            free(syncPositions[f]);
+        }
+    }
+    SVTL_destroyContext(ctx);
+}
+
+/*a job system that holds each launched batch until it is joined, then runs its tasks on the joining thread.
+The handle holds the index of the batch in batchJobs*/
+enum { BATCH_MAX_JOBS = 8, BATCH_MAX_TASKS = 64 };
+static struct { SVTL_Task tasks[BATCH_MAX_TASKS]; uint32_t taskCount; int pending; } batchJobs[BATCH_MAX_JOBS];
+static uint32_t batchLaunchCalls = 0, batchJoinCalls = 0;
+static int batchLaunchFails = 0;
+
+static errno_t countingBatchLaunch(const SVTL_Task* tasks, uint32_t taskCount, SVTL_TaskHandle hdl)
+{
+    uint32_t job = 0;
+    ++batchLaunchCalls;
+    while (job < BATCH_MAX_JOBS && batchJobs[job].pending)
+        ++job;
+    if (batchLaunchFails || job == BATCH_MAX_JOBS || taskCount > BATCH_MAX_TASKS)
+        return -1;
+    memcpy(batchJobs[job].tasks, tasks, sizeof(SVTL_Task) * taskCount);
+    batchJobs[job].taskCount = taskCount;
+    batchJobs[job].pending = 1;
+    memcpy(hdl, &job, sizeof(job));
+    return 0;
+}
+
+static errno_t countingBatchJoin(SVTL_TaskHandle hdl)
+{
+    uint32_t job, i;
+    ++batchJoinCalls;
+    memcpy(&job, hdl, sizeof(job));
+    if (job >= BATCH_MAX_JOBS || !batchJobs[job].pending)
+        return -1;
+    for (i = 0; i < batchJobs[job].taskCount; ++i)
+        batchJobs[job].tasks[i].func(batchJobs[job].tasks[i].args);
+    batchJobs[job].pending = 0;
+    return 0;
+}
+
+/*operations launched through the batch callbacks make one launch and one join each, and give the results of the default thread pool.
+A batch that cannot be launched is run on the calling thread without a join, and clearing the callbacks brings the pool back*/
+static void testBatchCallbacks(void)
+{
+    const uint32_t n = 50001;
+    const struct SVTL_F64Vec2 origin = { 1.0, -2.0 }, scaleFactor = { 1.5, 0.25 };
+    double* positions = malloc(sizeof(double) * 2 * n);
+    double* expected = malloc(sizeof(double) * 2 * n);
+    struct SVTL_VertexInfo vi, expectedInfo;
+    SVTL_Context ctx, poolCtx;
+    SVTL_Fence fence;
+    errno_t err = 0;
+
+    if (SVTL_createContext(&ctx)) {
+        CHECK(0, "create context");
+        return;
+    }
+    if (SVTL_createContext(&poolCtx)) {
+        CHECK(0, "create context");
+        SVTL_destroyContext(ctx);
+        return;
+    }
+    SVTL_setWorkerCountCtx(ctx, 4);
+    SVTL_setParallelThresholdCtx(ctx, 0);
+    SVTL_setWorkerCountCtx(poolCtx, 4);
+    SVTL_setParallelThresholdCtx(poolCtx, 0);
+    SVTL_setTaskHandleSizeCtx(ctx, sizeof(uint32_t));
+    SVTL_setTaskBatchJoinCallbackCtx(ctx, countingBatchJoin);
+    SVTL_setTaskBatchLaunchCallbackCtx(ctx, countingBatchLaunch);
+
+    makeStar(positions, n);
+    memcpy(expected, positions, sizeof(double) * 2 * n);
+    memset(&vi, 0, sizeof(vi));
+    vi.count = n;
+    vi.stride = 16;
+    vi.vertices = positions;
+    vi.positionType = SVTL_POS_TYPE_VEC2_F64;
+    vi.topologyType = SVTL_TOPOLOGY_TYPE_POINT_LIST;
+    expectedInfo = vi;
+    expectedInfo.vertices = expected;
+
+    CHECK(!SVTL_translate2DCtx(ctx, &vi, origin), "batch translate");
+    CHECK(!SVTL_translate2DCtx(poolCtx, &expectedInfo, origin), "pool translate");
+    CHECK(batchLaunchCalls == 1 && batchJoinCalls == 1, "one batch launch and join per operation");
+    CHECK(!memcmp(positions, expected, sizeof(double) * 2 * n), "batch translate matches pool");
+
+    {
+        const double area = SVTL_findSignedAreaCtx(ctx, (const struct SVTL_VertexInfoReadOnly*)&vi, &err);
+        CHECK(!err && area == SVTL_findSignedAreaCtx(poolCtx, (const struct SVTL_VertexInfoReadOnly*)&expectedInfo, &err) && !err, "batch area matches pool");
+        CHECK(batchLaunchCalls == 2 && batchJoinCalls == 2, "one batch launch and join per reduction");
+    }
+
+    /*the batch of an async operation is joined by SVTL_waitFence*/
+    CHECK(!SVTL_rotate2DAsyncCtx(ctx, &vi, 0.3, origin, &fence), "batch rotate async");
+    CHECK(batchLaunchCalls == 3 && batchJoinCalls == 2, "async batch launched and not yet joined");
+    CHECK(!SVTL_waitFence(fence), "batch wait fence");
+    CHECK(batchJoinCalls == 3, "async batch joined by the fence");
+    CHECK(!SVTL_rotate2DCtx(poolCtx, &expectedInfo, 0.3, origin), "pool rotate");
+    CHECK(!memcmp(positions, expected, sizeof(double) * 2 * n), "batch rotate async matches pool");
+
+    batchLaunchFails = 1;
+    CHECK(!SVTL_scale2DCtx(ctx, &vi, scaleFactor, origin), "failed batch scale");
+    CHECK(!SVTL_scale2DCtx(poolCtx, &expectedInfo, scaleFactor, origin), "pool scale");
+    CHECK(batchLaunchCalls == 4 && batchJoinCalls == 3, "failed batch launched once and not joined");
+    CHECK(!memcmp(positions, expected, sizeof(double) * 2 * n), "failed batch runs on the calling thread");
+    batchLaunchFails = 0;
+
+    SVTL_setTaskBatchLaunchCallbackCtx(ctx, NULL);
+    SVTL_setTaskBatchJoinCallbackCtx(ctx, NULL);
+    CHECK(!SVTL_skew2DCtx(ctx, &vi, scaleFactor, origin), "pool skew after batch");
+    CHECK(!SVTL_skew2DCtx(poolCtx, &expectedInfo, scaleFactor, origin), "pool skew");
+    CHECK(batchLaunchCalls == 4 && batchJoinCalls == 3, "cleared batch callbacks are not called");
+    CHECK(!memcmp(positions, expected, sizeof(double) * 2 * n), "pool restored after batch callbacks");
+
+    SVTL_destroyContext(ctx);
+    SVTL_destroyContext(poolCtx);
+    free(positions);
+    free(expected);
+}
+
+/*applies transform out of place from src to dst, and in place to expected, which must hold the same vertices as dst would before the transform*/
+static void checkTransformTo(SVTL_Context ctx, const struct SVTL_VertexInfo* src, const struct SVTL_VertexInfo* dst, const struct SVTL_VertexInfo* expected,
+    struct SVTL_F64Mat2x3 transform, bool copyVertices, const char* name)
+{
+    CHECK(!SVTL_applyAffine2DToCtx(ctx, (const struct SVTL_VertexInfoReadOnly*)src, dst, transform, copyVertices), name);
+    CHECK(!SVTL_applyAffine2DCtx(ctx, expected, transform), name);
+    CHECK(!memcmp(dst->vertices, expected->vertices, (size_t)dst->stride * dst->count), name);
+}
+
+/*out-of-place transforms through the staging blocks, with streaming stores for outputs of 1 MiB or more,
+and without staging for vertices larger than a block, against in-place transforms of a copy*/
+static void testTransformTo(void)
+{
+    const struct SVTL_F64Vec2 origin = { 1.0, 2.0 };
+    const struct SVTL_F64Mat2x3 transform = SVTL_mat2x3Rotate(0.6, origin);
+    const uint32_t largeCount = 100003, hugeStride = 16384 + 64, hugeCount = 70;
+    SVTL_Context ctx;
+    struct SVTL_VertexInfo src, dst, expected;
+    unsigned char *srcBytes, *dstBytes, *expectedBytes;
+    uint32_t i;
+
+    if (SVTL_createContext(&ctx)) {
+        CHECK(0, "create context");
+        return;
+    }
+    SVTL_setWorkerCountCtx(ctx, 4);
+    SVTL_setParallelThresholdCtx(ctx, 0);
+    srcBytes = malloc((size_t)hugeStride * hugeCount + (size_t)24 * largeCount);
+    dstBytes = malloc((size_t)hugeStride * hugeCount + (size_t)24 * largeCount);
+    expectedBytes = malloc((size_t)hugeStride * hugeCount + (size_t)24 * largeCount);
+
+    /*F32 positions interleaved with attributes to packed F64, 1.6 MB of streamed output*/
+    memset(&src, 0, sizeof(src));
+    src.count = largeCount;
+    src.stride = 20;
+    src.positionOffset = 4;
+    src.positionType = SVTL_POS_TYPE_VEC2_F32;
+    src.vertices = srcBytes;
+    dst = src;
+    dst.stride = 16;
+    dst.positionOffset = 0;
+    dst.positionType = SVTL_POS_TYPE_VEC2_F64;
+    dst.vertices = dstBytes;
+    expected = dst;
+    expected.vertices = expectedBytes;
+    for (i = 0; i < largeCount; ++i) {
+        float p[2];
+        /*float arithmetic, as GCC 12 at -O2 can store the double before its rounding to float when both are written here*/
+        p[0] = (float)randomUnit() * 200.0f - 100.0f;
+        p[1] = (float)randomUnit() * 200.0f - 100.0f;
+        memcpy(srcBytes + (size_t)20 * i + 4, p, sizeof(p));
+        ((double*)expectedBytes)[2 * i] = p[0];
+        ((double*)expectedBytes)[2 * i + 1] = p[1];
+    }
+    checkTransformTo(ctx, &src, &dst, &expected, transform, false, "F32 interleaved to F64 packed");
+
+    /*packed F64 to F32 interleaved with attributes, which is written back position by position*/
+    src = dst;
+    src.vertices = expectedBytes;
+    dst.stride = 20;
+    dst.positionOffset = 4;
+    dst.positionType = SVTL_POS_TYPE_VEC2_F32;
+    dst.vertices = dstBytes;
+    memset(dstBytes, 0x5A, (size_t)20 * largeCount);
+    memcpy(srcBytes, dstBytes, (size_t)20 * largeCount);
+    for (i = 0; i < largeCount; ++i) {
+        float p[2];
+        p[0] = (float)((double*)expectedBytes)[2 * i];
+        p[1] = (float)((double*)expectedBytes)[2 * i + 1];
+        memcpy(srcBytes + (size_t)20 * i + 4, p, sizeof(p));
+    }
+    expected = dst;
+    expected.vertices = srcBytes;
+    checkTransformTo(ctx, &src, &dst, &expected, transform, false, "F64 packed to F32 interleaved");
+
+    /*whole vertices copied with their positions, 2.4 MB of streamed output*/
+    memset(&src, 0, sizeof(src));
+    src.count = largeCount;
+    src.stride = 24;
+    src.positionOffset = 8;
+    src.positionType = SVTL_POS_TYPE_VEC2_F64;
+    src.vertices = srcBytes;
+    for (i = 0; i < largeCount; ++i) {
+        double v[3];
+        v[0] = randomUnit();
+        v[1] = randomUnit() * 200.0 - 100.0;
+        v[2] = randomUnit() * 200.0 - 100.0;
+        memcpy(srcBytes + (size_t)24 * i, v, sizeof(v));
+    }
+    memcpy(expectedBytes, srcBytes, (size_t)24 * largeCount);
+    dst = src;
+    dst.vertices = dstBytes;
+    expected = src;
+    expected.vertices = expectedBytes;
+    checkTransformTo(ctx, &src, &dst, &expected, transform, true, "copy vertices");
+
+    /*vertices larger than a staging block are copied and transformed in the destination*/
+    src.count = hugeCount;
+    src.stride = hugeStride;
+    src.positionOffset = hugeStride - 16;
+    for (i = 0; i < hugeStride * hugeCount; ++i)
+        srcBytes[i] = (unsigned char)nextRandom();
+    for (i = 0; i < hugeCount; ++i) {
+        double p[2];
+        p[0] = randomUnit() * 200.0 - 100.0;
+        p[1] = randomUnit() * 200.0 - 100.0;
+        memcpy(srcBytes + (size_t)hugeStride * i + src.positionOffset, p, sizeof(p));
+    }
+    memcpy(expectedBytes, srcBytes, (size_t)hugeStride * hugeCount);
+    dst = src;
+    dst.vertices = dstBytes;
+    expected = src;
+    expected.vertices = expectedBytes;
+    checkTransformTo(ctx, &src, &dst, &expected, transform, true, "vertices larger than a staging block");
+
+    free(srcBytes);
+    free(dstBytes);
+    free(expectedBytes);
+    SVTL_destroyContext(ctx);
+}
+
+/*a batch of meshes of mixed layouts, some empty and many straddling chunk edges, each with its own transform,
+against each mesh transformed alone. Every empty mesh points at one vertex that must be left untouched*/
+static void testBatch(void)
+{
+    static const uint32_t edgeCounts[] = { 1023, 1024, 1025, 2047, 16385 };
+    enum { MESH_COUNT = 200 };
+    struct SVTL_Affine2DBatchItem items[MESH_COUNT];
+    unsigned char* expected[MESH_COUNT];
+    SVTL_Context ctx;
+    uint32_t m, i;
+
+    if (SVTL_createContext(&ctx)) {
+        CHECK(0, "create context");
+        return;
+    }
+    SVTL_setWorkerCountCtx(ctx, 4);
+    SVTL_setParallelThresholdCtx(ctx, 0);
+
+    for (m = 0; m < MESH_COUNT; ++m)
+    {
+        struct SVTL_VertexInfo* vi = &items[m].vi;
+        const struct SVTL_F64Vec2 origin = { randomUnit() * 10.0, randomUnit() * 10.0 };
+        const struct SVTL_F64Vec2 factor = { 0.5 + randomUnit(), 0.5 + randomUnit() };
+        unsigned char* vertices;
+        size_t size;
+
+        memset(vi, 0, sizeof(*vi));
+        vi->count = m % 7 == 0 ? 0 : m % 11 == 0 ? edgeCounts[m / 11 % 5] : nextRandom() % 3000 + 1;
+        if (m % 2) {
+            vi->stride = 12;
+            vi->positionOffset = 4;
+            vi->positionType = SVTL_POS_TYPE_VEC2_F32;
+        } else {
+            vi->stride = 16;
+            vi->positionType = SVTL_POS_TYPE_VEC2_F64;
+        }
+        size = (size_t)vi->stride * (vi->count ? vi->count : 1);
+        vertices = malloc(size);
+        for (i = 0; i < size; ++i)
+            vertices[i] = (unsigned char)nextRandom();
+        /*finite positions, as the random bytes may hold NaNs*/
+        for (i = 0; i < vi->count; ++i) {
+            if (m % 2) {
+                float p[2];
+                p[0] = (float)randomUnit() * 200.0f - 100.0f;
+                p[1] = (float)randomUnit() * 200.0f - 100.0f;
+                memcpy(vertices + (size_t)12 * i + 4, p, sizeof(p));
+            } else {
+                double p[2];
+                p[0] = randomUnit() * 200.0 - 100.0;
+                p[1] = randomUnit() * 200.0 - 100.0;
+                memcpy(vertices + (size_t)16 * i, p, sizeof(p));
+            }
+        }
+        vi->vertices = vertices;
+        items[m].transform = SVTL_mat2x3Multiply(SVTL_mat2x3Rotate(0.01 * m, origin), SVTL_mat2x3Scale(factor, origin));
+
+        expected[m] = malloc(size);
+        memcpy(expected[m], vertices, size);
+    }
+
+    CHECK(!SVTL_applyAffine2DBatchCtx(ctx, items, MESH_COUNT), "batch");
+
+    for (m = 0; m < MESH_COUNT; ++m)
+    {
+        struct SVTL_VertexInfo single = items[m].vi;
+        single.vertices = expected[m];
+        if (single.count)
+            CHECK(!SVTL_applyAffine2D(&single, items[m].transform), "single mesh");
+        CHECK(!memcmp(items[m].vi.vertices, expected[m], (size_t)single.stride * (single.count ? single.count : 1)), "mesh matches its single transform");
+        free(items[m].vi.vertices);
+        free(expected[m]);
+    }
+    SVTL_destroyContext(ctx);
+}
+
+/*the transform kernels give the scalar result bit for bit at every SIMD level, and the shoelace kernels agree within SHOELACE_TOLERANCE*/
+static void testSimd(void)
+{
+    static const uint32_t counts[] = { 1, 3, 17, 1000, 4099, 100001 };
+    const enum SVTL_SimdLevel best = SVTL_getSimdLevel();
+    uint32_t c;
+    int level;
+
+    for (c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+    {
+        const uint32_t n = counts[c];
+        unsigned char* expected = malloc(SIMD_TRANSFORM_BYTES(n));
+        unsigned char* out = malloc(SIMD_TRANSFORM_BYTES(n));
+        double* star = malloc(sizeof(double) * 2 * (n < 3 ? 3 : n));
+        struct SVTL_VertexInfoReadOnly polygon = bytesInfo(star, 16, n < 3 ? 3 : n);
+        double expectedArea;
+        struct SVTL_F64Vec2 expectedCentroid;
+        errno_t err = 0;
+
+        polygon.positionType = SVTL_POS_TYPE_VEC2_F64;
+        makeStar(star, polygon.count);
+
+        Kernels_select(SVTL_SIMD_LEVEL_SCALAR);
+        runTransforms(expected, n);
+        expectedArea = SVTL_findSignedArea(&polygon, &err);
+        expectedCentroid = SVTL_findCentroid2D(&polygon, &err);
+        CHECK(!err, "scalar shoelace");
+
+        for (level = SVTL_SIMD_LEVEL_SCALAR + 1; level <= (int)best; ++level)
+        {
+            double area;
+            struct SVTL_F64Vec2 centroid;
+            Kernels_select((enum SVTL_SimdLevel)level);
+            runTransforms(out, n);
+            CHECK(!memcmp(out, expected, SIMD_TRANSFORM_BYTES(n)), "transforms match scalar");
+            area = SVTL_findSignedArea(&polygon, &err);
+            centroid = SVTL_findCentroid2D(&polygon, &err);
+            CHECK(!err, "shoelace");
+            CHECK(withinTolerance(area, expectedArea), "area matches scalar");
+            CHECK(withinTolerance(centroid.x, expectedCentroid.x) && withinTolerance(centroid.y, expectedCentroid.y), "centroid matches scalar");
+        }
+        Kernels_select(best);
+        free(expected);
+        free(out);
+        free(star);
+    }
+}
+
+/*whether raw is an encoding its type decodes and re-encodes unchanged*/
+static int isCanonical(enum SVTL_PositionType type, const unsigned char* raw)
+{
+    uint16_t h;
+    int16_t i;
+    memcpy(&h, raw, sizeof(h));
+    memcpy(&i, raw, sizeof(i));
+    if (type == SVTL_POS_TYPE_VEC2_F16)
+        return (h & 0x7C00u) != 0x7C00u && h != 0x8000u; /*not NaN or infinity, nor -0, which adding the zero translation makes +0*/
+    if (type == SVTL_POS_TYPE_VEC2_I16_NORM)
+        return i != -32768; /*decodes to -1, as 32767 does*/
+    return 1;
+}
+
+/*more workers than CPUs, so tasks are preempted and steal from each other, over counts that split into uneven chunks.
+Every vertex must be translated exactly once per call, which a chunk run twice or skipped would break,
+and reductions must give the same bits on every call*/
+static void testWorkStealing(void)
+{
+    static const uint32_t counts[] = { 1025, 37777, 100003, 262147 };
+    const struct SVTL_F64Vec2 step = { 1.0, -1.0 };
+    const uint32_t repeats = 50;
+    SVTL_Context ctx;
+    uint32_t c;
+
+    if (SVTL_createContext(&ctx)) {
+        CHECK(0, "create context");
+        return;
+    }
+    SVTL_setWorkerCountCtx(ctx, 2 * SVTL_getWorkerCountCtx(ctx) + 3);
+    SVTL_setParallelThresholdCtx(ctx, 0);
+
+    for (c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+    {
+        const uint32_t n = counts[c];
+        /*three doubles per vertex and an odd first vertex, so chunk edges do not fall on cache lines evenly*/
+        double* buffer = malloc(sizeof(double) * (3 * (size_t)n + 1));
+        double* positions = buffer + 1;
+        struct SVTL_VertexInfo vi;
+        uint32_t i, r;
+        int exact = 1;
+
+        for (i = 0; i < n; ++i) {
+            positions[3 * i] = (double)i;
+            positions[3 * i + 1] = -(double)i;
+            positions[3 * i + 2] = 0.5;
+        }
+        memset(&vi, 0, sizeof(vi));
+        vi.count = n;
+        vi.stride = 24;
+        vi.vertices = positions;
+        vi.positionType = SVTL_POS_TYPE_VEC2_F64;
+        for (r = 0; r < repeats; ++r)
+            CHECK(!SVTL_translate2DCtx(ctx, &vi, step), "translate");
+
+        for (i = 0; i < n; ++i)
+            exact &= positions[3 * i] == (double)i + repeats && positions[3 * i + 1] == -(double)i - repeats && positions[3 * i + 2] == 0.5;
+        CHECK(exact, "every vertex translated once per call");
+
+        /*the star's area and centroid are summed chunk by chunk, and must round the same whichever task ran each chunk*/
+        {
+            const struct SVTL_VertexInfoReadOnly* readOnly = (const struct SVTL_VertexInfoReadOnly*)&vi;
+            struct SVTL_F64Vec2 firstCentroid;
+            double firstArea;
+            errno_t err = 0;
+            int repeatable;
+
+            for (i = 0; i < n; ++i) {
+                const double t = 6.283185307179586 * i / n, radius = 1.0 + 0.3 * sin(5.0 * t);
+                positions[3 * i] = 3.0 + radius * cos(t);
+                positions[3 * i + 1] = -2.0 + radius * sin(t);
+            }
+            vi.topologyType = SVTL_TOPOLOGY_TYPE_POINT_LIST;
+            firstArea = SVTL_findSignedAreaCtx(ctx, readOnly, &err);
+            firstCentroid = SVTL_findCentroid2DCtx(ctx, readOnly, &err);
+            repeatable = !err;
+            for (r = 0; r < repeats; ++r) {
+                const double area = SVTL_findSignedAreaCtx(ctx, readOnly, &err);
+                const struct SVTL_F64Vec2 centroid = SVTL_findCentroid2DCtx(ctx, readOnly, &err);
+                repeatable &= !err && area == firstArea && centroid.x == firstCentroid.x && centroid.y == firstCentroid.y;
+            }
+            CHECK(repeatable, "area and centroid identical on every run");
+        }
+        free(buffer);
+    }
+    SVTL_destroyContext(ctx);
+}
+
+/*launches each task by running it on the calling thread, counting the launches*/
+static uint32_t countedLaunches = 0;
+
+static errno_t countingLaunch(SVTL_Task task, SVTL_TaskHandle hdl)
+{
+    (void)hdl;
+    ++countedLaunches;
+    task.func(task.args);
+    return 0;
+}
+
+static errno_t countingJoin(SVTL_TaskHandle hdl)
+{
+    (void)hdl;
+    return 0;
+}
+
+/*an indexed triangle list with a restart before about a third of its triangles, so chunks start inside triangles.
+The area and centroid are compared with a reference summed here triangle by triangle, for U16 and U32 indices,
+at one worker, at several on the thread pool, and at several launched through a counting callback to check the list was split*/
+static void testRestartTriangles(void)
+{
+    const uint32_t vertexCount = 1000, triangleCount = 40000;
+    double* positions = malloc(sizeof(double) * 2 * vertexCount);
+    uint32_t* indices = malloc(sizeof(uint32_t) * 4 * triangleCount);
+    uint16_t* indices16 = malloc(sizeof(uint16_t) * 4 * triangleCount);
+    struct SVTL_VertexInfoReadOnly vi;
+    double area = 0.0, absArea = 0.0, cx = 0.0, cy = 0.0;
+    uint32_t indexCount = 0, t, c, i;
+
+    fillPositions(positions, vertexCount);
+    for (t = 0; t < triangleCount; ++t)
+    {
+        const uint32_t a = nextRandom() % vertexCount, b = nextRandom() % vertexCount, c = nextRandom() % vertexCount;
+        const double* pa = positions + 2 * a;
+        const double* pb = positions + 2 * b;
+        const double* pc = positions + 2 * c;
+        const double triArea = 0.5 * (pa[0] * (pb[1] - pc[1]) + pb[0] * (pc[1] - pa[1]) + pc[0] * (pa[1] - pb[1]));
+        if (nextRandom() % 3 == 0)
+            indices[indexCount++] = 0xFFFFFFFFu;
+        indices[indexCount++] = a;
+        indices[indexCount++] = b;
+        indices[indexCount++] = c;
+        area += triArea;
+        absArea += fabs(triArea);
+        cx += fabs(triArea) * (pa[0] + pb[0] + pc[0]) / 3.0;
+        cy += fabs(triArea) * (pa[1] + pb[1] + pc[1]) / 3.0;
+    }
+    for (i = 0; i < indexCount; ++i)
+        indices16[i] = (uint16_t)indices[i];
+
+    memset(&vi, 0, sizeof(vi));
+    vi.count = indexCount;
+    vi.stride = 16;
+    vi.vertices = positions;
+    vi.positionType = SVTL_POS_TYPE_VEC2_F64;
+    vi.topologyType = SVTL_TOPOLOGY_TYPE_TRIANGLE_LIST;
+    vi.primitiveRestartEnabled = true;
+
+    for (c = 0; c < 6; ++c)
+    {
+        SVTL_Context ctx;
+        errno_t err = 0;
+        if (SVTL_createContext(&ctx)) {
+            CHECK(0, "create context");
+            break;
+        }
+        vi.indices = c % 2 ? (const void*)indices16 : (const void*)indices;
+        vi.indexType = c % 2 ? SVTL_INDEX_TYPE_U16 : SVTL_INDEX_TYPE_U32;
+        SVTL_setWorkerCountCtx(ctx, c < 2 ? 1 : 8);
+        SVTL_setParallelThresholdCtx(ctx, 0);
+        if (c >= 4) {
+            SVTL_setTaskJoinCallbackCtx(ctx, countingJoin);
+            SVTL_setTaskLaunchCallbackCtx(ctx, countingLaunch);
+        }
+        countedLaunches = 0;
+
+        CHECK(withinTolerance(SVTL_findSignedAreaCtx(ctx, &vi, &err), area) && !err, "restart area");
+        const struct SVTL_F64Vec2 centroid = SVTL_findCentroid2DCtx(ctx, &vi, &err);
+        CHECK(withinTolerance(centroid.x, cx / absArea) && withinTolerance(centroid.y, cy / absArea) && !err, "restart centroid");
+        /*a task is launched per chunk queue, so more than one launch per operation means the list was split into chunks*/
+        if (c >= 4)
+            CHECK(countedLaunches > 2, "restart list split across tasks");
+        SVTL_destroyContext(ctx);
+    }
+    free(positions);
+    free(indices);
+    free(indices16);
+}
+
+/*narrows v to a compact type by the documented rule: round to nearest even, after clamping I16_NORM to [-1, 1] and I32_FIXED to 32 bits.
+Halves are returned as their bits, finite values only*/
+static int64_t referenceNarrow(enum SVTL_PositionType type, double v)
+{
+    if (type == SVTL_POS_TYPE_VEC2_I16_NORM)
+        return (int64_t)nearbyint((v < -1.0 ? -1.0 : v > 1.0 ? 1.0 : v) * 32767.0);
+    if (type == SVTL_POS_TYPE_VEC2_I32_FIXED) {
+        v *= 65536.0;
+        return (int64_t)nearbyint(v < -2147483648.0 ? -2147483648.0 : v > 2147483647.0 ? 2147483647.0 : v);
+    }
+    {
+        const uint16_t sign = v < 0.0 ? 0x8000u : 0u;
+        const double a = fabs(v);
+        int e;
+        if (a >= 65520.0)
+            return sign | 0x7C00u;
+        if (a < ldexp(1.0, -14))
+            return sign | (uint16_t)nearbyint(ldexp(a, 24)); /*subnormal, rounding up into the smallest normal*/
+        frexp(a, &e);
+        /*the mantissa with its leading bit, carrying into the exponent when it rounds up to 2048*/
+        return sign | (uint16_t)((uint32_t)(e + 14) * 1024u + (uint32_t)nearbyint(ldexp(a, 11 - e)) - 1024u);
+    }
+}
+
+/*widens raw as the library does, I16_NORM in F32*/
+static double referenceWiden(enum SVTL_PositionType type, int64_t raw)
+{
+    if (type == SVTL_POS_TYPE_VEC2_I16_NORM)
+        return (float)raw / 32767.0f < -1.0f ? -1.0 : (double)((float)raw / 32767.0f);
+    if (type == SVTL_POS_TYPE_VEC2_I32_FIXED)
+        return raw / 65536.0;
+    {
+        const uint32_t exponent = (raw >> 10) & 0x1Fu, mantissa = raw & 0x3FFu;
+        const double magnitude = exponent ? ldexp(1024.0 + mantissa, (int)exponent - 25) : ldexp(mantissa, -24);
+        return raw & 0x8000 ? -magnitude : magnitude;
+    }
+}
+
+static int64_t loadCompact(enum SVTL_PositionType type, const unsigned char* p)
+{
+    uint16_t h;
+    int16_t i16;
+    int32_t i32;
+    if (type == SVTL_POS_TYPE_VEC2_F16) {
+        memcpy(&h, p, sizeof(h));
+        return h;
+    }
+    if (type == SVTL_POS_TYPE_VEC2_I16_NORM) {
+        memcpy(&i16, p, sizeof(i16));
+        return i16;
+    }
+    memcpy(&i32, p, sizeof(i32));
+    return i32;
+}
+
+static void storeCompact(enum SVTL_PositionType type, unsigned char* p, int64_t raw)
+{
+    const uint16_t h = (uint16_t)raw;
+    const int16_t i16 = (int16_t)raw;
+    const int32_t i32 = (int32_t)raw;
+    if (type == SVTL_POS_TYPE_VEC2_F16)
+        memcpy(p, &h, sizeof(h));
+    else if (type == SVTL_POS_TYPE_VEC2_I16_NORM)
+        memcpy(p, &i16, sizeof(i16));
+    else
+        memcpy(p, &i32, sizeof(i32));
+}
+
+/*transforms compact positions, some of which clamp, and compares them with the double reference narrowed here.
+F16 and I16_NORM are transformed in F32, so a result may land a step off next to a rounding boundary, or by the F32 error where terms cancel.
+A transform dropped, or rounding biased away from zero, would put far more than a few components off*/
+static void checkCompactTransform(enum SVTL_PositionType type)
+{
+    const uint32_t n = 30001, stride = type == SVTL_POS_TYPE_VEC2_I32_FIXED ? 8 : 4, half = stride / 2;
+    const double range = type == SVTL_POS_TYPE_VEC2_I16_NORM ? 1.0 : type == SVTL_POS_TYPE_VEC2_F16 ? 500.0 : 30000.0;
+    const struct SVTL_F64Vec2 origin = { 0.0, 0.0 }, scaleFactor = { 1.3, -0.7 }, displacement = { 0.01 * range, -0.02 * range };
+    const struct SVTL_F64Mat2x3 m = SVTL_mat2x3Multiply(SVTL_mat2x3Translate(displacement),
+        SVTL_mat2x3Multiply(SVTL_mat2x3Rotate(0.6, origin), SVTL_mat2x3Scale(scaleFactor, origin)));
+    unsigned char* positions = malloc((size_t)stride * n);
+    int64_t* expected = malloc(sizeof(int64_t) * 2 * n);
+    struct SVTL_VertexInfo vi;
+    /*the F32 error of the sums of a few terms of the range's magnitude*/
+    const double f32Error = type == SVTL_POS_TYPE_VEC2_I32_FIXED ? 0.0 : range * 1e-6;
+    uint32_t i, offCount = 0;
+    int within = 1;
+
+    for (i = 0; i < n; ++i) {
+        const double x = referenceWiden(type, referenceNarrow(type, (randomUnit() * 2.0 - 1.0) * range));
+        const double y = referenceWiden(type, referenceNarrow(type, (randomUnit() * 2.0 - 1.0) * range));
+        storeCompact(type, positions + (size_t)stride * i, referenceNarrow(type, x));
+        storeCompact(type, positions + (size_t)stride * i + half, referenceNarrow(type, y));
+        expected[2 * i] = referenceNarrow(type, m.m[0][0] * x + m.m[0][1] * y + m.m[0][2]);
+        expected[2 * i + 1] = referenceNarrow(type, m.m[1][0] * x + m.m[1][1] * y + m.m[1][2]);
+    }
+    memset(&vi, 0, sizeof(vi));
+    vi.count = n;
+    vi.stride = stride;
+    vi.vertices = positions;
+    vi.positionType = type;
+    CHECK(!SVTL_applyAffine2D(&vi, m), "compact transform");
+
+    for (i = 0; i < 2 * n; ++i) {
+        const int64_t raw = loadCompact(type, positions + (size_t)half * i);
+        const double step = fabs(referenceWiden(type, expected[i] + 1) - referenceWiden(type, expected[i]));
+        within &= fabs(referenceWiden(type, raw) - referenceWiden(type, expected[i])) <= step + f32Error;
+        offCount += raw != expected[i];
+    }
+    CHECK(within && offCount <= 2 * n / 1000, "compact transform matches narrowed reference");
+    free(positions);
+    free(expected);
+}
+
+/*the area and centroid of a compact point list match the shoelace sums of its decoded positions, computed here in double*/
+static void checkCompactShoelace(enum SVTL_PositionType type)
+{
+    const uint32_t n = 20011, stride = type == SVTL_POS_TYPE_VEC2_I32_FIXED ? 8 : 4, half = stride / 2;
+    const double scale = type == SVTL_POS_TYPE_VEC2_I16_NORM ? 0.2 : 1.0;
+    double* star = malloc(sizeof(double) * 2 * n);
+    unsigned char* positions = malloc((size_t)stride * n);
+    struct SVTL_VertexInfoReadOnly vi;
+    double cross = 0.0, cx = 0.0, cy = 0.0, area;
+    struct SVTL_F64Vec2 centroid;
+    errno_t err = 0;
+    uint32_t i;
+
+    makeStar(star, n);
+    for (i = 0; i < 2 * n; ++i) {
+        storeCompact(type, positions + (size_t)half * i, referenceNarrow(type, star[i] * scale));
+        star[i] = referenceWiden(type, referenceNarrow(type, star[i] * scale));
+    }
+    for (i = 0; i < n; ++i) {
+        const double* a = star + 2 * i;
+        const double* b = star + 2 * ((i + 1) % n);
+        const double c = a[0] * b[1] - b[0] * a[1];
+        cross += c;
+        cx += (a[0] + b[0]) * c;
+        cy += (a[1] + b[1]) * c;
+    }
+    memset(&vi, 0, sizeof(vi));
+    vi.count = n;
+    vi.stride = stride;
+    vi.vertices = positions;
+    vi.positionType = type;
+    vi.topologyType = SVTL_TOPOLOGY_TYPE_POINT_LIST;
+
+    area = SVTL_findSignedArea(&vi, &err);
+    CHECK(!err && withinTolerance(area, 0.5 * cross), "compact area");
+    centroid = SVTL_findCentroid2D(&vi, &err);
+    CHECK(!err && withinTolerance(centroid.x, cx / (3.0 * cross)) && withinTolerance(centroid.y, cy / (3.0 * cross)), "compact centroid");
+    free(star);
+    free(positions);
+}
+
+/*compact positions come back unchanged from an identity transform in place, and from a round trip through F64.
+They also transform, and reduce, as their decoded positions do*/
+static void testCompactTypes(void)
+{
+    static const enum SVTL_PositionType types[] = { SVTL_POS_TYPE_VEC2_F16, SVTL_POS_TYPE_VEC2_I16_NORM, SVTL_POS_TYPE_VEC2_I32_FIXED };
+    static const uint32_t counts[] = { 1, 7, 257, 30001 };
+    const struct SVTL_F64Mat2x3 identity = SVTL_mat2x3Identity();
+    uint32_t t, c;
+
+    for (t = 0; t < sizeof(types) / sizeof(types[0]); ++t)
+    for (c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+    {
+        const uint32_t n = counts[c], stride = types[t] == SVTL_POS_TYPE_VEC2_I32_FIXED ? 8 : 4;
+        unsigned char* original = malloc((size_t)stride * n);
+        unsigned char* positions = malloc((size_t)stride * n);
+        double* wide = malloc(sizeof(double) * 2 * n);
+        struct SVTL_VertexInfo vi, wideInfo;
+        size_t i;
+
+        for (i = 0; i < (size_t)stride * n; i += stride / 2) {
+            do {
+                uint32_t r = nextRandom();
+                memcpy(original + i, &r, stride / 2);
+            } while (!isCanonical(types[t], original + i));
+        }
+
+        memset(&vi, 0, sizeof(vi));
+        vi.count = n;
+        vi.stride = stride;
+        vi.vertices = positions;
+        vi.positionType = types[t];
+        memset(&wideInfo, 0, sizeof(wideInfo));
+        wideInfo.count = n;
+        wideInfo.stride = 16;
+        wideInfo.vertices = wide;
+        wideInfo.positionType = SVTL_POS_TYPE_VEC2_F64;
+
+        memcpy(positions, original, (size_t)stride * n);
+        CHECK(!SVTL_applyAffine2D(&vi, identity), "compact in place");
+        CHECK(!memcmp(positions, original, (size_t)stride * n), "compact in place round trip");
+
+        CHECK(!SVTL_applyAffine2DTo((const struct SVTL_VertexInfoReadOnly*)&vi, &wideInfo, identity, false), "compact to F64");
+        memset(positions, 0, (size_t)stride * n);
+        CHECK(!SVTL_applyAffine2DTo((const struct SVTL_VertexInfoReadOnly*)&wideInfo, &vi, identity, false), "F64 to compact");
+        CHECK(!memcmp(positions, original, (size_t)stride * n), "compact F64 round trip");
+
+        free(original);
+        free(positions);
+        free(wide);
+    }
+
+    for (t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+        checkCompactTransform(types[t]);
+        checkCompactShoelace(types[t]);
+    }
+}
+
+/*absolute error allowed against the references computed here in double, for results within a few hundred units*/
+#define REFERENCE_TOLERANCE_F64 1e-12
+#define REFERENCE_TOLERANCE_F32 1e-3
+
+/*the positions of a reference test, interleaved with attributes or as x, y and z arrays one after another*/
+struct ReferenceLayout
+{
+    const char* name;
+    enum SVTL_PositionType type;
+    uint32_t stride;
+    uint32_t positionOffset;
+    int soa;
+};
+
+static uint32_t componentSize(enum SVTL_PositionType type)
+{
+    return type == SVTL_POS_TYPE_VEC2_F32 || type == SVTL_POS_TYPE_VEC3_F32 ? 4 : 8;
+}
+
+static size_t layoutBytes(const struct ReferenceLayout* layout, uint32_t count)
+{
+    return layout->soa ? (size_t)3 * componentSize(layout->type) * count : (size_t)layout->stride * count;
+}
+
+static unsigned char* componentAddress(unsigned char* buffer, const struct ReferenceLayout* layout, uint32_t count, uint32_t i, uint32_t c)
+{
+    const uint32_t size = componentSize(layout->type);
+    if (layout->soa)
+        return buffer + (size_t)size * ((size_t)c * count + i);
+    return buffer + (size_t)layout->stride * i + layout->positionOffset + (size_t)size * c;
+}
+
+static double loadComponentAt(const unsigned char* p, enum SVTL_PositionType type)
+{
+    if (componentSize(type) == 4) {
+        float f;
+        memcpy(&f, p, sizeof(f));
+        return f;
+    } else {
+        double d;
+        memcpy(&d, p, sizeof(d));
+        return d;
+    }
+}
+
+static void storeComponentAt(unsigned char* p, enum SVTL_PositionType type, double value)
+{
+    if (componentSize(type) == 4) {
+        const float f = (float)value;
+        memcpy(p, &f, sizeof(f));
+    } else {
+        memcpy(p, &value, sizeof(value));
+    }
+}
+
+/*random bytes around components random coordinates in [-100, 100), with a copy kept in original*/
+static void fillLayout(unsigned char* buffer, unsigned char* original, const struct ReferenceLayout* layout, uint32_t count, uint32_t components)
+{
+    size_t i;
+    uint32_t c;
+    for (i = 0; i < layoutBytes(layout, count); ++i)
+        buffer[i] = (unsigned char)nextRandom();
+    for (i = 0; i < count; ++i)
+        for (c = 0; c < components; ++c)
+            storeComponentAt(componentAddress(buffer, layout, count, (uint32_t)i, c), layout->type, randomUnit() * 200.0 - 100.0);
+    memcpy(original, buffer, layoutBytes(layout, count));
+}
+
+/*the bytes of each interleaved vertex outside its first components coordinates are as they were*/
+static int attributesUnchanged(const unsigned char* buffer, const unsigned char* original, const struct ReferenceLayout* layout, uint32_t count, uint32_t components)
+{
+    const uint32_t end = layout->positionOffset + components * componentSize(layout->type);
+    size_t i;
+    if (layout->soa)
+        return 1;
+    for (i = 0; i < (size_t)layout->stride * count; i += layout->stride)
+        if (memcmp(buffer + i, original + i, layout->positionOffset) || memcmp(buffer + i + end, original + i + end, layout->stride - end))
+            return 0;
+    return 1;
+}
+
+static void describeLayout(unsigned char* buffer, const struct ReferenceLayout* layout, uint32_t count, struct SVTL_VertexInfo* vi, struct SVTL_VertexInfoSoA* soa)
+{
+    memset(vi, 0, sizeof(*vi));
+    vi->count = count;
+    vi->vertices = buffer;
+    vi->stride = layout->stride;
+    vi->positionOffset = layout->positionOffset;
+    vi->positionType = layout->type;
+    memset(soa, 0, sizeof(*soa));
+    soa->count = count;
+    soa->x = componentAddress(buffer, layout, count, 0, 0);
+    soa->y = componentAddress(buffer, layout, count, 0, 1);
+    soa->z = componentAddress(buffer, layout, count, 0, 2);
+    soa->positionType = layout->type;
+}
+
+static errno_t applyAffine3DToLayout(unsigned char* buffer, const struct ReferenceLayout* layout, uint32_t count, struct SVTL_F64Mat4x4 transform)
+{
+    struct SVTL_VertexInfo vi;
+    struct SVTL_VertexInfoSoA soa;
+    describeLayout(buffer, layout, count, &vi, &soa);
+    return layout->soa ? SVTL_applyAffine3DSoA(&soa, transform) : SVTL_applyAffine3D(&vi, transform);
+}
+
+/*3D transforms of every layout against x' = m[0][0]*x + m[0][1]*y + m[0][2]*z + m[0][3] and so on, computed here,
+for a general matrix and a translation, which skips the linear part. Matrices with another bottom row than (0, 0, 0, 1),
+and views without a z, are rejected and leave the positions as they were*/
+static void testAffine3D(void)
+{
+    static const struct ReferenceLayout layouts[] = {
+        { "VEC3 F64 packed", SVTL_POS_TYPE_VEC3_F64, 24, 0, 0 },
+        { "VEC3 F64 interleaved", SVTL_POS_TYPE_VEC3_F64, 40, 8, 0 },
+        { "VEC3 F32 interleaved", SVTL_POS_TYPE_VEC3_F32, 20, 4, 0 },
+        { "VEC3 F64 SoA", SVTL_POS_TYPE_VEC3_F64, 0, 0, 1 },
+        { "VEC3 F32 SoA", SVTL_POS_TYPE_VEC3_F32, 0, 0, 1 }
+    };
+    const uint32_t n = 100003;
+    const struct SVTL_F64Vec3 axis = { 1.0, 2.0, 3.0 }, rotateOrigin = { 1.0, -1.0, 2.0 };
+    const struct SVTL_F64Vec3 factor = { 1.5, 0.5, 2.0 }, scaleOrigin = { 0.0, 1.0, 0.0 }, displacement = { 3.0, -4.0, 5.0 };
+    struct SVTL_F64Mat4x4 transforms[2], nonAffine;
+    unsigned char* buffer = malloc((size_t)40 * n);
+    unsigned char* original = malloc((size_t)40 * n);
+    struct SVTL_VertexInfo vi;
+    struct SVTL_VertexInfoSoA soa;
+    uint32_t l, t, i, c;
+
+    transforms[0] = SVTL_mat4x4Multiply(SVTL_mat4x4Translate(displacement),
+        SVTL_mat4x4Multiply(SVTL_mat4x4Rotate(axis, 0.8, rotateOrigin), SVTL_mat4x4Scale(factor, scaleOrigin)));
+    transforms[1] = SVTL_mat4x4Translate(displacement);
+
+    for (l = 0; l < sizeof(layouts) / sizeof(layouts[0]); ++l)
+    for (t = 0; t < 2; ++t)
+    {
+        const struct ReferenceLayout* layout = &layouts[l];
+        const double tolerance = componentSize(layout->type) == 4 ? REFERENCE_TOLERANCE_F32 : REFERENCE_TOLERANCE_F64;
+        int close = 1;
+
+        fillLayout(buffer, original, layout, n, 3);
+        CHECK(!applyAffine3DToLayout(buffer, layout, n, transforms[t]), layout->name);
+        for (i = 0; i < n; ++i)
+        {
+            const double x = loadComponentAt(componentAddress(original, layout, n, i, 0), layout->type);
+            const double y = loadComponentAt(componentAddress(original, layout, n, i, 1), layout->type);
+            const double z = loadComponentAt(componentAddress(original, layout, n, i, 2), layout->type);
+            for (c = 0; c < 3; ++c) {
+                const double* m = transforms[t].m[c];
+                const double expected = m[0] * x + m[1] * y + m[2] * z + m[3];
+                close &= fabs(loadComponentAt(componentAddress(buffer, layout, n, i, c), layout->type) - expected) <= tolerance;
+            }
+        }
+        CHECK(close, layout->name);
+        CHECK(attributesUnchanged(buffer, original, layout, n, 3), layout->name);
+    }
+
+    fillLayout(buffer, original, &layouts[0], n, 3);
+    nonAffine = transforms[0];
+    nonAffine.m[3][2] = 0.5;
+    CHECK(applyAffine3DToLayout(buffer, &layouts[0], n, nonAffine), "non-affine matrix rejected");
+    nonAffine = transforms[0];
+    nonAffine.m[3][3] = 2.0;
+    CHECK(applyAffine3DToLayout(buffer, &layouts[3], n, nonAffine), "non-affine matrix rejected SoA");
+
+    memset(&vi, 0, sizeof(vi));
+    vi.count = n;
+    vi.vertices = buffer;
+    vi.stride = 24;
+    vi.positionType = SVTL_POS_TYPE_VEC2_F64;
+    CHECK(SVTL_applyAffine3D(&vi, transforms[0]), "VEC2 view rejected");
+    memset(&soa, 0, sizeof(soa));
+    soa.count = n;
+    soa.x = buffer;
+    soa.y = buffer + (size_t)8 * n;
+    soa.z = buffer + (size_t)16 * n;
+    soa.positionType = SVTL_POS_TYPE_VEC2_F64;
+    CHECK(SVTL_applyAffine3DSoA(&soa, transforms[0]), "VEC2 SoA view rejected");
+    CHECK(!memcmp(buffer, original, (size_t)24 * n), "rejected transforms leave the positions");
+
+    free(buffer);
+    free(original);
+}
+
+/*homographies of every layout against x' = (m[0][0]*x + m[0][1]*y + m[0][2]) / w and so on for y', with w = m[2][0]*x + m[2][1]*y + m[2][2],
+computed here. A bottom row of (0, 0, 1) must give the affine transform of the top rows bit for bit, and z must be left as it was*/
+static void testHomography(void)
+{
+    static const struct ReferenceLayout layouts[] = {
+        { "VEC2 F64 packed", SVTL_POS_TYPE_VEC2_F64, 16, 0, 0 },
+        { "VEC2 F32 interleaved", SVTL_POS_TYPE_VEC2_F32, 20, 4, 0 },
+        { "VEC3 F64 packed", SVTL_POS_TYPE_VEC3_F64, 24, 0, 0 },
+        { "VEC2 F64 SoA", SVTL_POS_TYPE_VEC2_F64, 0, 0, 1 },
+        { "VEC2 F32 SoA", SVTL_POS_TYPE_VEC2_F32, 0, 0, 1 }
+    };
+    const uint32_t n = 100003;
+    const struct SVTL_F64Vec2 origin = { 2.0, -1.0 }, factor = { 1.5, 0.75 };
+    const struct SVTL_F64Mat2x3 affine = SVTL_mat2x3Multiply(SVTL_mat2x3Rotate(0.4, origin), SVTL_mat2x3Scale(factor, origin));
+    struct SVTL_F64Mat3x3 transforms[3];
+    unsigned char* buffer = malloc((size_t)24 * n);
+    unsigned char* original = malloc((size_t)24 * n);
+    unsigned char* affineResult = malloc((size_t)24 * n);
+    uint32_t l, t, i;
+
+    transforms[0] = SVTL_mat3x3FromAffine(affine);
+    transforms[0].m[2][0] = 0.001;
+    transforms[0].m[2][1] = -0.002;
+    transforms[0].m[2][2] = 1.5;
+    transforms[1] = SVTL_mat3x3FromAffine(affine);
+    transforms[1].m[2][2] = 2.0;
+    transforms[2] = SVTL_mat3x3FromAffine(affine);
+
+    for (l = 0; l < sizeof(layouts) / sizeof(layouts[0]); ++l)
+    for (t = 0; t < 3; ++t)
+    {
+        const struct ReferenceLayout* layout = &layouts[l];
+        const double tolerance = componentSize(layout->type) == 4 ? REFERENCE_TOLERANCE_F32 : REFERENCE_TOLERANCE_F64;
+        const struct SVTL_F64Mat3x3* m = &transforms[t];
+        struct SVTL_VertexInfo vi;
+        struct SVTL_VertexInfoSoA soa;
+        int close = 1;
+
+        fillLayout(buffer, original, layout, n, 2);
+        describeLayout(buffer, layout, n, &vi, &soa);
+        CHECK(!(layout->soa ? SVTL_applyHomography2DSoA(&soa, transforms[t]) : SVTL_applyHomography2D(&vi, transforms[t])), layout->name);
+        for (i = 0; i < n; ++i)
+        {
+            const double x = loadComponentAt(componentAddress(original, layout, n, i, 0), layout->type);
+            const double y = loadComponentAt(componentAddress(original, layout, n, i, 1), layout->type);
+            const double w = m->m[2][0] * x + m->m[2][1] * y + m->m[2][2];
+            close &= fabs(loadComponentAt(componentAddress(buffer, layout, n, i, 0), layout->type) - (m->m[0][0] * x + m->m[0][1] * y + m->m[0][2]) / w) <= tolerance;
+            close &= fabs(loadComponentAt(componentAddress(buffer, layout, n, i, 1), layout->type) - (m->m[1][0] * x + m->m[1][1] * y + m->m[1][2]) / w) <= tolerance;
+        }
+        CHECK(close, layout->name);
+        CHECK(attributesUnchanged(buffer, original, layout, n, 2), layout->name);
+
+        if (t == 2) {
+            memcpy(affineResult, original, layoutBytes(layout, n));
+            describeLayout(affineResult, layout, n, &vi, &soa);
+            CHECK(!(layout->soa ? SVTL_applyAffine2DSoA(&soa, affine) : SVTL_applyAffine2D(&vi, affine)), layout->name);
+            CHECK(!memcmp(buffer, affineResult, layoutBytes(layout, n)), "affine bottom row matches SVTL_applyAffine2D");
+        }
+    }
+
+    free(buffer);
+    free(original);
+    free(affineResult);
+}
+
+/*parallel indexing gives the bytes of serial indexing, whatever the worker count*/
+static void testDedup(void)
+{
+    static const uint32_t strides[] = { 4, 12, 20, 33, 64, 100 };
+    static const uint32_t counts[] = { 1, 5000, 70001 };
+    SVTL_Context serial, parallel;
+    uint32_t s, c;
+
+    if (SVTL_createContext(&serial) || SVTL_createContext(&parallel)) {
+        CHECK(0, "create contexts");
+        return;
+    }
+    SVTL_setWorkerCountCtx(serial, 1);
+    SVTL_setWorkerCountCtx(parallel, 4);
+    SVTL_setParallelThresholdCtx(parallel, 0);
+
+    for (s = 0; s < sizeof(strides) / sizeof(strides[0]); ++s)
+    for (c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c)
+    {
+        const uint32_t stride = strides[s], count = counts[c];
+        unsigned char* vertices = makeRepeatedVertices(stride, count, 1 + count / 8);
+        unsigned char* serialVertices = calloc(count, stride);
+        unsigned char* parallelVertices = calloc(count, stride);
+        uint32_t* serialIndices = malloc(sizeof(uint32_t) * count);
+        uint32_t* parallelIndices = malloc(sizeof(uint32_t) * count);
+        uint32_t serialVertexCount, parallelVertexCount, serialIndexCount, parallelIndexCount;
+        const struct SVTL_VertexInfoReadOnly vi = bytesInfo(vertices, stride, count);
+
+        CHECK(!SVTL_unindexedToIndexed2DCtx(serial, &vi, serialVertices, &serialVertexCount, serialIndices, &serialIndexCount), "serial dedup");
+        CHECK(!SVTL_unindexedToIndexed2DCtx(parallel, &vi, parallelVertices, &parallelVertexCount, parallelIndices, &parallelIndexCount), "parallel dedup");
+        CHECK(serialVertexCount == parallelVertexCount && serialIndexCount == parallelIndexCount, "dedup counts");
+        CHECK(!memcmp(serialVertices, parallelVertices, (size_t)stride * count), "dedup vertices");
+        CHECK(!memcmp(serialIndices, parallelIndices, sizeof(uint32_t) * count), "dedup indices");
+
+        free(vertices);
+        free(serialVertices);
+        free(parallelVertices);
+        free(serialIndices);
+        free(parallelIndices);
+    }
+    SVTL_destroyContext(serial);
+    SVTL_destroyContext(parallel);
+}
+
+/*positions on both sides of the weld cell edges, which are spaced slightly over one tolerance apart*/
+static void testWeldCellBoundaries(void)
+{
+    static const double tolerances[] = { 0.1, 1.0, 0.003 };
+    static const double offsets[] = { -1.0, -0.5, -1e-9, 0.0, 1e-9, 0.5, 1.0 };
+    const uint32_t offsetCount = sizeof(offsets) / sizeof(offsets[0]);
+    uint32_t t;
+
+    for (t = 0; t < sizeof(tolerances) / sizeof(tolerances[0]); ++t)
+    {
+        const double tolerance = tolerances[t], cellSize = tolerance * 1.000001;
+        const uint32_t n = 4 * offsetCount * offsetCount * 4;
+        double* positions = malloc(sizeof(double) * 2 * n);
+        double* outPositions = malloc(sizeof(double) * 2 * n);
+        uint32_t* kept = malloc(sizeof(uint32_t) * n);
+        uint32_t* expectedIndices = malloc(sizeof(uint32_t) * n);
+        uint32_t* outIndices = malloc(sizeof(uint32_t) * n);
+        uint32_t keptCount = 0, vertexCount, indexCount, i, k;
+        struct SVTL_VertexInfoReadOnly vi = bytesInfo(positions, 16, n);
+
+        for (i = 0; i < n; ++i) {
+            const uint32_t edge = i % 4, ox = (i / 4) % offsetCount, oy = (i / 4 / offsetCount) % offsetCount;
+            positions[2 * i] = (double)(edge + 1) * cellSize + offsets[ox] * tolerance;
+            positions[2 * i + 1] = -(double)edge * cellSize + offsets[oy] * tolerance * (i < n / 2 ? 1.0 : 0.7);
+        }
+
+        /*each vertex merges into the first earlier kept vertex within the tolerance*/
+        for (i = 0; i < n; ++i)
+        {
+            for (k = 0; k < keptCount; ++k) {
+                const double dx = positions[2 * i] - positions[2 * kept[k]], dy = positions[2 * i + 1] - positions[2 * kept[k] + 1];
+                if (dx * dx + dy * dy <= tolerance * tolerance)
+                    break;
+            }
+            if (k == keptCount)
+                kept[keptCount++] = i;
+            expectedIndices[i] = k;
+        }
+
+        vi.positionType = SVTL_POS_TYPE_VEC2_F64;
+        CHECK(!SVTL_weldVertices2D(&vi, tolerance, false, outPositions, &vertexCount, outIndices, &indexCount), "weld");
+        CHECK(vertexCount == keptCount && indexCount == n, "weld counts");
+        CHECK(!memcmp(outIndices, expectedIndices, sizeof(uint32_t) * n), "weld indices");
+        for (k = 0; k < keptCount && k < vertexCount; ++k)
+            CHECK(!memcmp(outPositions + 2 * k, positions + 2 * kept[k], 16), "weld vertices");
+
+        free(positions);
+        free(outPositions);
+        free(kept);
+        free(expectedIndices);
+        free(outIndices);
+    }
+
+    /*a NaN tolerance is rejected rather than merging nothing*/
+    {
+        double positions[4] = { 0.0, 0.0, 1.0, 1.0 }, outPositions[4];
+        uint32_t indices[2], vertexCount, indexCount;
+        struct SVTL_VertexInfoReadOnly vi = bytesInfo(positions, 16, 2);
+        vi.positionType = SVTL_POS_TYPE_VEC2_F64;
+        CHECK(SVTL_weldVertices2D(&vi, sqrt(-1.0), false, outPositions, &vertexCount, indices, &indexCount) == -1, "weld NaN tolerance");
+        CHECK(SVTL_weldVertices2D(&vi, -1.0, false, outPositions, &vertexCount, indices, &indexCount) == -1, "weld negative tolerance");
+    }
+}
+
+/*an indexer reused across meshes of different strides and sizes gives the result of indexing each at once*/
+static void testIndexer(void)
+{
+    static const uint32_t strides[] = { 8, 24, 65 };
+    SVTL_Indexer indexer;
+    uint32_t s, rep;
+
+    if (SVTL_createIndexer(&indexer)) {
+        CHECK(0, "create indexer");
+        return;
+    }
+    for (s = 0; s < sizeof(strides) / sizeof(strides[0]); ++s)
+    for (rep = 0; rep < 3; ++rep)
+    {
+        const uint32_t stride = strides[s], count = 20000 + nextRandom() % 10000;
+        unsigned char* vertices = makeRepeatedVertices(stride, count, 1 + nextRandom() % 4000);
+        unsigned char* expectedVertices = malloc((size_t)stride * count);
+        unsigned char* outVertices = malloc((size_t)stride * count);
+        uint32_t* expectedIndices = malloc(sizeof(uint32_t) * count);
+        uint32_t* outIndices = malloc(sizeof(uint32_t) * count);
+        uint32_t expectedVertexCount, vertexCount, indexCount;
+        const struct SVTL_VertexInfoReadOnly vi = bytesInfo(vertices, stride, count);
+
+        if (rep == 2)
+            CHECK(!SVTL_reserveIndexer(indexer, stride, 40000), "reserve indexer");
+        CHECK(!SVTL_unindexedToIndexed2D(&vi, expectedVertices, &expectedVertexCount, expectedIndices, &indexCount), "one-shot dedup");
+        CHECK(!SVTL_indexerUnindexedToIndexed2D(indexer, &vi, outVertices, &vertexCount, outIndices, &indexCount), "indexer dedup");
+        CHECK(vertexCount == expectedVertexCount && indexCount == count, "indexer counts");
+        CHECK(!memcmp(outVertices, expectedVertices, (size_t)stride * expectedVertexCount), "indexer vertices");
+        CHECK(!memcmp(outIndices, expectedIndices, sizeof(uint32_t) * count), "indexer indices");
+
+        free(vertices);
+        free(expectedVertices);
+        free(outVertices);
+        free(expectedIndices);
+        free(outIndices);
+    }
+    SVTL_destroyIndexer(indexer);
+}
+
+/*a stream of uneven chunks gives the result of indexing the whole mesh at once*/
+static void testStream(void)
+{
+    static const uint32_t strides[] = { 8, 24, 65 };
+    SVTL_Indexer indexer;
+    uint32_t s, rep;
+
+    if (SVTL_createIndexer(&indexer)) {
+        CHECK(0, "create indexer");
+        return;
+    }
+    for (s = 0; s < sizeof(strides) / sizeof(strides[0]); ++s)
+    for (rep = 0; rep < 3; ++rep)
+    {
+        const uint32_t stride = strides[s], count = 20000 + nextRandom() % 10000;
+        unsigned char* vertices = makeRepeatedVertices(stride, count, 1 + nextRandom() % 4000);
+        unsigned char* expectedVertices = malloc((size_t)stride * count);
+        unsigned char* outVertices = malloc((size_t)stride * count);
+        uint32_t* expectedIndices = malloc(sizeof(uint32_t) * count);
+        uint32_t* outIndices = malloc(sizeof(uint32_t) * count);
+        uint32_t expectedVertexCount, vertexCount, indexCount, pushed, streamed;
+        const struct SVTL_VertexInfoReadOnly vi = bytesInfo(vertices, stride, count);
+
+        CHECK(!SVTL_unindexedToIndexed2D(&vi, expectedVertices, &expectedVertexCount, expectedIndices, &indexCount), "one-shot dedup");
+
+        CHECK(!SVTL_indexerBegin(indexer, stride, rep == 0 ? 0 : 1000), "stream begin");
+        for (pushed = 0, streamed = 0; pushed < count;)
+        {
+            uint32_t chunkCount = nextRandom() % 3000, newCount = 0;
+            struct SVTL_VertexInfoReadOnly chunk;
+            if (chunkCount > count - pushed)
+                chunkCount = count - pushed;
+            chunk = bytesInfo(vertices + (size_t)stride * pushed, stride, chunkCount);
+            if (SVTL_indexerPush(indexer, &chunk, outVertices + (size_t)stride * streamed, &newCount, outIndices + pushed)) {
+                CHECK(0, "stream push");
+                break;
+            }
+            pushed += chunkCount;
+            streamed += newCount;
+        }
+        CHECK(!SVTL_indexerEnd(indexer, &vertexCount, &indexCount), "stream end");
+        CHECK(vertexCount == expectedVertexCount && streamed == expectedVertexCount && indexCount == count, "stream counts");
+        CHECK(!memcmp(outVertices, expectedVertices, (size_t)stride * expectedVertexCount), "stream vertices");
+        CHECK(!memcmp(outIndices, expectedIndices, sizeof(uint32_t) * count), "stream indices");
+
+        free(vertices);
+        free(expectedVertices);
+        free(outVertices);
+        free(expectedIndices);
+        free(outIndices);
+    }
+    SVTL_destroyIndexer(indexer);
+}
+
+static const struct
+{
+    const char* name;
+    void (*run)(void);
+} tests[] = {
+    { "command", testCommandBuffer },
+    { "fence", testFences },
+    { "batchcallbacks", testBatchCallbacks },
+    { "transformto", testTransformTo },
+    { "batch", testBatch },
+    { "simd", testSimd },
+    { "steal", testWorkStealing },
+    { "restart", testRestartTriangles },
+    { "compact", testCompactTypes },
+    { "affine3d", testAffine3D },
+    { "homography", testHomography },
+    { "dedup", testDedup },
+    { "weld", testWeldCellBoundaries },
+    { "indexer", testIndexer },
+    { "stream", testStream },
+};
+
+int main(int argc, char** argv)
+{
+    const char* name = argc > 1 ? argv[1] : "";
+    size_t i;
+
+    for (i = 0; i < sizeof(tests) / sizeof(tests[0]) && strcmp(tests[i].name, name); ++i)
+        ;
+    if (i == sizeof(tests) / sizeof(tests[0])) {
+        printf("unknown test \"%s\"\n", name);
+        return 1;
+    }
+    if (SVTL_register()) {
+        printf("failed: SVTL_register\n");
+        return 1;
+    }
+    tests[i].run();
+    SVTL_unregister();
+    return failures ? 1 : 0;
+}